@@ -42,60 +42,237 @@
 #define MCU_FLASH_MIN             64                     /**< Micro-controller minimum recommended flash size (kB) */
 #define MCU_RAM_MIN               8                      /**< Micro-controller minimum recommended RAM size (KB)*/
 #define DRIVER_VERSION            1002                   /**< driver version */
+#define EPOCH64_DAY_OFFSET        3181457L               /**< days added to keep a 64-bit epoch positive (offset * 86400 < 2^38) */
 
 /**
-* @brief i2c rtc write byte
+* @brief This function returns the register bits changed by the chip itself
+* @param[in] u8Reg is the register address
+* @return volatile bits mask
+* @note   RTCWKDAY: OSCRUN, PWRFAIL and the running week day, ALMxWKDAY: ALMxIF
+*/
+uint8_t a_mcp794xx_shadow_volatile_bits(uint8_t u8Reg)
+{
+    if(u8Reg == MCP794XX_RTC_WKDAY_REG)
+        return (MCP794XX_OSC_RUN_STATUS_MASK | MCP794XX_PWR_FAIL_STATUS_MASK | MCP794XX_WKDAY_BCD_MASK);
+    if((u8Reg == MCP794XX_ALM0_WKDAY_REG) || (u8Reg == MCP794XX_ALM1_WKDAY_REG))
+        return MCP794XX_ALARMx_IF_MASK;
+
+    return 0;
+}
+
+/**
+* @brief This function returns the register bits whose written value has no effect
+* @param[in] u8Reg is the register address
+* @return ignored bits mask
+* @note   OSCRUN is read only and any write to ALMxWKDAY clears ALMxIF
+*/
+uint8_t a_mcp794xx_shadow_ignored_bits(uint8_t u8Reg)
+{
+    if(u8Reg == MCP794XX_RTC_WKDAY_REG)
+        return MCP794XX_OSC_RUN_STATUS_MASK;
+    if((u8Reg == MCP794XX_ALM0_WKDAY_REG) || (u8Reg == MCP794XX_ALM1_WKDAY_REG))
+        return MCP794XX_ALARMx_IF_MASK;
+
+    return 0;
+}
+
+/**
+* @brief This function updates the shadow after a successful rtc transfer
 * @param[in] *pHandle points to mcp794xx handle structure
-* @param[in] u8Reg is the slave device register address
+* @param[in] u8Reg is the first register address of the transfer
+* @param[in] *pBuf point to the transferred data
+* @param[in] u8Length is the transfer length (number of byte)
+* @param[in] u8Write is 1 for a write transfer, 0 for a read transfer
+* @return none
+* @note   A read only refreshes the volatile bits of a register still waiting to be written.
+*/
+void a_mcp794xx_shadow_store(mcp794xx_handle_t *const pHandle, uint8_t u8Reg, uint8_t *pBuf, uint8_t u8Length, uint8_t u8Write)
+{
+    uint8_t index;
+    uint8_t u8Value;
+    uint8_t u8Volatile;
+    uint32_t u32Bit;
+
+    if(pHandle->shadow.enable != 1)
+        return;
+
+    for(index = 0; (index < u8Length) && ((u8Reg + index) < MCP794XX_SHADOW_SIZE); index++)
+    {
+        u32Bit = 1UL << (u8Reg + index);
+        if((MCP794XX_SHADOW_CACHED_REGS & u32Bit) == 0)
+            continue;
+
+        u8Value = pBuf[index];
+        if(u8Write == 1)
+        {
+            u8Value &= ~(a_mcp794xx_shadow_ignored_bits(u8Reg + index) & MCP794XX_ALARMx_IF_MASK);  /**< write clears ALMxIF */
+            pHandle->shadow.dirty &= ~u32Bit;
+        }
+        else if(pHandle->shadow.dirty & u32Bit)
+        {
+            u8Volatile = a_mcp794xx_shadow_volatile_bits(u8Reg + index);
+            u8Value = (pHandle->shadow.reg[u8Reg + index] & ~u8Volatile) | (u8Value & u8Volatile);
+        }
+        pHandle->shadow.reg[u8Reg + index] = u8Value;
+        pHandle->shadow.valid |= u32Bit;
+    }
+}
+
+/**
+* @brief i2c rtc burst write
+* @param[in] *pHandle points to mcp794xx handle structure
+* @param[in] u8Reg is the first slave device register address
 * @param[in] *pBuf point to data to write
+* @param[in] u8Length is the data length to write (number of byte)
 * @return status code
             - 0 success
             - 1 failed to write
-* @note none
+* @note The register address auto-increments on the chip, so u8Length consecutive
+*       registers starting at u8Reg are written in a single bus transaction.
 */
-uint8_t rtc_mcp794xx_i2c_write(mcp794xx_handle_t *const pHandle, uint8_t u8Reg, uint8_t *pBuf)
+uint8_t rtc_mcp794xx_i2c_write(mcp794xx_handle_t *const pHandle, uint8_t u8Reg, uint8_t *pBuf, uint8_t u8Length)
 {
 	int index;
-	uint8_t tempBuffer[2];    //len +1
+	uint8_t tempBuffer[u8Length + 1];    //len +1
 	tempBuffer[0] = u8Reg;
 
-	for(index = 1; index < 2; index++){
+	for(index = 1; index < (u8Length + 1); index++){
 		tempBuffer[index] = pBuf[index - 1];
 	}
 
-    if (pHandle->i2c_write(pHandle->rtc_address, (uint8_t *)tempBuffer, 2) != 0) /**< read data   (size is len +1) */
+    if (pHandle->i2c_write(pHandle->rtc_address, (uint8_t *)tempBuffer, (u8Length + 1)) != 0) /**< write data   (size is len +1) */
     {
-        return 1; /**< read fail */
+        return 1; /**< write fail */
     }
+    a_mcp794xx_shadow_store(pHandle, u8Reg, pBuf, u8Length, 1);   /**< keep the shadow coherent */
     return 0;                                            /**< return success */
 
 }
 
 /**
-* @brief i2c rtc read byte
+* @brief i2c register pointer write then read
 * @param[in] *pHandle points to mcp794xx handle structure
+* @param[in] u8Addr is the i2c slave address (rtc or eeprom)
 * @param[in] u8Reg is the slave device register address
 * @param[out] *pBuf point to data to read
 * @param[in] u8Length is the data length to read (number of byte)
 * @return status code
 *          - 0 success
 *          - 1 failed to read
-* @note none
+* @note The pointer write and the read are joined by a repeated start when i2c_write_read is
+*       linked, otherwise a write transfer followed by a read transfer is used.
 */
-uint8_t rtc_mcp794xx_i2c_read(mcp794xx_handle_t  *const pHandle, uint16_t u8Reg, uint8_t *pBuf, uint8_t u8Length)
+uint8_t a_mcp794xx_i2c_write_read(mcp794xx_handle_t *const pHandle, uint8_t u8Addr, uint8_t u8Reg, uint8_t *pBuf, uint8_t u8Length)
 {
+	if (pHandle->i2c_write_read != NULL)
+	{
+		if (pHandle->i2c_write_read(u8Addr, &u8Reg, 1, pBuf, u8Length) != 0) /**< write register pointer then read data */
+		{
+			return 1; /**< read fail */
+		}
+		return 0;     /**< return success */
+	}
 
-	if (pHandle->i2c_write(pHandle->rtc_address, (uint8_t *)&u8Reg, 1) != 0) /**< read data */
+	if (pHandle->i2c_write(u8Addr, &u8Reg, 1) != 0) /**< write register pointer */
 	{
 		return 1; /**< read fail */
 	}
-    if (pHandle->i2c_read(pHandle->rtc_address, (uint8_t *)pBuf, u8Length) != 0) /**< read data */
+    if (pHandle->i2c_read(u8Addr, pBuf, u8Length) != 0) /**< read data */
     {
         return 1; /**< read fail */
     }
     return 0;                                           /**< return success */
 }
 
+/**
+* @brief i2c rtc read byte
+* @param[in] *pHandle points to mcp794xx handle structure
+* @param[in] u8Reg is the slave device register address
+* @param[out] *pBuf point to data to read
+* @param[in] u8Length is the data length to read (number of byte)
+* @return status code
+*          - 0 success
+*          - 1 failed to read
+* @note none
+*/
+uint8_t rtc_mcp794xx_i2c_read(mcp794xx_handle_t  *const pHandle, uint8_t u8Reg, uint8_t *pBuf, uint8_t u8Length)
+{
+    if (a_mcp794xx_i2c_write_read(pHandle, pHandle->rtc_address, u8Reg, pBuf, u8Length) != 0)
+    {
+        return 1; /**< read fail */
+    }
+    a_mcp794xx_shadow_store(pHandle, u8Reg, pBuf, u8Length, 0);   /**< keep the shadow coherent */
+    return 0;     /**< return success */
+}
+
+/**
+ * @brief This function keeps the eeprom mirror coherent after a write
+ * @param[in] pHandle points to mcp794xx handle structure
+ * @param[in] u8Reg is the eeprom address written
+ * @param[in] pBuf point to the data written
+ * @param[in] u8Length is the data length
+ * @return none
+ * @note   The address wraps inside the page like on the chip. Pages not yet loaded stay invalid.
+ */
+void a_mcp794xx_eeprom_mirror_store(mcp794xx_handle_t *const pHandle, uint8_t u8Reg, uint8_t *pBuf, uint8_t u8Length)
+{
+    uint8_t u8Page_base = u8Reg & ~(EEPROM_PAGE_SIZE - 1);
+    uint8_t index;
+
+    if((pHandle->eeprom_mirror.enable != 1) || (u8Reg > EEPROM_HIGHEST_ADDRESS))
+        return;
+
+    for(index = 0; index < u8Length; index++)
+    {
+        pHandle->eeprom_mirror.data[u8Reg] = pBuf[index];
+        u8Reg = u8Page_base | ((u8Reg + 1) & (EEPROM_PAGE_SIZE - 1));
+    }
+}
+
+/**
+ * @brief This function loads the mirror pages of an address range
+ * @param[in] pHandle points to mcp794xx handle structure
+ * @param[in] u8Reg is the first eeprom address
+ * @param[in] u8Length is the range length
+ * @return status code
+ *          - 0 success
+ *          - 1 failed to read
+ * @note   Consecutive missing pages are read with one transfer.
+ */
+uint8_t a_mcp794xx_eeprom_mirror_fill(mcp794xx_handle_t *const pHandle, uint8_t u8Reg, uint8_t u8Length)
+{
+    uint8_t u8Page = u8Reg / EEPROM_PAGE_SIZE;
+    uint8_t u8Last = (u8Reg + u8Length - 1) / EEPROM_PAGE_SIZE;
+    uint8_t u8Run;
+
+    while(u8Page <= u8Last)
+    {
+        if(pHandle->eeprom_mirror.valid & (1U << u8Page))
+        {
+            u8Page++;
+            continue;
+        }
+        u8Run = u8Page;
+        while((u8Run < u8Last) && !(pHandle->eeprom_mirror.valid & (1U << (u8Run + 1))))
+        {
+            u8Run++;                                     /**< extend over the following missing pages */
+        }
+
+        if (a_mcp794xx_i2c_write_read(pHandle, pHandle->eeprom_address, u8Page * EEPROM_PAGE_SIZE,
+                                      (uint8_t *)&pHandle->eeprom_mirror.data[u8Page * EEPROM_PAGE_SIZE],
+                                      (u8Run - u8Page + 1) * EEPROM_PAGE_SIZE) != 0)
+        {
+            return 1; /**< read fail */
+        }
+        for(; u8Page <= u8Run; u8Page++)
+        {
+            pHandle->eeprom_mirror.valid |= (1U << u8Page);
+        }
+    }
+
+    return 0;
+}
+
 /**
 * @brief i2c eeprom write byte
 * @param[in] *pHandle points to mcp794xx handle structure
@@ -121,6 +298,7 @@ uint8_t eeprom_mcp794xx_i2c_write(mcp794xx_handle_t *const pHandle, uint8_t u8Re
     {
         return MCP794XX_DRV_FAILED; /**< read fail */
     }
+    a_mcp794xx_eeprom_mirror_store(pHandle, u8Reg, pBuf, u8Length);   /**< keep the mirror coherent */
     return MCP794XX_DRV_OK;                                            /**< return success */
 
 }
@@ -134,47 +312,68 @@ uint8_t eeprom_mcp794xx_i2c_write(mcp794xx_handle_t *const pHandle, uint8_t u8Re
 * @return status code
 *          - 0 success
 *          - 1 failed to read
-* @note none
+* @note array reads go through the mirror when it is enabled
 */
-uint8_t eeprom_mcp794xx_i2c_read(mcp794xx_handle_t  *const pHandle, uint16_t u8Reg, uint8_t *pBuf, uint8_t u8Length)
+uint8_t eeprom_mcp794xx_i2c_read(mcp794xx_handle_t  *const pHandle, uint8_t u8Reg, uint8_t *pBuf, uint8_t u8Length)
 {
-	if (pHandle->i2c_write(pHandle->eeprom_address, (uint8_t *)&u8Reg, 1) != MCP794XX_DRV_OK) /**< read data */
-	{
-		return MCP794XX_DRV_FAILED; /**< read fail */
-	}
-    if (pHandle->i2c_read(pHandle->eeprom_address, (uint8_t *)pBuf, u8Length) != MCP794XX_DRV_OK) /**< read data */
+    if ((pHandle->eeprom_mirror.enable == 1) && ((u8Reg + u8Length) <= EEPROM_MEMORY_SIZE) && (u8Length != 0))
+    {
+        if (a_mcp794xx_eeprom_mirror_fill(pHandle, u8Reg, u8Length) != 0)
+        {
+            return MCP794XX_DRV_FAILED; /**< read fail */
+        }
+        memcpy(pBuf, &pHandle->eeprom_mirror.data[u8Reg], u8Length);   /**< served from the mirror */
+        return MCP794XX_DRV_OK;                                           /**< return success */
+    }
+
+    if (a_mcp794xx_i2c_write_read(pHandle, pHandle->eeprom_address, u8Reg, pBuf, u8Length) != 0)
     {
         return MCP794XX_DRV_FAILED; /**< read fail */
     }
     return MCP794XX_DRV_OK;                                           /**< return success */
 }
 
+/**
+* @brief i2c sram burst write of the staging buffer
+* @param[in] *pHandle points to mcp794xx handle structure
+* @param[in] u8Reg is the first sram address
+* @param[in] u8Length is the number of data bytes already in pHandle->sram_staging[1..]
+* @return status code
+            - 0 success
+            - 1 failed to write
+* @note the register pointer auto-increments, the whole range is one transaction
+*/
+uint8_t a_mcp794xx_sram_burst(mcp794xx_handle_t *const pHandle, uint8_t u8Reg, uint8_t u8Length)
+{
+    pHandle->sram_staging[0] = u8Reg;
+
+    if (pHandle->i2c_write(pHandle->rtc_address, (uint8_t *)pHandle->sram_staging, u8Length + 1) != MCP794XX_DRV_OK)
+    {
+        return MCP794XX_DRV_FAILED; /**< write fail */
+    }
+	return MCP794XX_DRV_OK;
+}
+
 /**
 * @brief i2c sram write byte
 * @param[in] *pHandle points to mcp794xx handle structure
 * @param[in] u8Reg is the slave device register address
 * @param[in] *pBuf point to data to write
-* @param[in] u8Length is the data length to write (number of byte)
+* @param[in] u8Length is the data length to write (number of byte, up to SRAM_MEMORY_SIZE)
 * @return status code
             - 0 success
             - 1 failed to write
-* @note none
+* @note the data is staged in the handle buffer and sent as one burst
 */
 uint8_t sram_mcp794xx_i2c_write(mcp794xx_handle_t *const pHandle, uint8_t u8Reg, uint8_t *pBuf, uint8_t u8Length)
 {
-	int index;
-	uint8_t tempBuffer[u8Length + 1];    //len +1
-	tempBuffer[0] = u8Reg;
-
-	for(index = 1; index < u8Length; index++){
-		tempBuffer[index] = pBuf[index - 1];
-	}
-
-    if (pHandle->i2c_write(pHandle->rtc_address, (uint8_t *)tempBuffer, u8Length + 1) != MCP794XX_DRV_OK) /**< read data   (size is len +1) */
+    if (u8Length > SRAM_MEMORY_SIZE)
     {
-        return MCP794XX_DRV_FAILED; /**< read fail */
+        return MCP794XX_DRV_FAILED; /**< larger than the sram */
     }
-	return MCP794XX_DRV_OK;
+
+    memcpy(&pHandle->sram_staging[1], pBuf, u8Length);
+    return a_mcp794xx_sram_burst(pHandle, u8Reg, u8Length);
 }
 
 /**
@@ -213,6 +412,181 @@ uint8_t a_pcf85xxx_bcd2dec(uint8_t u8Bcd)
     return ( (u8Bcd/16*10) + (u8Bcd%16) );
 }
 
+/**
+ * @brief This function writes the selected registers of a register image
+ * @param[in] pHandle points to a mcp794xx handle structure
+ * @param[in] pImage point to the register image, indexed by register address
+ * @param[in] u32Write is the mask of the registers to write
+ * @param[in] u32Bridge is the mask of the registers safe to rewrite with their image value
+ * @return status code
+ *          - 0 success
+ *          - 1 failed
+ * @note   Two runs are joined into one burst when the gap between them is at most
+ *         MCP794XX_BURST_MAX_GAP registers, all in u32Bridge.
+ */
+uint8_t a_mcp794xx_write_reg_runs(mcp794xx_handle_t *const pHandle, uint8_t *pImage, uint32_t u32Write, uint32_t u32Bridge)
+{
+    uint8_t u8Reg = 0;
+    uint8_t u8End;
+    uint8_t u8Next;
+
+    while(u8Reg < MCP794XX_SHADOW_SIZE)
+    {
+        if(((u32Write >> u8Reg) & 1) == 0)
+        {
+            u8Reg++;
+            continue;
+        }
+
+        u8End = u8Reg;
+        for(;;)
+        {
+            u8Next = u8End + 1;
+            while((u8Next < MCP794XX_SHADOW_SIZE) && (((u32Write >> u8Next) & 1) == 0) &&
+                  ((u32Bridge >> u8Next) & 1) && ((u8Next - u8End) <= MCP794XX_BURST_MAX_GAP))
+                u8Next++;
+            if((u8Next >= MCP794XX_SHADOW_SIZE) || (((u32Write >> u8Next) & 1) == 0) || ((u8Next - u8End - 1) > MCP794XX_BURST_MAX_GAP))
+                break;
+            u8End = u8Next;                                                  /**< next written register joins this burst */
+        }
+
+        err = rtc_mcp794xx_i2c_write(pHandle, u8Reg, &pImage[u8Reg], u8End - u8Reg + 1);
+        if(err)
+            return 1;
+        u8Reg = u8End + 1;
+    }
+
+    return 0;      /**< success */
+}
+
+/**
+ * @brief This function writes the pending shadow registers
+ * @param[in] pHandle points to a mcp794xx handle structure
+ * @return status code
+ *          - 0 success
+ *          - 1 failed
+ * @note   Each run of consecutive pending registers is written with one burst.
+ *         A register that fails to write stays pending.
+ */
+uint8_t a_mcp794xx_shadow_flush(mcp794xx_handle_t *const pHandle)
+{
+    err = a_mcp794xx_write_reg_runs(pHandle, pHandle->shadow.reg, pHandle->shadow.dirty, 0);
+    if(err)
+    {
+        a_mcp794xx_print_error_msg(pHandle, "write shadow registers");
+        return 1;
+    }
+
+    return 0;      /**< success */
+}
+
+/**
+ * @brief This function loads the shadow from the chip
+ * @param[in] pHandle points to a mcp794xx handle structure
+ * @return status code
+ *          - 0 success
+ *          - 1 failed
+ * @note   RTCWKDAY..ALM1WKDAY are read with one burst, pending registers keep their value.
+ */
+uint8_t a_mcp794xx_shadow_load(mcp794xx_handle_t *const pHandle)
+{
+    uint8_t temp_buffer[MCP794XX_ALM1_WKDAY_REG - MCP794XX_RTC_WKDAY_REG + 1];
+
+    return rtc_mcp794xx_i2c_read(pHandle, MCP794XX_RTC_WKDAY_REG, (uint8_t *)temp_buffer, sizeof(temp_buffer));
+}
+
+/**
+ * @brief This function reads a register through the shadow
+ * @param[in] pHandle points to a mcp794xx handle structure
+ * @param[in] u8Reg is the register address
+ * @param[in] u8Need_mask is the mask of the bits the caller uses
+ * @param[out] pValue point to the register value
+ * @return status code
+ *          - 0 success
+ *          - 1 failed
+ * @note   The bus is skipped when the register is shadowed and none of the needed bits is volatile.
+ */
+uint8_t a_mcp794xx_reg_read(mcp794xx_handle_t *const pHandle, uint8_t u8Reg, uint8_t u8Need_mask, uint8_t *pValue)
+{
+    uint32_t u32Bit = (u8Reg < MCP794XX_SHADOW_SIZE) ? (1UL << u8Reg) : 0;
+
+    if((pHandle->shadow.enable == 1) && (MCP794XX_SHADOW_CACHED_REGS & u32Bit))
+    {
+        if((pHandle->shadow.valid & u32Bit) && ((u8Need_mask & a_mcp794xx_shadow_volatile_bits(u8Reg)) == 0))
+        {
+            *pValue = pHandle->shadow.reg[u8Reg];
+            return 0;
+        }
+        if(rtc_mcp794xx_i2c_read(pHandle, u8Reg, pValue, 1) != 0)
+            return 1;
+        *pValue = pHandle->shadow.reg[u8Reg];        /**< includes a pending value */
+        return 0;
+    }
+
+    return rtc_mcp794xx_i2c_read(pHandle, u8Reg, pValue, 1);
+}
+
+/**
+ * @brief This function updates register bits (read-modify-write)
+ * @param[in] pHandle points to a mcp794xx handle structure
+ * @param[in] u8Reg is the register address
+ * @param[in] u8Mask is the mask of the bits to change
+ * @param[in] u8Value is the new value of the masked bits
+ * @return status code
+ *          - 0 success
+ *          - 1 failed
+ * @note   - The read is skipped when every kept bit is known from the shadow or when no bit is kept.
+ *         - During a transaction the write is deferred unless a kept bit is volatile.
+ *         - A failed write restores the previous shadow value and state of the register.
+ */
+uint8_t a_mcp794xx_reg_update(mcp794xx_handle_t *const pHandle, uint8_t u8Reg, uint8_t u8Mask, uint8_t u8Value)
+{
+    uint8_t u8Keep = (uint8_t)~(u8Mask | a_mcp794xx_shadow_ignored_bits(u8Reg));
+    uint8_t u8Reg_value = 0;
+    uint8_t u8Old_value;
+    uint8_t u8Res;
+    uint32_t u32Bit = (u8Reg < MCP794XX_SHADOW_SIZE) ? (1UL << u8Reg) : 0;
+    uint32_t u32Old_valid;
+    uint32_t u32Old_dirty;
+
+    if(u8Keep != 0)
+    {
+        if(a_mcp794xx_reg_read(pHandle, u8Reg, u8Keep, &u8Reg_value) != 0)
+            return 1;
+    }
+    u8Reg_value = (u8Reg_value & ~u8Mask) | (u8Value & u8Mask);
+
+    if((pHandle->shadow.enable == 1) && (MCP794XX_SHADOW_CACHED_REGS & u32Bit))
+    {
+        u8Old_value = pHandle->shadow.reg[u8Reg];
+        u32Old_valid = pHandle->shadow.valid & u32Bit;
+        u32Old_dirty = pHandle->shadow.dirty & u32Bit;
+        pHandle->shadow.reg[u8Reg] = u8Reg_value;
+        pHandle->shadow.valid |= u32Bit;
+        pHandle->shadow.dirty |= u32Bit;
+        if(pHandle->shadow.txn == 1)
+        {
+            if((u8Keep & a_mcp794xx_shadow_volatile_bits(u8Reg)) == 0)
+                return 0;                                                    /**< deferred to the commit */
+            u8Res = rtc_mcp794xx_i2c_write(pHandle, u8Reg, &pHandle->shadow.reg[u8Reg], 1);   /**< kept bits may be stale by then */
+        }
+        else
+        {
+            u8Res = a_mcp794xx_shadow_flush(pHandle);
+        }
+        if(u8Res != 0)
+        {
+            pHandle->shadow.reg[u8Reg] = u8Old_value;                        /**< the chip never got the new value */
+            pHandle->shadow.valid = (pHandle->shadow.valid & ~u32Bit) | u32Old_valid;
+            pHandle->shadow.dirty = (pHandle->shadow.dirty & ~u32Bit) | u32Old_dirty;
+            return 1;
+        }
+        return 0;
+    }
+
+    return rtc_mcp794xx_i2c_write(pHandle, u8Reg, &u8Reg_value, 1);
+}
+
 /**
  * @brief     This function initialize the chip
  * @param[in] pHandle points to mcp794xx pHandle structure
@@ -278,6 +652,21 @@ uint8_t mcp794xx_init(mcp794xx_handle_t *const pHandle)
         return 1;
     }
 
+    memset(&pHandle->shadow, 0, sizeof(pHandle->shadow));   /**< shadow starts disabled and empty */
+    pHandle->century_base = MCP794XX_CENTURY_BASE_DEFAULT;
+    memset(&pHandle->clock, 0, sizeof(pHandle->clock));     /**< interpolated clock starts unanchored */
+    memset(&pHandle->subsec, 0, sizeof(pHandle->subsec));   /**< edge counter starts uncalibrated */
+    pHandle->eeprom_timeout_ms = MCP794XX_EEPROM_WRITE_TIMEOUT_MS;
+    memset(&pHandle->eeprom_mirror, 0, sizeof(pHandle->eeprom_mirror));   /**< mirror starts disabled and empty */
+    pHandle->eeprom_bp_valid = 0;                                           /**< block protect read on the first write */
+    memset(&pHandle->sram_log, 0, sizeof(pHandle->sram_log));               /**< sram log must be mounted or formatted */
+    memset(&pHandle->journal, 0, sizeof(pHandle->journal));                 /**< journal must be mounted */
+    pHandle->kv.mounted = 0;                                                /**< key-value store must be mounted */
+    pHandle->sched.started = 0;                                             /**< scheduler must be started */
+    pHandle->periodic.started = 0;                                          /**< periodic timer must be started */
+    memset((void *)&pHandle->events, 0, sizeof(pHandle->events));           /**< event queue starts empty */
+    pHandle->cron.started = 0;                                              /**< cron alarm must be started */
+    memset(pHandle->alarm_owner, MCP794XX_ALARM_OWNER_NONE, sizeof(pHandle->alarm_owner));   /**< both alarms free */
     pHandle->inited = 1; /* flag finish initialization */
 
     return 0;
@@ -349,6 +738,81 @@ uint8_t mcp794xx_irq_pHandler(mcp794xx_handle_t *const pHandle, mcp794xx_alarm_t
     return 0;              /**< success */
 }
 
+/**
+ * @brief      This function services the alarm interrupt without knowing which alarm fired
+ * @param[in]  pHandle points to mcp794xx pHandle structure
+ * @param[out] pServiced point to the alarms serviced (MCP794XX_IRQ_ALARM0_FLAG | MCP794XX_IRQ_ALARM1_FLAG), can be NULL
+ * @return  status code
+ *            - 0 success
+ *            - 1 failed to read or clear the alarm flags
+ *            - 2 pHandle is NULL
+ *            - 3 pHandle is not initialized
+ * @note      ALM0WKDAY to ALM1WKDAY are read in one burst. The flags set are cleared by writing back the week day
+ *            register of the alarm that fired, or the whole range in one burst when both fired, then
+ *            receive_callback is called for each alarm serviced. At most two bus transactions.
+ */
+uint8_t mcp794xx_irq_service(mcp794xx_handle_t *const pHandle, uint8_t *pServiced)
+{
+    uint8_t pBuf[(MCP794XX_ALM1_WKDAY_REG - MCP794XX_ALM0_WKDAY_REG) + 1];
+    uint8_t u8Last = MCP794XX_ALM1_WKDAY_REG - MCP794XX_ALM0_WKDAY_REG;
+    uint8_t u8Fired = 0;
+
+    if(pHandle == NULL)
+        return 2;     /**< return failed error */
+    if(pHandle->inited != 1)
+        return 3;      /**< return failed error */
+
+    if(pServiced != NULL)
+        *pServiced = 0;
+
+    err = rtc_mcp794xx_i2c_read(pHandle, MCP794XX_ALM0_WKDAY_REG, (uint8_t *)pBuf, sizeof(pBuf));
+    if(err)
+    {
+        a_mcp794xx_print_error_msg(pHandle, "irq service, read alarm flags");
+        return 1;
+    }
+    if(pHandle->shadow.enable == 1)
+    {
+        pBuf[0] = pHandle->shadow.reg[MCP794XX_ALM0_WKDAY_REG];         /**< keeps a pending configuration write */
+        pBuf[u8Last] = pHandle->shadow.reg[MCP794XX_ALM1_WKDAY_REG];
+    }
+
+    if(pBuf[0] & MCP794XX_ALARMx_IF_MASK)
+        u8Fired |= MCP794XX_IRQ_ALARM0_FLAG;
+    if(pBuf[u8Last] & MCP794XX_ALARMx_IF_MASK)
+        u8Fired |= MCP794XX_IRQ_ALARM1_FLAG;
+    pBuf[0] &= ~MCP794XX_ALARMx_IF_MASK;
+    pBuf[u8Last] &= ~MCP794XX_ALARMx_IF_MASK;
+
+    if(u8Fired == (MCP794XX_IRQ_ALARM0_FLAG | MCP794XX_IRQ_ALARM1_FLAG))
+    {
+        err = rtc_mcp794xx_i2c_write(pHandle, MCP794XX_ALM0_WKDAY_REG, (uint8_t *)pBuf, sizeof(pBuf));
+    }
+    else if(u8Fired == MCP794XX_IRQ_ALARM0_FLAG)
+    {
+        err = rtc_mcp794xx_i2c_write(pHandle, MCP794XX_ALM0_WKDAY_REG, (uint8_t *)&pBuf[0], 1);
+    }
+    else if(u8Fired == MCP794XX_IRQ_ALARM1_FLAG)
+    {
+        err = rtc_mcp794xx_i2c_write(pHandle, MCP794XX_ALM1_WKDAY_REG, (uint8_t *)&pBuf[u8Last], 1);
+    }
+    if(err)
+    {
+        a_mcp794xx_print_error_msg(pHandle, "irq service, clear alarm flags");
+        return 1;
+    }
+
+    if(u8Fired & MCP794XX_IRQ_ALARM0_FLAG)
+        pHandle->receive_callback(MCP794XX_ALARM0);
+    if(u8Fired & MCP794XX_IRQ_ALARM1_FLAG)
+        pHandle->receive_callback(MCP794XX_ALARM1);
+
+    if(pServiced != NULL)
+        *pServiced = u8Fired;
+
+    return 0;              /**< success */
+}
+
 /**
  * @brief     This function set the address pin
  * @param[in] pHandle points to a mcp794xx pHandle structure
@@ -488,63 +952,51 @@ uint8_t mcp794xx_get_debug_print_buffer_size(mcp794xx_handle_t *const pHandle, m
 }
 
 /**
- * @brief     This function set the time and date
+ * @brief     This function validate a time and date against the current hour format
  * @param[in] pHandle points to a mcp794xx handle structure
  * @param[in] pTime point to the date and time structure object
  * @return    status code
  *            - 0 success
- *            - 1 set time failed
- *            - 2 handle or time is NULL
- *            - 3 handle is not initialized
  *            - 4 time is invalid
  * @note      none
  */
-uint8_t mcp794xx_set_time_and_date(mcp794xx_handle_t *const pHandle, mcp794xx_time_t *pTime)
+uint8_t a_mcp794xx_check_time(mcp794xx_handle_t *const pHandle, mcp794xx_time_t *pTime)
 {
+    if((pTime->year > 99) && ((pTime->year < pHandle->century_base) || (pTime->year > (pHandle->century_base + 99))))
+    {
+        a_mcp794xx_print_error_msg(pHandle, "set time, year must be 0 - 99 or within the century window");
+        return 4;
+    }
 
-    uint8_t ptimeBuffer[MCP794XX_TIME_BUFFER_SIZE];
-    uint8_t status;
-
-    if(pHandle == NULL)
-        return 2;     /**< return failed error */
-    if(pHandle->inited != 1)
-        return 3;      /**< return failed error */
-
-        if((pTime->year < 0) || (pTime->year > 99))
-        {
-            a_mcp794xx_print_error_msg(pHandle, "set time, year can not be less than 0 or greater than 99");
-            return 4;
-        }
-
-        if((pTime->month < 1) || (pTime->month > 12))
-        {
-            a_mcp794xx_print_error_msg(pHandle, "set time, month can not be less than 1 or greater than 12");
-            return 4;
-        }
+    if((pTime->month < 1) || (pTime->month > 12))
+    {
+        a_mcp794xx_print_error_msg(pHandle, "set time, month can not be less than 1 or greater than 12");
+        return 4;
+    }
 
-        if((pTime->date < 1) || (pTime->date > 31))
-        {
-            a_mcp794xx_print_error_msg(pHandle, "set time, date can not be less than 1 or greater than 31");
-            return 4;
-        }
+    if((pTime->date < 1) || (pTime->date > 31))
+    {
+        a_mcp794xx_print_error_msg(pHandle, "set time, date can not be less than 1 or greater than 31");
+        return 4;
+    }
 
-        if((pTime->weekDay < 1) || (pTime->weekDay > 7))
-        {
-            a_mcp794xx_print_error_msg(pHandle, "set time, week day can not be less than 1 or greater than 7");
-            return 4;
-        }
+    if((pTime->weekDay < 1) || (pTime->weekDay > 7))
+    {
+        a_mcp794xx_print_error_msg(pHandle, "set time, week day can not be less than 1 or greater than 7");
+        return 4;
+    }
 
-        if((pTime->minute < 0) || (pTime->minute > 59))
-        {
-            a_mcp794xx_print_error_msg(pHandle, "set time, minute can not be less than 0 or greater than 59");
-            return 4;
-        }
+    if((pTime->minute < 0) || (pTime->minute > 59))
+    {
+        a_mcp794xx_print_error_msg(pHandle, "set time, minute can not be less than 0 or greater than 59");
+        return 4;
+    }
 
-        if((pTime->second < 0) || (pTime->second > 59))
-        {
-            a_mcp794xx_print_error_msg(pHandle, "set time, seconds can not be less than 0 or greater than 59");
-            return 4;
-        }
+    if((pTime->second < 0) || (pTime->second > 59))
+    {
+        a_mcp794xx_print_error_msg(pHandle, "set time, seconds can not be less than 0 or greater than 59");
+        return 4;
+    }
 
 
     if(pHandle->time_param.time_Format == MCP794XX_24HR_FORMAT)
@@ -574,94 +1026,279 @@ uint8_t mcp794xx_set_time_and_date(mcp794xx_handle_t *const pHandle, mcp794xx_ti
         return 4;
     }
 
-    memset(ptimeBuffer, 0, sizeof(ptimeBuffer));
-    err = rtc_mcp794xx_i2c_read(pHandle, MCP794XX_RTC_SECOND_REG, (uint8_t *)ptimeBuffer, MCP794XX_TIME_BUFFER_SIZE);
+    return 0;           /**< success */
+}
+
+/**
+ * @brief         This function pack a time and date into the time keeping register image
+ * @param[in]     pHandle points to a mcp794xx handle structure
+ * @param[in]     pTime point to the date and time structure object
+ * @param[in,out] pTimeBuffer point to the 7 registers read from 0x00, updated in place
+ * @return        none
+ * @note          The ST, 12/24, OSCRUN, PWRFAIL, VBATEN and LPYR bits are kept from pTimeBuffer.
+ */
+void a_mcp794xx_pack_time(mcp794xx_handle_t *const pHandle, mcp794xx_time_t *pTime, uint8_t *pTimeBuffer)
+{
+    pTimeBuffer[0] = (pTimeBuffer[0] & MCP794XX_ST_MASK) | a_pcf85xxx_dec2bcd(pTime->second);                  /**< keep the oscillator start bit */
+    pTimeBuffer[1] = a_pcf85xxx_dec2bcd(pTime->minute);
+    if(pHandle->time_param.time_Format == MCP794XX_24HR_FORMAT)
+    {
+        pTimeBuffer[2] = a_pcf85xxx_dec2bcd(pTime->hour);
+    }
+    else
+    {
+        pTimeBuffer[2] = a_pcf85xxx_dec2bcd(pTime->hour) | (pTimeBuffer[2] & MCP794XX_12HR_24HR_FRMT_STAT_MASK) |
+                         ((pTime->am_pm_indicator << 5) & MCP794XX_TIME_AM_PM_MASK);
+    }
+    pTimeBuffer[3] = a_pcf85xxx_dec2bcd(pTime->weekDay) | (pTimeBuffer[3] & (MCP794XX_OSC_RUN_STATUS_MASK | MCP794XX_PWR_FAIL_STATUS_MASK | MCP794XX_VBAT_EN_MASK));
+    pTimeBuffer[4] = a_pcf85xxx_dec2bcd(pTime->date);
+    pTimeBuffer[5] = a_pcf85xxx_dec2bcd(pTime->month) | (pTimeBuffer[5] & MCP794XX_LEAP_YEAR_STATUS_MASK);
+    pTimeBuffer[6] = a_pcf85xxx_dec2bcd(pTime->year % 100);
+}
+
+/**
+ * @brief     This function set the time and date
+ * @param[in] pHandle points to a mcp794xx handle structure
+ * @param[in] pTime point to the date and time structure object
+ * @return    status code
+ *            - 0 success
+ *            - 1 set time failed
+ *            - 2 handle or time is NULL
+ *            - 3 handle is not initialized
+ *            - 4 time is invalid
+ * @note      The time keeping registers are read once and written back with one burst.
+ */
+uint8_t mcp794xx_set_time_and_date(mcp794xx_handle_t *const pHandle, mcp794xx_time_t *pTime)
+{
+
+    uint8_t ptimeBuffer[MCP794XX_TIME_BUFFER_SIZE];
+
+    if(pHandle == NULL)
+        return 2;     /**< return failed error */
+    if(pHandle->inited != 1)
+        return 3;      /**< return failed error */
+
+    err = a_mcp794xx_check_time(pHandle, pTime);
     if(err)
     {
-        a_mcp794xx_print_error_msg(pHandle, "read time before write");
-        return 1;
+        return err;
     }
 
-    status = (ptimeBuffer[0] & MCP794XX_ST_MASK) | a_pcf85xxx_dec2bcd(pTime->second);
-    err =  rtc_mcp794xx_i2c_write(pHandle, MCP794XX_RTC_SECOND_REG,  (uint8_t *)&status);
+    memset(ptimeBuffer, 0, sizeof(ptimeBuffer));
+    err = rtc_mcp794xx_i2c_read(pHandle, MCP794XX_RTC_SECOND_REG, (uint8_t *)ptimeBuffer, MCP794XX_TIME_BUFFER_SIZE);
     if(err)
     {
-        a_mcp794xx_print_error_msg(pHandle, "to write seconds");
+        a_mcp794xx_print_error_msg(pHandle, "read time before write");
         return 1;
     }
 
-    status = a_pcf85xxx_dec2bcd(pTime->minute);
-    err = rtc_mcp794xx_i2c_write(pHandle, MCP794XX_RTC_MINUTE_REG, (uint8_t *)&status);
+    a_mcp794xx_pack_time(pHandle, pTime, ptimeBuffer);
+
+    err = rtc_mcp794xx_i2c_write(pHandle, MCP794XX_RTC_SECOND_REG, (uint8_t *)ptimeBuffer, MCP794XX_TIME_BUFFER_SIZE);  /**< write the 7 time keeping registers in one burst */
     if(err)
     {
-        a_mcp794xx_print_error_msg(pHandle, "to write minutes");
+        a_mcp794xx_print_error_msg(pHandle, "write time and date");
         return 1;
     }
 
-    if(pHandle->time_param.time_Format == MCP794XX_24HR_FORMAT)
-    {
+    return 0;           /**< success */
+}
+
+/**
+ * @brief      This function wait for the oscillator running status to reach a state
+ * @param[in]  pHandle points to a mcp794xx handle structure
+ * @param[in]  status is the OSCRUN state to wait for
+ * @param[out] pElapsed_ms point to the estimated time waited (ms), incremented
+ * @return     status code
+ *             - 0 success
+ *             - 1 failed to read the oscillator status
+ *             - 5 timeout
+ * @note       - The timeout is measured with get_tick_ms when linked, otherwise one poll is followed by
+ *               delay_ms(1). With neither linked MCP794XX_OSC_STATUS_TIMEOUT_MS is a number of polls.
+ *             - Every poll and delay is accounted 1 ms in the estimate.
+ */
+uint8_t a_mcp794xx_wait_osc_running(mcp794xx_handle_t *const pHandle, mcp794xx_osc_status_t status, uint32_t *pElapsed_ms)
+{
+    mcp794xx_osc_status_t osc_status;
+    uint32_t u32Timeout = 0;
+    uint32_t u32Start = (pHandle->get_tick_ms != NULL) ? pHandle->get_tick_ms() : 0;
 
-        status = a_pcf85xxx_dec2bcd(pTime->hour);
-        err = rtc_mcp794xx_i2c_write(pHandle, MCP794XX_RTC_HOUR_REG,  (uint8_t *)&status);
+    for(;;)
+    {
+        err = mcp794xx_get_os_running_status(pHandle, &osc_status);
         if(err)
         {
-            a_mcp794xx_print_error_msg(pHandle, "to write hours");
-            return 1;
+            return 1;           /**< failed error */
         }
-    }
+        *pElapsed_ms += 1;      /**< one read transfer, less than 1 ms at 100 kHz */
 
-    else if(pHandle->time_param.time_Format == MCP794XX_12HR_FORMAT)
-    {
-        status = a_pcf85xxx_dec2bcd(pTime->hour) |(ptimeBuffer[2] & (MCP794XX_12HR_24HR_FRMT_STAT_MASK | MCP794XX_TIME_AM_PM_MASK));
-        err = rtc_mcp794xx_i2c_write(pHandle, MCP794XX_RTC_HOUR_REG, (uint8_t *)&status);
-        if(err)
+        if(osc_status == status)
         {
-            a_mcp794xx_print_error_msg(pHandle, "to write hours");
-            return 1;
+            return 0;           /**< success */
         }
 
-        err = mcp794xx_set_am_pm(pHandle, MCP794XX_RTC_HOUR_REG, pTime->am_pm_indicator);
-        if(err)
+        if(pHandle->get_tick_ms != NULL)
         {
-            return err;
+            u32Timeout = pHandle->get_tick_ms() - u32Start;
+        }
+        if(u32Timeout >= MCP794XX_OSC_STATUS_TIMEOUT_MS)
+        {
+            return 5;           /**< timeout */
+        }
+
+        if(pHandle->delay_ms != NULL)
+        {
+            pHandle->delay_ms(1);
+            *pElapsed_ms += 1;
+        }
+        if(pHandle->get_tick_ms == NULL)
+        {
+            u32Timeout++;
         }
     }
+}
+
+/**
+ * @brief      This function set the time and date with the oscillator stopped
+ * @param[in]  pHandle points to a mcp794xx handle structure
+ * @param[in]  pTime point to the date and time structure object
+ * @param[out] pError_ms point to the wall-time error introduced (ms), can be NULL
+ * @return     status code
+ *             - 0 success
+ *             - 1 set time failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 time is invalid
+ *             - 5 oscillator stop/start timeout
+ * @note       ST is cleared and OSCRUN is polled low, the 7 time registers are then burst
+ *             written with ST set and the function returns once OSCRUN is high again.
+ *             No carry can occur while the registers are written. The reported error is the
+ *             time elapsed between the call and the oscillator restart: measured with get_tick_ms
+ *             (plus one tick) when linked, otherwise an estimate accounting 1 ms per bus transfer
+ *             and per delay (100 kHz bus or faster), not a bound.
+ *             ST is set again on every failure once it has been cleared.
+ */
+uint8_t mcp794xx_set_time_and_date_atomic(mcp794xx_handle_t *const pHandle, mcp794xx_time_t *pTime, uint32_t *pError_ms)
+{
+    uint8_t ptimeBuffer[MCP794XX_TIME_BUFFER_SIZE];
+    uint8_t status;
+    uint8_t u8Res;
+    uint32_t u32Elapsed_ms = 0;
+    uint32_t u32Start;
+
+    if(pHandle == NULL)
+        return 2;     /**< return failed error */
+    if(pHandle->inited != 1)
+        return 3;      /**< return failed error */
 
-    status = a_pcf85xxx_dec2bcd(pTime->weekDay) | (ptimeBuffer[3] & (MCP794XX_OSC_RUN_STATUS_MASK | MCP794XX_PWR_FAIL_STATUS_MASK | MCP794XX_VBAT_EN_MASK));
-    err = rtc_mcp794xx_i2c_write(pHandle, MCP794XX_RTC_WKDAY_REG, (uint8_t *)&status);
+    err = a_mcp794xx_check_time(pHandle, pTime);
     if(err)
     {
-        a_mcp794xx_print_error_msg(pHandle, "to write week day");
-        return 1;
+        return err;
     }
+    u32Start = (pHandle->get_tick_ms != NULL) ? pHandle->get_tick_ms() : 0;
 
-    status = a_pcf85xxx_dec2bcd(pTime->date);
-    err = rtc_mcp794xx_i2c_write(pHandle, MCP794XX_RTC_DATE_REG, (uint8_t *)&status);
+    err = rtc_mcp794xx_i2c_read(pHandle, MCP794XX_RTC_SECOND_REG, (uint8_t *)ptimeBuffer, MCP794XX_TIME_BUFFER_SIZE);
     if(err)
     {
-        a_mcp794xx_print_error_msg(pHandle, "to write date");
+        a_mcp794xx_print_error_msg(pHandle, "read time before write");
         return 1;
     }
+    u32Elapsed_ms += 1;
 
-    status = a_pcf85xxx_dec2bcd(pTime->month) | (a_pcf85xxx_bcd2dec(ptimeBuffer[5] & MCP794XX_LEAP_YEAR_STATUS_MASK));
-    err = rtc_mcp794xx_i2c_write(pHandle, MCP794XX_RTC_MONTH_REG,  (uint8_t *)&status);
+    status = ptimeBuffer[0] & ~MCP794XX_ST_MASK;                                            /**< stop the oscillator */
+    err = rtc_mcp794xx_i2c_write(pHandle, MCP794XX_RTC_SECOND_REG, (uint8_t *)&status, 1);
     if(err)
     {
-        a_mcp794xx_print_error_msg(pHandle, "to write month");
+        a_mcp794xx_print_error_msg(pHandle, "clear oscillator start bit");
         return 1;
     }
+    u32Elapsed_ms += 1;
 
-    status = a_pcf85xxx_dec2bcd(pTime->year);
-    err = rtc_mcp794xx_i2c_write(pHandle, MCP794XX_RTC_YEAR_REG, (uint8_t *)&status);
+    u8Res = a_mcp794xx_wait_osc_running(pHandle, MCP794XX_OSC_DISABLED, &u32Elapsed_ms);
+    if(u8Res)
+    {
+        a_mcp794xx_print_error_msg(pHandle, "stop the oscillator");
+        (void)mcp794xx_set_osc_start_bit(pHandle, MCP794XX_BOOL_TRUE);                     /**< leave the clock running */
+        return u8Res;
+    }
+
+    a_mcp794xx_pack_time(pHandle, pTime, ptimeBuffer);
+    ptimeBuffer[0] |= MCP794XX_ST_MASK;                                                     /**< restart with the burst */
+
+    err = rtc_mcp794xx_i2c_write(pHandle, MCP794XX_RTC_SECOND_REG, (uint8_t *)ptimeBuffer, MCP794XX_TIME_BUFFER_SIZE);
     if(err)
     {
-        a_mcp794xx_print_error_msg(pHandle, "to write year");
+        a_mcp794xx_print_error_msg(pHandle, "write time and date");
+        (void)mcp794xx_set_osc_start_bit(pHandle, MCP794XX_BOOL_TRUE);
         return 1;
     }
+    u32Elapsed_ms += 1;
+
+    u8Res = a_mcp794xx_wait_osc_running(pHandle, MCP794XX_OSC_ENABLED, &u32Elapsed_ms);
+    if(u8Res)
+    {
+        a_mcp794xx_print_error_msg(pHandle, "restart the oscillator");
+        (void)mcp794xx_set_osc_start_bit(pHandle, MCP794XX_BOOL_TRUE);                     /**< the burst may not have landed */
+        return u8Res;
+    }
+
+    if(pHandle->get_tick_ms != NULL)
+    {
+        u32Elapsed_ms = pHandle->get_tick_ms() - u32Start + 1;                             /**< measured, rounded up */
+    }
+    if(pError_ms != NULL)
+    {
+        *pError_ms = u32Elapsed_ms;
+    }
 
     return 0;           /**< success */
 }
 
+/**
+ * @brief      This function maps the 2-digit RTCYEAR value into the century window
+ * @param[in]  pHandle points to a mcp794xx handle structure
+ * @param[in]  u8Year is the 2-digit year (0 - 99)
+ * @return     4-digit year
+ * @note       none
+ */
+uint16_t a_mcp794xx_year_from_rtc(mcp794xx_handle_t *const pHandle, uint8_t u8Year)
+{
+    uint16_t u16Year = pHandle->century_base - (pHandle->century_base % 100) + u8Year;
+
+    if(u16Year < pHandle->century_base)
+        u16Year += 100;
+
+    return u16Year;
+}
+
+/**
+ * @brief      This function decode the 7 time keeping registers
+ * @param[in]  pHandle points to a mcp794xx handle structure
+ * @param[in]  timeBuffer point to the registers read from 0x00
+ * @param[out] pTime points to a time structure object
+ * @return     none
+ * @note       none
+ */
+void a_mcp794xx_decode_time(mcp794xx_handle_t *const pHandle, uint8_t *timeBuffer, mcp794xx_time_t *pTime)
+{
+    pTime->second = a_pcf85xxx_bcd2dec(timeBuffer[0] & MCP794XX_SEC_BCD_MASK);
+    pTime->minute = a_pcf85xxx_bcd2dec(timeBuffer[1] & MCP794XX_MIN_BCD_MASK);
+    if(pHandle->time_param.time_Format == MCP794XX_24HR_FORMAT)
+    {
+        pTime->hour = a_pcf85xxx_bcd2dec(timeBuffer[2] & MCP794XX_24HR_FRMT_BCD_MASK);
+    }
+    else if(pHandle->time_param.time_Format == MCP794XX_12HR_FORMAT)
+    {
+        pTime->hour = a_pcf85xxx_bcd2dec(timeBuffer[2] & MCP794XX_12HR_FRMT_BCD_MASK);
+        pTime->am_pm_indicator = ((timeBuffer[2] & MCP794XX_TIME_AM_PM_MASK) >> 5) ;
+    }
+    pTime->weekDay = a_pcf85xxx_bcd2dec(timeBuffer[3] & MCP794XX_WKDAY_BCD_MASK);
+    pTime->date = a_pcf85xxx_bcd2dec(timeBuffer[4] & MCP794XX_DATE_BCD_MASK);
+    pTime->month = a_pcf85xxx_bcd2dec(timeBuffer[5] & MCP794XX_MONTH_BCD_MASK);
+    pTime->year = a_mcp794xx_year_from_rtc(pHandle, a_pcf85xxx_bcd2dec(timeBuffer[6] & MCP794XX_YEAR_BCD_MASK));
+}
+
 /**
  * @brief      This function get the current time and date
  * @param[in]  pHandle points to a mcp794xx handle structure
@@ -689,21 +1326,59 @@ uint8_t mcp794xx_get_time_and_date(mcp794xx_handle_t *const pHandle, mcp794xx_ti
         return 1;           /**< failed error */
     }
 
-    pTime->second = a_pcf85xxx_bcd2dec(timeBuffer[0] & MCP794XX_SEC_BCD_MASK);
-    pTime->minute = a_pcf85xxx_bcd2dec(timeBuffer[1] & MCP794XX_MIN_BCD_MASK);
-    if(pHandle->time_param.time_Format == MCP794XX_24HR_FORMAT)
+    a_mcp794xx_decode_time(pHandle, timeBuffer, pTime);
+
+    return 0;           /**< success */
+}
+
+/**
+ * @brief      This function get a rollover-safe snapshot of the current time and date
+ * @param[in]  pHandle points to a mcp794xx handle structure
+ * @param[out] pTime points to a time structure object
+ * @return     status code
+ *             - 0 success
+ *             - 1 get time failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       The 7 registers are read with one write-then-read transfer when i2c_write_read is
+ *             linked. A second read is only done when the seconds read 59, the result is always coherent.
+ */
+uint8_t mcp794xx_get_time_snapshot(mcp794xx_handle_t *const pHandle, mcp794xx_time_t *pTime)
+{
+    uint8_t timeBuffer[MCP794XX_TIME_BUFFER_SIZE];
+    uint8_t verifyBuffer[MCP794XX_TIME_BUFFER_SIZE];
+
+    if(pHandle == NULL)
+        return 2;     /**< return failed error */
+    if(pHandle->inited != 1)
+        return 3;      /**< return failed error */
+
+    err = rtc_mcp794xx_i2c_read(pHandle, MCP794XX_RTC_SECOND_REG, (uint8_t *)timeBuffer, MCP794XX_TIME_BUFFER_SIZE);
+    if(err)
     {
-        pTime->hour = a_pcf85xxx_bcd2dec(timeBuffer[2] & MCP794XX_24HR_FRMT_BCD_MASK);
+        a_mcp794xx_print_error_msg(pHandle, "read time and date");
+        return 1;           /**< failed error */
     }
-    else if(pHandle->time_param.time_Format == MCP794XX_12HR_FORMAT)
+
+    /**< a carry into the upper registers can only start from 59 seconds: when the seconds were read as 59,
+         read again. If the seconds still read 59 no tick happened during the first read, otherwise the carry
+         completed before the second read started and the second read is used */
+    if((timeBuffer[0] & MCP794XX_SEC_BCD_MASK) == 0x59)
     {
-        pTime->hour = a_pcf85xxx_bcd2dec(timeBuffer[2] & MCP794XX_12HR_FRMT_BCD_MASK);
-        pTime->am_pm_indicator = ((timeBuffer[2] & MCP794XX_TIME_AM_PM_MASK) >> 5) ;
+        err = rtc_mcp794xx_i2c_read(pHandle, MCP794XX_RTC_SECOND_REG, (uint8_t *)verifyBuffer, MCP794XX_TIME_BUFFER_SIZE);
+        if(err)
+        {
+            a_mcp794xx_print_error_msg(pHandle, "read time and date");
+            return 1;           /**< failed error */
+        }
+
+        if((verifyBuffer[0] & MCP794XX_SEC_BCD_MASK) != 0x59)
+        {
+            memcpy(timeBuffer, verifyBuffer, sizeof(timeBuffer));
+        }
     }
-    pTime->weekDay = a_pcf85xxx_bcd2dec(timeBuffer[3] & MCP794XX_WKDAY_BCD_MASK);
-    pTime->date = a_pcf85xxx_bcd2dec(timeBuffer[4] & MCP794XX_DATE_BCD_MASK);
-    pTime->month = a_pcf85xxx_bcd2dec(timeBuffer[5] & MCP794XX_MONTH_BCD_MASK);
-    pTime->year = a_pcf85xxx_bcd2dec(timeBuffer[6] & MCP794XX_YEAR_BCD_MASK) + 2000;
+
+    a_mcp794xx_decode_time(pHandle, timeBuffer, pTime);
 
     return 0;           /**< success */
 }
@@ -737,7 +1412,7 @@ uint8_t mcp794xx_set_hour_format(mcp794xx_handle_t *const pHandle, uint8_t u8Reg
     read_status &= ~(1 << 6);            /*< clear hour format status bit */
     read_status |= (format << 6);        /*< write hour format status bit */
 
-    err = rtc_mcp794xx_i2c_write(pHandle, u8Register, (uint8_t*)&read_status);
+    err = rtc_mcp794xx_i2c_write(pHandle, u8Register, (uint8_t*)&read_status, 1);
     if(err)
     {
         a_mcp794xx_print_error_msg(pHandle, "set hour format ");
@@ -814,7 +1489,7 @@ uint8_t mcp794xx_set_am_pm(mcp794xx_handle_t *const pHandle, uint8_t u8Register,
     read_status &= ~(1 << 5);
     read_status |= (am_pm << 5);
 
-    err = rtc_mcp794xx_i2c_write(pHandle, u8Register, (uint8_t *)&read_status);
+    err = rtc_mcp794xx_i2c_write(pHandle, u8Register, (uint8_t *)&read_status, 1);
     if(err)
     {
         a_mcp794xx_print_error_msg(pHandle, "set time am/pm indicator");
@@ -885,7 +1560,7 @@ uint8_t mcp794xx_set_osc_status(mcp794xx_handle_t *const pHandle, mcp794xx_osc_s
     read_status &= ~(1 << 7);
     read_status |= (status << 7);
 
-    err = rtc_mcp794xx_i2c_write(pHandle, MCP794XX_RTC_SECOND_REG, (uint8_t*)&read_status);
+    err = rtc_mcp794xx_i2c_write(pHandle, MCP794XX_RTC_SECOND_REG, (uint8_t*)&read_status, 1);
     if(err)
     {
         a_mcp794xx_print_error_msg(pHandle, "set oscillator status");
@@ -937,9 +1612,6 @@ uint8_t mcp794xx_get_osc_status(mcp794xx_handle_t *const pHandle, mcp794xx_osc_s
  */
 uint8_t mcp794xx_clr_pwr_fail_status(mcp794xx_handle_t *const pHandle)
 {
-
-    uint8_t read_status;
-
     if(pHandle == NULL)
         return 2;     /**< return failed error */
     if(pHandle->inited != 1)
@@ -950,15 +1622,7 @@ uint8_t mcp794xx_clr_pwr_fail_status(mcp794xx_handle_t *const pHandle)
         return 4;
     }
 
-    err = rtc_mcp794xx_i2c_read(pHandle, MCP794XX_RTC_WKDAY_REG, (uint8_t *)&read_status, 1);
-    if(err)
-    {
-        a_mcp794xx_print_error_msg(pHandle, "read status reg");
-        return 1;           /**< failed error */
-    }
-
-    read_status &= ~(1 << 4);
-    err = rtc_mcp794xx_i2c_write(pHandle, MCP794XX_RTC_WKDAY_REG, (uint8_t*)&read_status);
+    err = a_mcp794xx_reg_update(pHandle, MCP794XX_RTC_WKDAY_REG, MCP794XX_PWR_FAIL_STATUS_MASK, 0);
     if(err)
     {
         a_mcp794xx_print_error_msg(pHandle, "clear pwr fail status");
@@ -993,7 +1657,7 @@ uint8_t mcp794xx_get_pwr_fail_status(mcp794xx_handle_t *const pHandle, mcp794xx_
         return 4;
     }
 
-    err = rtc_mcp794xx_i2c_read(pHandle, MCP794XX_RTC_WKDAY_REG, (uint8_t *)&read_status, 1);
+    err = a_mcp794xx_reg_read(pHandle, MCP794XX_RTC_WKDAY_REG, MCP794XX_PWR_FAIL_STATUS_MASK, (uint8_t *)&read_status);
     if(err)
     {
         a_mcp794xx_print_error_msg(pHandle, "read status reg");
@@ -1019,6 +1683,7 @@ uint8_t mcp794xx_get_pwr_fail_status(mcp794xx_handle_t *const pHandle, mcp794xx_
  * @note    - The PWRFAIL bit must be cleared to log new timestamp data.
             - Reading or writing the external battery back up bit will clear the pwr fail time stamp.
             - Time stamp should be read at start up before reading or setting current time and date.
+            - The year is not set, see mcp794xx_get_pwr_fail_time_stamp_with_year.
  */
 uint8_t mcp794xx_get_pwr_fail_time_stamp(mcp794xx_handle_t *const pHandle, mcp794xx_pwr_fail_type_t powerMode, mcp794xx_time_t *pTime)
 {
@@ -1083,55 +1748,98 @@ uint8_t mcp794xx_get_pwr_fail_time_stamp(mcp794xx_handle_t *const pHandle, mcp79
     }
     pTime->date = a_pcf85xxx_bcd2dec(timeBuffer[2] & MCP794XX_PWRXX_DATE_BCD_MASK);          /**< read the power failure date */
     pTime->month = a_pcf85xxx_bcd2dec(timeBuffer[3] & MCP794XX_MONTH_BCD_MASK);              /**< read the power failure month timestamp */
+    pTime->time_Format = pHandle->time_param.time_Format;
 
     return 0;  /**< success */
 }
 
 /**
- * @brief This function set the am/pm and time format for pwr up/down time stamp
+ * @brief This function get the power fail time stamp with its year
  * @param[in] pHandle points to a mcp794xx handle structure
+ * @param[in] powerMode is the power fail mode (power-up/power-down)
+ * @param[out] pTime point to the time structure object
  * @return status code
  *          - 0 success
  *          - 1 failed
-            - 2 handle null
+ *          - 2 handle null
  *          - 3 handle is not initialized
+ *          - 4 invalid power failure mode
+ * @note    The time stamp is read with mcp794xx_get_pwr_fail_time_stamp, the current time is then read
+ *          and the year is inferred with mcp794xx_infer_pwr_fail_year.
  */
-uint8_t mcp794xx_set_pwr_fail_time_param(mcp794xx_handle_t *const pHandle)
+uint8_t mcp794xx_get_pwr_fail_time_stamp_with_year(mcp794xx_handle_t *const pHandle, mcp794xx_pwr_fail_type_t powerMode, mcp794xx_time_t *pTime)
 {
-	uint8_t format, am_pm_indicator;
+    uint8_t nowBuffer[MCP794XX_TIME_BUFFER_SIZE];
+    mcp794xx_time_t now;
 
-    if(pHandle->device_variant == MCP7940M_VARIANT){
-         a_mcp794xx_print_error_msg(pHandle, "pwr fail param, not supported for the mcp7940M variant");
-        return 4;
+    err = mcp794xx_get_pwr_fail_time_stamp(pHandle, powerMode, pTime);
+    if(err)
+    {
+        return err;
     }
 
-	err = mcp794xx_get_hour_format(pHandle, MCP794XX_RTC_HOUR_REG, &format);
-	if(err){
-	  return err;
-	}
-
-	err = mcp794xx_get_am_pm(pHandle, MCP794XX_RTC_HOUR_REG, &am_pm_indicator);
-	if(err){
-	  return err;
-	}
+    err = rtc_mcp794xx_i2c_read(pHandle, MCP794XX_RTC_SECOND_REG, (uint8_t *)nowBuffer, MCP794XX_TIME_BUFFER_SIZE);
+    if(err)
+    {
+        a_mcp794xx_print_error_msg(pHandle, "read current time for the time stamp year");
+        return 1;           /**< failed error */
+    }
+    a_mcp794xx_decode_time(pHandle, nowBuffer, &now);
+    now.time_Format = pHandle->time_param.time_Format;
+    mcp794xx_infer_pwr_fail_year(&now, pTime);                                                 /**< time stamp holds no year */
 
-	err = mcp794xx_set_hour_format(pHandle, MCP794XX_PWR_DWN_HOUR_REG, format);          /**< set time format for power down time stamp */
-	if(err){
-	  return err;
-	}
+    return 0;  /**< success */
+}
+
+/**
+ * @brief This function set the am/pm and time format for pwr up/down time stamp
+ * @param[in] pHandle points to a mcp794xx handle structure
+ * @return status code
+ *          - 0 success
+ *          - 1 failed
+            - 2 handle null
+ *          - 3 handle is not initialized
+ *          - 4 not supported by the variant
+ * @note    Both hour registers are updated with one burst write of 0x19 - 0x1D.
+ */
+uint8_t mcp794xx_set_pwr_fail_time_param(mcp794xx_handle_t *const pHandle)
+{
+	uint8_t hour_reg;
+	uint8_t fmt_mask = MCP794XX_PWRXX_12HR_24HR_FRMT_STAT_MASK | MCP794XX_PWRXX_TIME_AM_PM_MASK;
+	uint8_t pwrBuffer[MCP794XX_PWR_UP_HOUR_REG - MCP794XX_PWR_DWN_HOUR_REG + 1];     /**< power down hour register up to power up hour register */
+
+    if(pHandle == NULL)
+        return 2;     /**< return failed error */
+    if(pHandle->inited != 1)
+        return 3;      /**< return failed error */
+
+    if(pHandle->device_variant == MCP7940M_VARIANT){
+         a_mcp794xx_print_error_msg(pHandle, "pwr fail param, not supported for the mcp7940M variant");
+        return 4;
+    }
 
-	err = mcp794xx_set_hour_format(pHandle, MCP794XX_PWR_UP_HOUR_REG, format);          /**< set time format for power up time stamp */
+	err = rtc_mcp794xx_i2c_read(pHandle, MCP794XX_RTC_HOUR_REG, (uint8_t *)&hour_reg, 1);
 	if(err){
-	  return err;
+	  a_mcp794xx_print_error_msg(pHandle, "get hour format");
+	  return 1;
 	}
 
-	err = mcp794xx_set_am_pm(pHandle, MCP794XX_PWR_DWN_HOUR_REG,  am_pm_indicator);
+	pHandle->time_param.time_Format = (mcp794xx_time_format_t)((hour_reg & MCP794XX_12HR_24HR_FRMT_STAT_MASK) >> 6);
+
+	err = rtc_mcp794xx_i2c_read(pHandle, MCP794XX_PWR_DWN_HOUR_REG, (uint8_t *)pwrBuffer, sizeof(pwrBuffer));
 	if(err){
-	  return err;
+	  a_mcp794xx_print_error_msg(pHandle, "read power fail hour registers before write");
+	  return 1;
 	}
-	err = mcp794xx_set_am_pm(pHandle, MCP794XX_PWR_UP_HOUR_REG,  am_pm_indicator);
+
+	/**< copy the time format and am/pm indicator to the power down (0x19) and power up (0x1D) hour registers */
+	pwrBuffer[0] = (pwrBuffer[0] & ~fmt_mask) | (hour_reg & fmt_mask);
+	pwrBuffer[4] = (pwrBuffer[4] & ~fmt_mask) | (hour_reg & fmt_mask);
+
+	err = rtc_mcp794xx_i2c_write(pHandle, MCP794XX_PWR_DWN_HOUR_REG, (uint8_t *)pwrBuffer, sizeof(pwrBuffer));
 	if(err){
-	  return err;
+	  a_mcp794xx_print_error_msg(pHandle, "set power fail time stamp format");
+	  return 1;
 	}
 	return 0; 			/**< success */
 }
@@ -1177,45 +1885,22 @@ uint8_t mcp794xx_get_leap_year_status(mcp794xx_handle_t *const pHandle, mcp794xx
 *          - 1 failed
            - 2 handle null
 *          - 3 handle is not initialized
+*          - 4 invalid alarm
 */
 uint8_t mcp794xx_set_alarm_enable_status(mcp794xx_handle_t *const pHandle, mcp794xx_alarm_t alarm, mcp794xx_bool_t status)
 {
-    uint8_t read_status;
-
     if(pHandle == NULL)
         return 2;     /**< return failed error */
     if(pHandle->inited != 1)
         return 3;      /**< return failed error */
 
-    err = rtc_mcp794xx_i2c_read(pHandle, MCP794XX_CONTROL_REG, (uint8_t *)&read_status, 1);
-    if(err)
-    {
-        a_mcp794xx_print_error_msg(pHandle, "read control register");
-        return 1;           /**< failed error */
-    }
-
     if(alarm == MCP794XX_ALARM0)
     {
-        read_status &= ~(1 << 4);           /**< clear alarm enable status */
-        read_status |= (status << 4);
-        err = rtc_mcp794xx_i2c_write(pHandle, MCP794XX_CONTROL_REG, (uint8_t *)&read_status);
-        if(err)
-        {
-            a_mcp794xx_print_error_msg(pHandle, "write alarm enable status");
-            return 1;           /**< failed error */
-        }
-
+        err = a_mcp794xx_reg_update(pHandle, MCP794XX_CONTROL_REG, MCP794XX_CTRL_ALARM0_EN_MASK, (uint8_t)(status << 4));
     }
-    if(MCP794XX_ALARM1)
+    else if(alarm == MCP794XX_ALARM1)
     {
-        read_status &= ~(1 << 5);           /**< clear alarm enable status */
-        read_status |= (status << 5);
-        err = rtc_mcp794xx_i2c_write(pHandle, MCP794XX_CONTROL_REG, (uint8_t *)&read_status);
-        if(err)
-        {
-            a_mcp794xx_print_error_msg(pHandle, "write alarm enable status");
-            return 1;           /**< failed error */
-        }
+        err = a_mcp794xx_reg_update(pHandle, MCP794XX_CONTROL_REG, MCP794XX_CTRL_ALARM1_EN_MASK, (uint8_t)(status << 5));
     }
     else
     {
@@ -1223,6 +1908,12 @@ uint8_t mcp794xx_set_alarm_enable_status(mcp794xx_handle_t *const pHandle, mcp79
         return 4;           /**< invalid alarm */
     }
 
+    if(err)
+    {
+        a_mcp794xx_print_error_msg(pHandle, "write alarm enable status");
+        return 1;           /**< failed error */
+    }
+
     return 0;              /**< success */
 }
 
@@ -1236,6 +1927,7 @@ uint8_t mcp794xx_set_alarm_enable_status(mcp794xx_handle_t *const pHandle, mcp79
  *          - 1 failed
             - 2 handle null
  *          - 3 handle is not initialized
+ *          - 4 invalid alarm
  */
 uint8_t mcp794xx_get_alarm_enable_status(mcp794xx_handle_t *const pHandle, mcp794xx_alarm_t alarm, mcp794xx_bool_t *pStatus)
 {
@@ -1246,7 +1938,13 @@ uint8_t mcp794xx_get_alarm_enable_status(mcp794xx_handle_t *const pHandle, mcp79
     if(pHandle->inited != 1)
         return 3;      /**< return failed error */
 
-    err = rtc_mcp794xx_i2c_read(pHandle, MCP794XX_CONTROL_REG, (uint8_t *)&read_status, 1);
+    if((alarm != MCP794XX_ALARM0) && (alarm != MCP794XX_ALARM1))
+    {
+        a_mcp794xx_print_error_msg(pHandle, "invalid alarm selected");
+        return 4;           /**< invalid alarm */
+    }
+
+    err = a_mcp794xx_reg_read(pHandle, MCP794XX_CONTROL_REG, (MCP794XX_ALRAM0_ENABLE_MASK | MCP794XX_ALRAM1_ENABLE_MASK), (uint8_t *)&read_status);
     if(err)
     {
         a_mcp794xx_print_error_msg(pHandle, "read alarm enable register");
@@ -1256,16 +1954,10 @@ uint8_t mcp794xx_get_alarm_enable_status(mcp794xx_handle_t *const pHandle, mcp79
     if(alarm == MCP794XX_ALARM0)
     {
         *pStatus = (mcp794xx_bool_t) ((read_status & MCP794XX_ALRAM0_ENABLE_MASK) >> 4);
-
-    }
-    else if(MCP794XX_ALARM1)
-    {
-        *pStatus = (mcp794xx_bool_t) ((read_status & MCP794XX_ALRAM1_ENABLE_MASK) >> 5);
     }
     else
     {
-        a_mcp794xx_print_error_msg(pHandle, "invalid alarm selected");
-        return 4;           /**< invalid alarm */
+        *pStatus = (mcp794xx_bool_t) ((read_status & MCP794XX_ALRAM1_ENABLE_MASK) >> 5);
     }
 
     return 0;               /**< success */
@@ -1286,8 +1978,6 @@ uint8_t mcp794xx_get_alarm_enable_status(mcp794xx_handle_t *const pHandle, mcp79
  */
 uint8_t mcp794xx_set_alarm_interrupt_output_polarity(mcp794xx_handle_t *const pHandle, mcp794xx_alarm_t alarm, mcp794xx_int_output_polarity_t polarity)
 {
-    uint8_t read_status;
-
     if(pHandle == NULL)
         return 2;     /**< return failed error */
     if(pHandle->inited != 1)
@@ -1298,20 +1988,10 @@ uint8_t mcp794xx_set_alarm_interrupt_output_polarity(mcp794xx_handle_t *const pH
 
         case MCP794XX_ALARM0:
         {
-            err = rtc_mcp794xx_i2c_read(pHandle, MCP794XX_ALM0_WKDAY_REG, (uint8_t *)&read_status, 1);
-            if(err)
-            {
-                a_mcp794xx_print_error_msg(pHandle, "read alarm 0 polarity register");
-                return 1;           /**< failed error */
-            }
-
-            read_status &= ~(1 << 7);                                   /**< clear polarity bit */
-            read_status |= (polarity << 7);
-
-            err = rtc_mcp794xx_i2c_write(pHandle, MCP794XX_ALM0_WKDAY_REG, (uint8_t *)&read_status);
+            err = a_mcp794xx_reg_update(pHandle, MCP794XX_ALM0_WKDAY_REG, MCP794XX_ALARMx_INT_POL_MASK, (uint8_t)(polarity << 7));
             if(err)
             {
-                a_mcp794xx_print_error_msg(pHandle, "read alarm 0 polarity register");
+                a_mcp794xx_print_error_msg(pHandle, "write alarm 0 polarity register");
                 return 1;           /**< failed error */
             }
             break;
@@ -1319,23 +1999,12 @@ uint8_t mcp794xx_set_alarm_interrupt_output_polarity(mcp794xx_handle_t *const pH
 
         case MCP794XX_ALARM1:
         {
-            err = rtc_mcp794xx_i2c_read(pHandle, MCP794XX_ALM1_WKDAY_REG, (uint8_t *)&read_status, 1);
-            if(err)
-            {
-                a_mcp794xx_print_error_msg(pHandle, "read alarm 1 polarity register");
-                return 1;           /**< failed error */
-            }
-
-            read_status &= ~(1 << 7);                                   /**< clear polarity bit */
-            read_status |= (polarity << 7);
-
-            err = rtc_mcp794xx_i2c_write(pHandle, MCP794XX_ALM1_WKDAY_REG, (uint8_t *)&read_status);
+            err = a_mcp794xx_reg_update(pHandle, MCP794XX_ALM1_WKDAY_REG, MCP794XX_ALARMx_INT_POL_MASK, (uint8_t)(polarity << 7));
             if(err)
             {
-                a_mcp794xx_print_error_msg(pHandle, "read alarm 0 polarity register");
+                a_mcp794xx_print_error_msg(pHandle, "write alarm 1 polarity register");
                 return 1;           /**< failed error */
             }
-
             break;
         }
 
@@ -1378,7 +2047,7 @@ uint8_t mcp794xx_get_alarm_interrupt_output_polarity(mcp794xx_handle_t *const pH
 
         case MCP794XX_ALARM0:
         {
-            err = rtc_mcp794xx_i2c_read(pHandle, MCP794XX_ALM0_WKDAY_REG, (uint8_t *)&read_status, 1);
+            err = a_mcp794xx_reg_read(pHandle, MCP794XX_ALM0_WKDAY_REG, MCP794XX_ALARMx_INT_POL_MASK, (uint8_t *)&read_status);
             if(err)
             {
                 a_mcp794xx_print_error_msg(pHandle, "read alarm 0 polarity register");
@@ -1391,7 +2060,7 @@ uint8_t mcp794xx_get_alarm_interrupt_output_polarity(mcp794xx_handle_t *const pH
 
         case MCP794XX_ALARM1:
         {
-            err = rtc_mcp794xx_i2c_read(pHandle, MCP794XX_ALM1_WKDAY_REG, (uint8_t *)&read_status, 1);
+            err = a_mcp794xx_reg_read(pHandle, MCP794XX_ALM1_WKDAY_REG, MCP794XX_ALARMx_INT_POL_MASK, (uint8_t *)&read_status);
             if(err)
             {
                 a_mcp794xx_print_error_msg(pHandle, "read alarm 1 polarity register");
@@ -1415,28 +2084,16 @@ uint8_t mcp794xx_get_alarm_interrupt_output_polarity(mcp794xx_handle_t *const pH
 }
 
 /**
- * @brief This function set the alarm time and date
+ * @brief This function validate an alarm time against the current hour format
  * @param[in] pHandle points to a mcp794xx handle structure
- * @param[in] alarm is the alarm type (ALARM0/ALARM1)
- * @param[in] pTime point to the alarm time to set
+ * @param[in] pTime point to the alarm time to validate
  * @return status code
  *          - 0 success
- *          - 1 failed
-            - 2 handle null
- *          - 3 handle is not initialized
- *          - 5 invalid mask
+ *          - 4 invalid alarm time
+ * @note    none
  */
-uint8_t mcp794xx_set_alarm_time_date(mcp794xx_handle_t *const pHandle, mcp794xx_alarm_t alarm, mcp794xx_time_t *pTime)
+uint8_t a_mcp794xx_check_alarm_time(mcp794xx_handle_t *const pHandle, mcp794xx_time_t *pTime)
 {
-
-    uint8_t ptimeBuffer[MCP794XX_TIME_BUFFER_SIZE];
-    uint8_t status;
-
-    if(pHandle == NULL)
-        return 2;     /**< return failed error */
-    if(pHandle->inited != 1)
-        return 3;      /**< return failed error */
-
     if(pHandle->time_param.time_Format == MCP794XX_24HR_FORMAT)
     {
 
@@ -1525,161 +2182,106 @@ uint8_t mcp794xx_set_alarm_time_date(mcp794xx_handle_t *const pHandle, mcp794xx_
         return 4;
     }
 
-    memset(ptimeBuffer, 0, sizeof(ptimeBuffer));              /**< clear buffer */
+    return 0;     /**< success */
+}
+
+/**
+ * @brief This function write the alarm registers in one burst
+ * @param[in] pHandle points to a mcp794xx handle structure
+ * @param[in] alarm is the alarm type (ALARM0/ALARM1)
+ * @param[in] pTime point to the alarm time to set
+ * @param[in] u8Wkday_mask is the week day register bits to replace (alarm mask, polarity)
+ * @param[in] u8Wkday_bits is the new value of the replaced week day register bits
+ * @return status code
+ *          - 0 success
+ *          - 1 failed
+ *          - 4 invalid alarm
+ * @note    The six alarm registers are read once and written back with one burst. With the shadow enabled the
+ *          kept week day register bits come from the shadow, so a pending transaction change is written too.
+ */
+uint8_t a_mcp794xx_write_alarm_regs(mcp794xx_handle_t *const pHandle, mcp794xx_alarm_t alarm, mcp794xx_time_t *pTime, uint8_t u8Wkday_mask, uint8_t u8Wkday_bits)
+{
+    uint8_t ptimeBuffer[MCP794XX_TIME_BUFFER_SIZE - 1];
+    uint8_t u8Reg;
 
     if(alarm == MCP794XX_ALARM0)
     {
-
-        err = rtc_mcp794xx_i2c_read(pHandle, MCP794XX_ALM0_SEC_REG, (uint8_t *)ptimeBuffer, (MCP794XX_TIME_BUFFER_SIZE - 1) );
-
-        status =  a_pcf85xxx_dec2bcd(pTime->second);
-        err =  rtc_mcp794xx_i2c_write(pHandle, MCP794XX_ALM0_SEC_REG,(uint8_t *)&status);
-        if(err)
-        {
-            a_mcp794xx_print_error_msg(pHandle, "to write alarm 0 seconds");
-            return 1;
-        }
-
-        status = a_pcf85xxx_dec2bcd(pTime->minute);
-        err = rtc_mcp794xx_i2c_write(pHandle, MCP794XX_ALM0_MIN_REG, (uint8_t *)&status);
-        if(err)
-        {
-            a_mcp794xx_print_error_msg(pHandle, "to write alarm 0 minutes");
-            return 1;
-        }
-
-        if(pHandle->time_param.time_Format == MCP794XX_24HR_FORMAT)
-        {
-            status = a_pcf85xxx_dec2bcd(pTime->hour) | (ptimeBuffer[2] & MCP794XX_ALARMx_12HR_24HR_FRMT_STAT_MASK);
-            err = rtc_mcp794xx_i2c_write(pHandle, MCP794XX_ALM0_HOUR_REG,(uint8_t *)&status);
-            if(err)
-            {
-                a_mcp794xx_print_error_msg(pHandle, "to write alarm 0 hours");
-                return 1;
-            }
-        }
-
-        else if(pHandle->time_param.time_Format == MCP794XX_12HR_FORMAT)
-        {
-        	status = a_pcf85xxx_dec2bcd(pTime->hour) | (ptimeBuffer[2] & (MCP794XX_ALARMx_12HR_24HR_FRMT_STAT_MASK | MCP794XX_ALARMx_AM_PM_MASK));
-            err = rtc_mcp794xx_i2c_write(pHandle, MCP794XX_ALM0_HOUR_REG, (uint8_t *)&status);
-            if(err)
-            {
-                a_mcp794xx_print_error_msg(pHandle, "to write alarm 0 hours");
-                return 1;
-            }
-            err = mcp794xx_set_am_pm(pHandle, MCP794XX_ALM0_HOUR_REG, pTime->am_pm_indicator);
-            if(err)
-            {
-                return err;
-            }
-        }
-
-        status = a_pcf85xxx_dec2bcd(pTime->weekDay) | (ptimeBuffer[3] & (MCP794XX_ALARMx_INT_POL_MASK | MCP794XX_ALARMx_TYPE_MASK | MCP794XX_ALARMx_IF_MASK));
-        err = rtc_mcp794xx_i2c_write(pHandle, MCP794XX_ALM0_WKDAY_REG, (uint8_t *)&status);
-        if(err)
-        {
-            a_mcp794xx_print_error_msg(pHandle, "to write alarm 0 week day");
-            return 1;
-        }
-
-        status = a_pcf85xxx_dec2bcd(pTime->date);
-        err = rtc_mcp794xx_i2c_write(pHandle, MCP794XX_ALM0_DATE_REG, (uint8_t *)&status);
-        if(err)
-        {
-            a_mcp794xx_print_error_msg(pHandle, "to write alarm 0 date");
-            return 1;
-        }
-
-        status =  a_pcf85xxx_dec2bcd(pTime->month);
-        err = rtc_mcp794xx_i2c_write(pHandle, MCP794XX_ALM0_MONTH_REG, (uint8_t *)&status);
-        if(err)
-        {
-            a_mcp794xx_print_error_msg(pHandle, "to write alarm 0 month");
-            return 1;
-        }
+        u8Reg = MCP794XX_ALM0_SEC_REG;
     }
     else if(alarm == MCP794XX_ALARM1)
     {
-
-        err = rtc_mcp794xx_i2c_read(pHandle, MCP794XX_ALM1_SEC_REG, (uint8_t *)ptimeBuffer, (MCP794XX_TIME_BUFFER_SIZE - 1) );
-
-        status =  a_pcf85xxx_dec2bcd(pTime->second);
-		err =  rtc_mcp794xx_i2c_write(pHandle, MCP794XX_ALM1_SEC_REG,(uint8_t *)&status);
-		if(err)
-		{
-			a_mcp794xx_print_error_msg(pHandle, "to write alarm 1 seconds");
-			return 1;
-		}
-
-		status = a_pcf85xxx_dec2bcd(pTime->minute);
-		err = rtc_mcp794xx_i2c_write(pHandle, MCP794XX_ALM1_MIN_REG, (uint8_t *)&status);
-		if(err)
-		{
-			a_mcp794xx_print_error_msg(pHandle, "to write alarm 1 minutes");
-			return 1;
-		}
-
-		if(pHandle->time_param.time_Format == MCP794XX_24HR_FORMAT)
-		{
-			status = a_pcf85xxx_dec2bcd(pTime->hour) | (ptimeBuffer[2] & MCP794XX_ALARMx_12HR_24HR_FRMT_STAT_MASK);
-			err = rtc_mcp794xx_i2c_write(pHandle, MCP794XX_ALM1_HOUR_REG,(uint8_t *)&status);
-			if(err)
-			{
-				a_mcp794xx_print_error_msg(pHandle, "to write alarm 1 hours");
-				return 1;
-			}
-		}
-
-		else if(pHandle->time_param.time_Format == MCP794XX_12HR_FORMAT)
-		{
-			status = a_pcf85xxx_dec2bcd(pTime->hour) | (ptimeBuffer[2] & (MCP794XX_ALARMx_12HR_24HR_FRMT_STAT_MASK | MCP794XX_ALARMx_AM_PM_MASK));
-			err = rtc_mcp794xx_i2c_write(pHandle, MCP794XX_ALM1_HOUR_REG, (uint8_t *)&status);
-			if(err)
-			{
-				a_mcp794xx_print_error_msg(pHandle, "to write alarm 1 hours");
-				return 1;
-			}
-			err = mcp794xx_set_am_pm(pHandle, MCP794XX_ALM1_HOUR_REG, pTime->am_pm_indicator);
-			if(err)
-			{
-				return err;
-			}
-		}
-
-		status = a_pcf85xxx_dec2bcd(pTime->weekDay) | (ptimeBuffer[3] & (MCP794XX_ALARMx_INT_POL_MASK | MCP794XX_ALARMx_TYPE_MASK | MCP794XX_ALARMx_IF_MASK));
-		err = rtc_mcp794xx_i2c_write(pHandle, MCP794XX_ALM1_WKDAY_REG, (uint8_t *)&status);
-		if(err)
-		{
-			a_mcp794xx_print_error_msg(pHandle, "to write alarm 1 week day");
-			return 1;
-		}
-
-		status = a_pcf85xxx_dec2bcd(pTime->date);
-		err = rtc_mcp794xx_i2c_write(pHandle, MCP794XX_ALM1_DATE_REG, (uint8_t *)&status);
-		if(err)
-		{
-			a_mcp794xx_print_error_msg(pHandle, "to write alarm 1 date");
-			return 1;
-		}
-
-		status =  a_pcf85xxx_dec2bcd(pTime->month);
-		err = rtc_mcp794xx_i2c_write(pHandle, MCP794XX_ALM1_MONTH_REG, (uint8_t *)&status);
-		if(err)
-		{
-			a_mcp794xx_print_error_msg(pHandle, "to write alarm 1 month");
-			return 1;
-		}
+        u8Reg = MCP794XX_ALM1_SEC_REG;
     }
-
-    else{
+    else
+    {
         a_mcp794xx_print_error_msg(pHandle, "invalid alarm selected");
         return 4;
     }
 
+    err = rtc_mcp794xx_i2c_read(pHandle, u8Reg, (uint8_t *)ptimeBuffer, sizeof(ptimeBuffer));
+    if(err)
+    {
+        a_mcp794xx_print_error_msg(pHandle, "read alarm before write");
+        return 1;
+    }
+    if(pHandle->shadow.enable == 1)
+    {
+        ptimeBuffer[3] = pHandle->shadow.reg[u8Reg + (MCP794XX_ALM0_WKDAY_REG - MCP794XX_ALM0_SEC_REG)];   /**< keeps a pending polarity or mask change */
+    }
+
+    ptimeBuffer[0] = a_pcf85xxx_dec2bcd(pTime->second);
+    ptimeBuffer[1] = a_pcf85xxx_dec2bcd(pTime->minute);
+    if(pHandle->time_param.time_Format == MCP794XX_24HR_FORMAT)
+    {
+        ptimeBuffer[2] = a_pcf85xxx_dec2bcd(pTime->hour) | (ptimeBuffer[2] & MCP794XX_ALARMx_12HR_24HR_FRMT_STAT_MASK);
+    }
+    else
+    {
+        ptimeBuffer[2] = a_pcf85xxx_dec2bcd(pTime->hour) | (ptimeBuffer[2] & MCP794XX_ALARMx_12HR_24HR_FRMT_STAT_MASK) |
+                         ((pTime->am_pm_indicator << 5) & MCP794XX_ALARMx_AM_PM_MASK);
+    }
+    ptimeBuffer[3] &= (MCP794XX_ALARMx_INT_POL_MASK | MCP794XX_ALARMx_TYPE_MASK | MCP794XX_ALARMx_IF_MASK);
+    ptimeBuffer[3] = (ptimeBuffer[3] & ~u8Wkday_mask) | (u8Wkday_bits & u8Wkday_mask) | a_pcf85xxx_dec2bcd(pTime->weekDay);
+    ptimeBuffer[4] = a_pcf85xxx_dec2bcd(pTime->date);
+    ptimeBuffer[5] = a_pcf85xxx_dec2bcd(pTime->month);
+
+    err = rtc_mcp794xx_i2c_write(pHandle, u8Reg, (uint8_t *)ptimeBuffer, sizeof(ptimeBuffer));
+    if(err)
+    {
+        a_mcp794xx_print_error_msg(pHandle, "write alarm time and date");
+        return 1;
+    }
 
     return 0;     /**< success */
+}
+
+/**
+ * @brief This function set the alarm time and date
+ * @param[in] pHandle points to a mcp794xx handle structure
+ * @param[in] alarm is the alarm type (ALARM0/ALARM1)
+ * @param[in] pTime point to the alarm time to set
+ * @return status code
+ *          - 0 success
+ *          - 1 failed
+            - 2 handle null
+ *          - 3 handle is not initialized
+ *          - 4 invalid alarm or alarm time
+ * @note    The alarm registers are updated with one burst write.
+ */
+uint8_t mcp794xx_set_alarm_time_date(mcp794xx_handle_t *const pHandle, mcp794xx_alarm_t alarm, mcp794xx_time_t *pTime)
+{
+    if(pHandle == NULL)
+        return 2;     /**< return failed error */
+    if(pHandle->inited != 1)
+        return 3;      /**< return failed error */
+
+    err = a_mcp794xx_check_alarm_time(pHandle, pTime);
+    if(err)
+    {
+        return err;
+    }
 
+    return a_mcp794xx_write_alarm_regs(pHandle, alarm, pTime, 0x00, 0x00);     /**< keep the current alarm mask and polarity */
 }
 
 /**
@@ -1698,82 +2300,29 @@ uint8_t mcp794xx_set_alarm_time_date(mcp794xx_handle_t *const pHandle, mcp794xx_
  */
 uint8_t mcp794xx_set_alarm(mcp794xx_handle_t *const pHandle, mcp794xx_alarm_t alarm, mcp794xx_alarm_mask_t mask, mcp794xx_time_t *pTime)
 {
-    uint8_t read_status;
-
     if(pHandle == NULL)
         return 2;     /**< return failed error */
     if(pHandle->inited != 1)
         return 3;      /**< return failed error */
 
-    switch((int)alarm)
+    if((alarm != MCP794XX_ALARM0) && (alarm != MCP794XX_ALARM1))
     {
+        a_mcp794xx_print_error_msg(pHandle, "invalid alarm selected");
+        return 4;
+    }
 
-        case MCP794XX_ALARM0:
-        {
-            err = rtc_mcp794xx_i2c_read(pHandle, MCP794XX_ALM0_WKDAY_REG, (uint8_t *)&read_status, 1);
-            if(err)
-            {
-                a_mcp794xx_print_error_msg(pHandle, "read alarm 0 mask register");
-                return 1;           /**< failed error */
-            }
+    err = a_mcp794xx_check_alarm_time(pHandle, pTime);
+    if(err)
+    {
+        return err;
+    }
 
-            read_status &= ~(0b111 << 4);                           /**< clear alarm mask bit */
-            read_status |= (mask << 4);
-
-            err = rtc_mcp794xx_i2c_write(pHandle, MCP794XX_ALM0_WKDAY_REG, (uint8_t *)&read_status);
-            if(err)
-            {
-                a_mcp794xx_print_error_msg(pHandle, "read alarm 0 mask register");
-                return 1;           /**< failed error */
-            }
-
-            err = mcp794xx_set_alarm_time_date(pHandle, alarm, pTime);
-            if(err)
-            {
-                a_mcp794xx_print_error_msg(pHandle, "failed to set alarm 0");
-                return err;           /**< failed error */
-            }
-
-            break;
-        }
-
-        case MCP794XX_ALARM1:
-        {
-            err = rtc_mcp794xx_i2c_read(pHandle, MCP794XX_ALM1_WKDAY_REG, (uint8_t *)&read_status, 1);
-            if(err)
-            {
-                a_mcp794xx_print_error_msg(pHandle, "read alarm 1 mask register");
-                return 1;           /**< failed error */
-            }
-
-            read_status &= ~(0b111 << 4);                           /**< clear alarm mask bit */
-            read_status |= (mask << 4);
-
-            err = rtc_mcp794xx_i2c_write(pHandle, MCP794XX_ALM1_WKDAY_REG, (uint8_t *)&read_status);
-            if(err)
-            {
-                a_mcp794xx_print_error_msg(pHandle, "read alarm 1 mask register");
-                return 1;           /**< failed error */
-            }
-
-            err = mcp794xx_set_alarm_time_date(pHandle, alarm, pTime);
-            if(err)
-            {
-                a_mcp794xx_print_error_msg(pHandle, "failed to set alarm 1");
-                return err;           /**< failed error */
-            }
-
-            break;
-        }
-
-        default :
-        {
-            a_mcp794xx_print_error_msg(pHandle, "invalid alarm selected");
-            return 4;
-            break;
-        }
-
-    }
+    err = a_mcp794xx_write_alarm_regs(pHandle, alarm, pTime, MCP794XX_ALARMx_TYPE_MASK, (uint8_t)(mask << 4));     /**< mask and time in one burst */
+    if(err)
+    {
+        a_mcp794xx_print_error_msg(pHandle, "set alarm");
+        return err;           /**< failed error */
+    }
 
     return 0;              /**< success */
 
@@ -1876,7 +2425,7 @@ uint8_t mcp794xx_get_alarm(mcp794xx_handle_t *const pHandle, mcp794xx_alarm_t al
 
     if(alarm == MCP794XX_ALARM0)
     {
-        err = rtc_mcp794xx_i2c_read(pHandle, MCP794XX_ALM0_WKDAY_REG, (uint8_t *)&read_status, 1);
+        err = a_mcp794xx_reg_read(pHandle, MCP794XX_ALM0_WKDAY_REG, MCP794XX_ALARMx_TYPE_MASK, (uint8_t *)&read_status);
         if(err)
         {
             a_mcp794xx_print_error_msg(pHandle, "failed read alarm mask");
@@ -1885,7 +2434,7 @@ uint8_t mcp794xx_get_alarm(mcp794xx_handle_t *const pHandle, mcp794xx_alarm_t al
     }
     else if(alarm == MCP794XX_ALARM1)
     {
-        err = rtc_mcp794xx_i2c_read(pHandle, MCP794XX_ALM1_WKDAY_REG, (uint8_t *)&read_status, 1);
+        err = a_mcp794xx_reg_read(pHandle, MCP794XX_ALM1_WKDAY_REG, MCP794XX_ALARMx_TYPE_MASK, (uint8_t *)&read_status);
         if(err)
         {
             a_mcp794xx_print_error_msg(pHandle, "failed read alarm mask");
@@ -1927,7 +2476,7 @@ uint8_t mcp794xx_get_alarm_interrupt_flag(mcp794xx_handle_t *const pHandle, mcp7
 
     if(alarm == MCP794XX_ALARM0)
     {
-         err = rtc_mcp794xx_i2c_read(pHandle,MCP794XX_ALM0_WKDAY_REG, (uint8_t *)&read_status, 1);
+         err = a_mcp794xx_reg_read(pHandle, MCP794XX_ALM0_WKDAY_REG, MCP794XX_ALARMx_IF_MASK, (uint8_t *)&read_status);
         if(err)
         {
             a_mcp794xx_print_error_msg(pHandle, "failed to read alarm 0 interrupt flag");
@@ -1939,7 +2488,7 @@ uint8_t mcp794xx_get_alarm_interrupt_flag(mcp794xx_handle_t *const pHandle, mcp7
 
     else if(alarm == MCP794XX_ALARM1)
     {
-        err = rtc_mcp794xx_i2c_read(pHandle,MCP794XX_ALM1_WKDAY_REG, (uint8_t *)&read_status, 1);
+        err = a_mcp794xx_reg_read(pHandle, MCP794XX_ALM1_WKDAY_REG, MCP794XX_ALARMx_IF_MASK, (uint8_t *)&read_status);
         if(err)
         {
             a_mcp794xx_print_error_msg(pHandle, "failed to read alarm 1 interrupt flag");
@@ -1971,8 +2520,6 @@ uint8_t mcp794xx_get_alarm_interrupt_flag(mcp794xx_handle_t *const pHandle, mcp7
  */
 uint8_t mcp794xx_clr_alarm_interrupt_flag(mcp794xx_handle_t *const pHandle, mcp794xx_alarm_t alarm)
 {
-    uint8_t read_status;
-
     if(pHandle == NULL)
         return 2;     /**< return failed error */
     if(pHandle->inited != 1)
@@ -1980,41 +2527,22 @@ uint8_t mcp794xx_clr_alarm_interrupt_flag(mcp794xx_handle_t *const pHandle, mcp7
 
     if(alarm == MCP794XX_ALARM0)
     {
-        err = rtc_mcp794xx_i2c_read(pHandle, MCP794XX_ALM0_WKDAY_REG, (uint8_t *)&read_status, 1);
-        if(err)
-        {
-            a_mcp794xx_print_error_msg(pHandle, "read alarm 0 interrupt flag register");
-            return 1;           /**< failed error */
-        }
-
-        read_status &= ~(1 << 3);
-        err = rtc_mcp794xx_i2c_write(pHandle, MCP794XX_ALM0_WKDAY_REG, (uint8_t *)&read_status);
+        err = a_mcp794xx_reg_update(pHandle, MCP794XX_ALM0_WKDAY_REG, MCP794XX_ALARMx_IF_MASK, 0);
         if(err)
         {
             a_mcp794xx_print_error_msg(pHandle, "clear alarm 0 interrupt flag bit");
             return 1;           /**< failed error */
         }
-
     }
     else if(alarm == MCP794XX_ALARM1)
     {
-
-        err = rtc_mcp794xx_i2c_read(pHandle, MCP794XX_ALM1_WKDAY_REG, (uint8_t *)&read_status, 1);
-        if(err)
-        {
-            a_mcp794xx_print_error_msg(pHandle, "read alarm 1 interrupt flag register");
-            return 1;           /**< failed error */
-        }
-
-        read_status &= ~(1 << 3);
-        err = rtc_mcp794xx_i2c_write(pHandle, MCP794XX_ALM1_WKDAY_REG, (uint8_t *)&read_status);
+        err = a_mcp794xx_reg_update(pHandle, MCP794XX_ALM1_WKDAY_REG, MCP794XX_ALARMx_IF_MASK, 0);
         if(err)
         {
             a_mcp794xx_print_error_msg(pHandle, "clear alarm 1 interrupt flag bit");
             return 1;           /**< failed error */
         }
     }
-
     else
     {
 
@@ -2037,24 +2565,12 @@ uint8_t mcp794xx_clr_alarm_interrupt_flag(mcp794xx_handle_t *const pHandle, mcp7
  */
 uint8_t mcp794xx_set_mfp_logic_level(mcp794xx_handle_t *const pHandle, mcp794xx_mfp_logic_level_t logicLevel)
 {
-    uint8_t read_status;
-
     if(pHandle == NULL)
         return 2;     /**< return failed error */
     if(pHandle->inited != 1)
         return 3;      /**< return failed error */
 
-    err = rtc_mcp794xx_i2c_read(pHandle, MCP794XX_CONTROL_REG, (uint8_t *)&read_status, 1);
-    if(err)
-    {
-        a_mcp794xx_print_error_msg(pHandle, "read ctrl register");
-        return 1;           /**< failed error */
-    }
-
-    read_status &= ~(1 << 7);
-    read_status |= (logicLevel << 7);
-
-    err = rtc_mcp794xx_i2c_write(pHandle, MCP794XX_CONTROL_REG, (uint8_t *)&read_status);
+    err = a_mcp794xx_reg_update(pHandle, MCP794XX_CONTROL_REG, MCP794XX_CTRL_OUT_MASK, (uint8_t)(logicLevel << 7));
     if(err)
     {
         a_mcp794xx_print_error_msg(pHandle, "write ctrl register");
@@ -2084,7 +2600,7 @@ uint8_t mcp794xx_get_mfp_logic_level(mcp794xx_handle_t *const pHandle, mcp794xx_
     if(pHandle->inited != 1)
         return 3;      /**< return failed error */
 
-    err = rtc_mcp794xx_i2c_read(pHandle, MCP794XX_CONTROL_REG, (uint8_t *)&read_status, 1);
+    err = a_mcp794xx_reg_read(pHandle, MCP794XX_CONTROL_REG, MCP794XX_CTRL_OUT_MASK, (uint8_t *)&read_status);
     if(err)
     {
         a_mcp794xx_print_error_msg(pHandle, "read ctrl register");
@@ -2109,24 +2625,12 @@ uint8_t mcp794xx_get_mfp_logic_level(mcp794xx_handle_t *const pHandle, mcp794xx_
  */
 uint8_t mcp94xx_set_sqr_wave_output_freq(mcp794xx_handle_t *const pHandle, mcp94xx_sqr_wave_freq_t freq)
 {
-    uint8_t read_status;
-
     if(pHandle == NULL)
         return 2;     /**< return failed error */
     if(pHandle->inited != 1)
         return 3;      /**< return failed error */
 
-    err = rtc_mcp794xx_i2c_read(pHandle, MCP794XX_CONTROL_REG, (uint8_t *)&read_status, 1);
-    if(err)
-    {
-        a_mcp794xx_print_error_msg(pHandle, "read ctrl register");
-        return 1;           /**< failed error */
-    }
-
-    read_status &= ~ (0b11 << 0);
-    read_status |= (freq << 0);
-
-    err = rtc_mcp794xx_i2c_write(pHandle, MCP794XX_CONTROL_REG, (uint8_t *)&read_status);
+    err = a_mcp794xx_reg_update(pHandle, MCP794XX_CONTROL_REG, MCP794XX_CTRL_SQR_WAVE_FREQ_SELEC_MASK, (uint8_t)freq);
     if(err)
     {
         a_mcp794xx_print_error_msg(pHandle, "write ctrl register");
@@ -2156,7 +2660,7 @@ uint8_t mcp94xx_get_sqr_wave_freq(mcp794xx_handle_t *const pHandle, mcp94xx_sqr_
     if(pHandle->inited != 1)
         return 3;      /**< return failed error */
 
-    err = rtc_mcp794xx_i2c_read(pHandle, MCP794XX_CONTROL_REG, (uint8_t *)&read_status, 1);
+    err = a_mcp794xx_reg_read(pHandle, MCP794XX_CONTROL_REG, MCP794XX_CTRL_SQR_WAVE_FREQ_SELEC_MASK, (uint8_t *)&read_status);
     if(err)
     {
         a_mcp794xx_print_error_msg(pHandle, "read ctrl register");
@@ -2180,31 +2684,19 @@ uint8_t mcp94xx_get_sqr_wave_freq(mcp794xx_handle_t *const pHandle, mcp94xx_sqr_
  */
 uint8_t mcp794xx_set_sqr_wave_enable_status(mcp794xx_handle_t *const pHandle, mcp794xx_bool_t enable)
 {
-    uint8_t read_status;
-
     if(pHandle == NULL)
         return 2;     /**< return failed error */
     if(pHandle->inited != 1)
         return 3;      /**< return failed error */
 
-    err = rtc_mcp794xx_i2c_read(pHandle, MCP794XX_CONTROL_REG, (uint8_t *)&read_status, 1);
-    if(err)
-    {
-        a_mcp794xx_print_error_msg(pHandle, "read ctrl register");
-        return 1;           /**< failed error */
-    }
-
-    read_status &= ~ (1 << 6);
-    read_status |= (enable << 6);
-
-    err = rtc_mcp794xx_i2c_write(pHandle, MCP794XX_CONTROL_REG, (uint8_t *)&read_status);
+    err = a_mcp794xx_reg_update(pHandle, MCP794XX_CONTROL_REG, MCP794XX_CTRL_SQR_WAVE_EN_MASK, (uint8_t)(enable << 6));
     if(err)
     {
         a_mcp794xx_print_error_msg(pHandle, "write ctrl register");
         return 1;           /**< failed error */
     }
 
-    return 0;           /**< success */
+    return 0;              /**< success */
 }
 
 /**
@@ -2226,7 +2718,7 @@ uint8_t mcp794xx_get_sqr_wave_enable_status(mcp794xx_handle_t *const pHandle, mc
     if(pHandle->inited != 1)
         return 3;      /**< return failed error */
 
-    err = rtc_mcp794xx_i2c_read(pHandle, MCP794XX_CONTROL_REG, (uint8_t *)&read_status, 1);
+    err = a_mcp794xx_reg_read(pHandle, MCP794XX_CONTROL_REG, MCP794XX_CTRL_SQR_WAVE_EN_MASK, (uint8_t *)&read_status);
     if(err)
     {
         a_mcp794xx_print_error_msg(pHandle, "read ctrl register");
@@ -2251,32 +2743,19 @@ uint8_t mcp794xx_get_sqr_wave_enable_status(mcp794xx_handle_t *const pHandle, mc
  */
 uint8_t mcp794xx_set_trim_val(mcp794xx_handle_t *const pHandle, mcp794xx_trim_sign_t sign, mcp794xx_trim_val_t value)
 {
-    uint8_t read_status;
-
     if(pHandle == NULL)
         return 2;     /**< return failed error */
     if(pHandle->inited != 1)
         return 3;      /**< return failed error */
 
-    err = rtc_mcp794xx_i2c_read(pHandle, MCP794XX_OSC_TRIM_REG, (uint8_t *)&read_status, 1);
-    if(err)
-    {
-        a_mcp794xx_print_error_msg(pHandle, "read oscillator digital trim register");
-        return 1;           /**< failed error */
-    }
-
-    read_status &=  0x00;            /**< clear trim clock value */
-    read_status |= (value << 0);     /**< set trim value */
-    read_status |= (sign << 7);      /**< set trim sign */
-
-    err = rtc_mcp794xx_i2c_write(pHandle, MCP794XX_OSC_TRIM_REG, (uint8_t *)&read_status);
+    err = a_mcp794xx_reg_update(pHandle, MCP794XX_OSC_TRIM_REG, 0xFF, (uint8_t)((sign << 7) | (value & MCP794XX_TRIM_VAL_MASK)));
     if(err)
     {
         a_mcp794xx_print_error_msg(pHandle, "write oscillator digital trim register");
         return 1;           /**< failed error */
     }
 
-    return 0;           /**< success */
+    return 0;              /**< success */
 }
 
 /**
@@ -2299,7 +2778,7 @@ uint8_t mcp794xx_get_trim_val(mcp794xx_handle_t *const pHandle, mcp794xx_trim_si
     if(pHandle->inited != 1)
         return 3;      /**< return failed error */
 
-    err = rtc_mcp794xx_i2c_read(pHandle, MCP794XX_OSC_TRIM_REG, (uint8_t *)&read_status, 1);
+    err = a_mcp794xx_reg_read(pHandle, MCP794XX_OSC_TRIM_REG, 0xFF, (uint8_t *)&read_status);
     if(err)
     {
         a_mcp794xx_print_error_msg(pHandle, "read oscillator digital trim register");
@@ -2325,32 +2804,19 @@ uint8_t mcp794xx_get_trim_val(mcp794xx_handle_t *const pHandle, mcp794xx_trim_si
  */
 uint8_t mcp794xx_set_coarse_trim_mode_status(mcp794xx_handle_t *const pHandle, mcp794xx_bool_t status)
 {
-
-    uint8_t read_status;
-
     if(pHandle == NULL)
         return 2;     /**< return failed error */
     if(pHandle->inited != 1)
         return 3;      /**< return failed error */
 
-    err = rtc_mcp794xx_i2c_read(pHandle, MCP794XX_CONTROL_REG, (uint8_t *)&read_status, 1);
-    if(err)
-    {
-        a_mcp794xx_print_error_msg(pHandle, "read ctrl register");
-        return 1;           /**< failed error */
-    }
-
-    read_status &= ~ (1 << 2);
-    read_status |= (status << 2);
-
-    err = rtc_mcp794xx_i2c_write(pHandle, MCP794XX_CONTROL_REG, (uint8_t *)&read_status);
+    err = a_mcp794xx_reg_update(pHandle, MCP794XX_CONTROL_REG, MCP794XX_CTRL_CRS_TRIM_EN_MASK, (uint8_t)(status << 2));
     if(err)
     {
         a_mcp794xx_print_error_msg(pHandle, "write ctrl register");
         return 1;           /**< failed error */
     }
 
-    return 0;           /**< success */
+    return 0;              /**< success */
 }
 
 /**
@@ -2373,7 +2839,7 @@ uint8_t mcp794xx_get_coarse_trim_mode_status(mcp794xx_handle_t *const pHandle, m
     if(pHandle->inited != 1)
         return 3;      /**< return failed error */
 
-    err = rtc_mcp794xx_i2c_read(pHandle, MCP794XX_CONTROL_REG, (uint8_t *)&read_status, 1);
+    err = a_mcp794xx_reg_read(pHandle, MCP794XX_CONTROL_REG, MCP794XX_CTRL_CRS_TRIM_EN_MASK, (uint8_t *)&read_status);
     if(err)
     {
         a_mcp794xx_print_error_msg(pHandle, "read ctrl register");
@@ -2404,7 +2870,7 @@ uint8_t mcp794xx_get_os_running_status(mcp794xx_handle_t *const pHandle, mcp794x
     if(pHandle->inited != 1)
         return 3;      /**< return failed error */
 
-    err = rtc_mcp794xx_i2c_read(pHandle, MCP794XX_RTC_WKDAY_REG, (uint8_t *)&read_status, 1);
+    err = a_mcp794xx_reg_read(pHandle, MCP794XX_RTC_WKDAY_REG, MCP794XX_OSC_RUN_STATUS_MASK, (uint8_t *)&read_status);
     if(err)
     {
         a_mcp794xx_print_error_msg(pHandle, "read oscillator running status");
@@ -2429,9 +2895,6 @@ uint8_t mcp794xx_get_os_running_status(mcp794xx_handle_t *const pHandle, mcp794x
  */
 uint8_t  mcp794xx_set_ext_batt_enable_status(mcp794xx_handle_t *const pHandle, mcp794xx_bool_t status)
 {
-
-    uint8_t read_status;
-
     if(pHandle == NULL)
         return 2;     /**< return failed error */
     if(pHandle->inited != 1)
@@ -2442,24 +2905,14 @@ uint8_t  mcp794xx_set_ext_batt_enable_status(mcp794xx_handle_t *const pHandle, m
         return 4;
     }
 
-    err = rtc_mcp794xx_i2c_read(pHandle, MCP794XX_RTC_WKDAY_REG, (uint8_t *)&read_status, 1);
-    if(err)
-    {
-        a_mcp794xx_print_error_msg(pHandle, "set external battery bckup");
-        return 1;           /**< failed error */
-    }
-
-    read_status &= ~ (1 << 3);
-    read_status |= (status << 3);
-
-    err = rtc_mcp794xx_i2c_write(pHandle, MCP794XX_RTC_WKDAY_REG, (uint8_t *)&read_status);
+    err = a_mcp794xx_reg_update(pHandle, MCP794XX_RTC_WKDAY_REG, MCP794XX_VBAT_EN_MASK, (uint8_t)(status << 3));
     if(err)
     {
         a_mcp794xx_print_error_msg(pHandle, "set external battery bckup status");
         return 1;           /**< failed error */
     }
 
-    return 0;           /**< success */
+    return 0;              /**< success */
 }
 
 /**
@@ -2482,7 +2935,7 @@ uint8_t  mcp794xx_get_ext_batt_enable_status(mcp794xx_handle_t *const pHandle, m
     if(pHandle->inited != 1)
         return 3;      /**< return failed error */
 
-    err = rtc_mcp794xx_i2c_read(pHandle, MCP794XX_RTC_WKDAY_REG, (uint8_t *)&read_status, 1);
+    err = a_mcp794xx_reg_read(pHandle, MCP794XX_RTC_WKDAY_REG, MCP794XX_VBAT_EN_MASK, (uint8_t *)&read_status);
     if(err)
     {
         a_mcp794xx_print_error_msg(pHandle, "read external battery bckup status");
@@ -2506,32 +2959,19 @@ uint8_t  mcp794xx_get_ext_batt_enable_status(mcp794xx_handle_t *const pHandle, m
  */
 uint8_t mcp794xx_set_ext_osc_enable_status(mcp794xx_handle_t *const pHandle, mcp794xx_osc_status_t status)
 {
-
-    uint8_t read_status;
-
     if(pHandle == NULL)
         return 2;     /**< return failed error */
     if(pHandle->inited != 1)
         return 3;      /**< return failed error */
 
-    err = rtc_mcp794xx_i2c_read(pHandle, MCP794XX_CONTROL_REG, (uint8_t *)&read_status, 1);
-    if(err)
-    {
-        a_mcp794xx_print_error_msg(pHandle, "set external oscillator");
-        return 1;           /**< failed error */
-    }
-
-    read_status &= ~ (1 << 3);
-    read_status |= (status << 3);
-
-    err = rtc_mcp794xx_i2c_write(pHandle, MCP794XX_CONTROL_REG, (uint8_t *)&read_status);
+    err = a_mcp794xx_reg_update(pHandle, MCP794XX_CONTROL_REG, MCP794XX_CTRL_EXTR_OSC_EN_MASK, (uint8_t)(status << 3));
     if(err)
     {
         a_mcp794xx_print_error_msg(pHandle, "set external oscillator");
         return 1;           /**< failed error */
     }
 
-    return 0;           /**< success */
+    return 0;              /**< success */
 }
 
 /**
@@ -2553,14 +2993,14 @@ uint8_t mcp794xx_get_ext_osc_enable_status(mcp794xx_handle_t *const pHandle, mcp
     if(pHandle->inited != 1)
         return 3;      /**< return failed error */
 
-    err = rtc_mcp794xx_i2c_read(pHandle, MCP794XX_CONTROL_REG, (uint8_t *)&read_status, 1);
+    err = a_mcp794xx_reg_read(pHandle, MCP794XX_CONTROL_REG, MCP794XX_CTRL_EXTR_OSC_EN_MASK, (uint8_t *)&read_status);
     if(err)
     {
         a_mcp794xx_print_error_msg(pHandle, "read oscillator status bit");
         return 1;           /**< failed error */
     }
 
-    *pStatus = (mcp794xx_osc_status_t)((read_status & MCP794XX_VBAT_EN_MASK) >> 3);
+    *pStatus = (mcp794xx_osc_status_t)((read_status & MCP794XX_CTRL_EXTR_OSC_EN_MASK) >> 3);
 
     return 0;              /**< success */
 }
@@ -2595,7 +3035,7 @@ uint8_t mcp794xx_set_osc_start_bit(mcp794xx_handle_t *const pHandle, mcp794xx_bo
     read_status &= ~ (1 << 7);
     read_status |= (status << 7);
 
-    err = rtc_mcp794xx_i2c_write(pHandle, MCP794XX_RTC_SECOND_REG, (uint8_t *)&read_status);
+    err = rtc_mcp794xx_i2c_write(pHandle, MCP794XX_RTC_SECOND_REG, (uint8_t *)&read_status, 1);
     if(err)
     {
         a_mcp794xx_print_error_msg(pHandle, "set osc start bit");
@@ -2638,743 +3078,4489 @@ uint8_t mcp794xx_get_osc_start_bit(mcp794xx_handle_t *const pHandle, mcp794xx_bo
 }
 
 /**
- * @brief     This function read the current time in epoch/unix format
+ * @brief     This function enables/disables the configuration register shadow
  * @param[in] *pHandle points to mcp794xx pHandle structure
- * @param[in] pTime point to the current time in human readable format
- * @param[out] pEpoch_time point to the epoch time converted
+ * @param[in] status is the enable boolean status
  * @return  status code
  *            - 0 success
- *            - 1 failed
+ *            - 1 failed to write pending registers
  *            - 2 pHandle is NULL
  *            - 3 pHandle is not initialized
- * @note      This function will fail to execute from January 19, 2038
+ *            - 4 configuration transaction in progress
+ * @note      - When enabled, CONTROL, OSCTRIM, the VBATEN bit of RTCWKDAY and the ALMxWKDAY configuration bits
+ *              are kept in RAM. Setters skip the read of a read-modify-write and getters of static fields are
+ *              served from RAM once the register was seen on the bus.
+ *            - Disabling writes any pending register, then drops the shadow content.
  */
-uint8_t mcp794xx_read_epoch_unix_time_stamp(mcp794xx_handle_t *const pHandle, mcp794xx_time_t *pTime, uint32_t *pEpoch_time)
+uint8_t mcp794xx_set_shadow_enable_status(mcp794xx_handle_t *const pHandle, mcp794xx_bool_t status)
 {
-	 uint8_t num_years,num_months,num_days = 0;
-     uint32_t total_days_from_years = 0;
-     uint32_t total_days_from_months = 0;
-     uint32_t total_num_days = 0;
-	 int index;
-
     if(pHandle == NULL)
         return 2;     /**< return failed error */
     if(pHandle->inited != 1)
         return 3;      /**< return failed error */
 
-    num_years = pTime->year - 1970;   /**< number years since 1970*/
-    num_months = pTime->month - 1;    /**< number of months from January */
-    num_days = pTime->date - 1;		  /**< number of days since the 1st of the current month*/
-
-    for(index = 0; index < num_years; index++)
+    if(pHandle->shadow.txn == 1)
     {
-    	if(index % 4)
-    	{
-    		total_days_from_years += 365;
-    	}else
-    	{
-    		total_days_from_years += 366;
-    	}
+        a_mcp794xx_print_error_msg(pHandle, "set shadow status, transaction in progress");
+        return 4;
     }
 
-    for(index = 0; index < num_months; index++)
+    if((status == MCP794XX_BOOL_FALSE) && (pHandle->shadow.enable == 1))
     {
-       total_days_from_months += days_in_month[index];
+        err = a_mcp794xx_shadow_flush(pHandle);
+        if(err)
+        {
+            a_mcp794xx_print_error_msg(pHandle, "disable shadow");
+            return 1;           /**< failed error */
+        }
     }
 
-    total_num_days = (total_days_from_years + total_days_from_months + num_days) - 1;                           /**< calculate total number of days since 1 January 1970 */
+    pHandle->shadow.valid = 0;
+    pHandle->shadow.dirty = 0;
+    pHandle->shadow.enable = (status == MCP794XX_BOOL_FALSE) ? 0 : 1;
 
-    *pEpoch_time = (total_num_days * 86400) + (pTime->hour * 3600) + (pTime->minute * 60) + pTime->second;      /**< calculate number of seconds from current time and date */
-
-	return 0;   /**< success */
+    return 0;              /**< success */
 }
 
-
 /**
- * @brief  This function convert epoch time to human readable time format
- * @param[in]  pHandle points to a mcp794xx handle structure
- * @param[in] epoch_unix_time point to the epoch time converted
- * @param[out] pTime point to time output in human readable time
+ * @brief     This function get the configuration register shadow enable status
+ * @param[in] *pHandle points to mcp794xx pHandle structure
+ * @param[out] pStatus point to the boolean status
  * @return  status code
  *            - 0 success
- *            - 1 failed to get
  *            - 2 pHandle is NULL
  *            - 3 pHandle is not initialized
- * @note      This function will fail to execute from January 19, 2038
+ * @note      none
  */
-uint8_t mcp794xx_convert_epoch_unix_time_stamp(mcp794xx_handle_t *const pHandle, uint32_t u32Epoch_time, mcp794xx_time_t *pTime_out)
+uint8_t mcp794xx_get_shadow_enable_status(mcp794xx_handle_t *const pHandle, mcp794xx_bool_t *pStatus)
 {
-    uint32_t sec_of_day;
-    uint16_t num_days;
-
-	if(pHandle == NULL)
-	return 2;     /**< return failed error */
-	if(pHandle->inited != 1)
-	return 3;      /**< return failed error */
-
-	u32Epoch_time += (pTime_out->local_time_zone * 3600);        /**< add time zone hours offset */
-
-	/**< get hour, minute and seconds */
-    sec_of_day = u32Epoch_time % (24 * 60 * 60);
-
-    pTime_out->hour       = sec_of_day / (60 * 60);
-    pTime_out->minute     = sec_of_day % (60 * 60) / 60;
-    pTime_out->second     = u32Epoch_time % 60;
+    if(pHandle == NULL)
+        return 2;     /**< return failed error */
+    if(pHandle->inited != 1)
+        return 3;      /**< return failed error */
 
-    /**< get years */
-    num_days = (u32Epoch_time - SECONDS_FROM_Y1970_TO_Y2000) / 86400;
+    *pStatus = (pHandle->shadow.enable == 1) ? MCP794XX_BOOL_TRUE : MCP794XX_BOOL_FALSE;
 
-    num_days += 1401;           			/**< move starting point to 1996-03-01 */
-    pTime_out->year = (num_days/1461)*4;    /**< take care of 4-year intervals */
-    num_days%=1461; 						/**< max 3 years 365 days (not 4 years!) remaining */
+    return 0;              /**< success */
+}
 
-    if (num_days>=730) {num_days-=730; pTime_out->year+=2;} /**< 2 years */
-    if (num_days>=365) {num_days-=365; pTime_out->year++;}  /**< 1 year */
+/**
+ * @brief     This function synchronizes the shadow with the chip
+ * @param[in] *pHandle points to mcp794xx pHandle structure
+ * @return  status code
+ *            - 0 success
+ *            - 1 failed
+ *            - 2 pHandle is NULL
+ *            - 3 pHandle is not initialized
+ *            - 4 shadow is disabled
+ * @note      Pending registers are written first, then RTCWKDAY..ALM1WKDAY are reloaded with one burst read.
+ *            Call it after the registers were changed behind the driver (another bus master, power loss).
+ */
+uint8_t mcp794xx_shadow_sync(mcp794xx_handle_t *const pHandle)
+{
+    if(pHandle == NULL)
+        return 2;     /**< return failed error */
+    if(pHandle->inited != 1)
+        return 3;      /**< return failed error */
 
-    /**< get months */
-    pTime_out->month = 3; 									/**< get started on the month */
+    if(pHandle->shadow.enable != 1)
+    {
+        a_mcp794xx_print_error_msg(pHandle, "sync shadow, shadow is disabled");
+        return 4;
+    }
 
-    if (num_days>=306) {num_days-=306; pTime_out->year++; pTime_out->month=1;}  /**< for Jan. and Feb. */
-    else if (num_days>=153) {num_days-=153; pTime_out->month=8;} 				/**< for Aug. thru Dec. */
-    if (num_days>=122) {num_days-=122; pTime_out->month+=4;} 					/**< here, 122 days mean 4 months */
-    else if (num_days>=61) {num_days-=61; pTime_out->month+=2;} 				/**< 61 days mean 2 months */
-    if (num_days>=31) {num_days-=31; pTime_out->month++;} 						/**< 31 days means exactly 1 month */
+    err = a_mcp794xx_shadow_flush(pHandle);
+    if(err)
+    {
+        a_mcp794xx_print_error_msg(pHandle, "sync shadow");
+        return 1;           /**< failed error */
+    }
 
-    pTime_out->date = num_days + 1; 											/**< get the day of the month */
+    err = a_mcp794xx_shadow_load(pHandle);
+    if(err)
+    {
+        a_mcp794xx_print_error_msg(pHandle, "sync shadow");
+        return 1;           /**< failed error */
+    }
 
-    pTime_out->year+=(2000 - 4); 												/**< make y be 0 for AD 2000 */
+    return 0;              /**< success */
+}
 
-    /**< get weekdays */
-    pTime_out->weekDay = ((pTime_out->date + ((153 * (pTime_out->month + 12 * ((14 - pTime_out->month) / 12) - 3) + 2) / 5)
-               + (365 * (pTime_out->year + 4800 - ((14 - pTime_out->month) / 12)))
-               + ((pTime_out->year + 4800 - ((14 - pTime_out->month) / 12)) / 4)
-               - ((pTime_out->year + 4800 - ((14 - pTime_out->month) / 12)) / 100)
-               + ((pTime_out->year + 4800 - ((14 - pTime_out->month) / 12)) / 400)
-               - 32045)
-        % 7) + 2;
+/**
+ * @brief     This function invalidates the shadow content
+ * @param[in] *pHandle points to mcp794xx pHandle structure
+ * @return  status code
+ *            - 0 success
+ *            - 2 pHandle is NULL
+ *            - 3 pHandle is not initialized
+ * @note      Pending registers are discarded, the next access of each register goes to the bus.
+ */
+uint8_t mcp794xx_shadow_invalidate(mcp794xx_handle_t *const pHandle)
+{
+    if(pHandle == NULL)
+        return 2;     /**< return failed error */
+    if(pHandle->inited != 1)
+        return 3;      /**< return failed error */
 
-//	struct tm *time = localtime((const time_t *)&u32Epoch_time);          /**< built-in function from time.h library */
-//
-//	{ /** copy time structure members */
-//		pTime_out->year    = time->tm_year + 1900;
-//		pTime_out->month   = time->tm_mon + 1;
-//		pTime_out->date    = time->tm_mday;
-//		pTime_out->weekDay = time->tm_wday + 1;
-//		pTime_out->hour    = time->tm_hour;
-//		pTime_out->minute  = time->tm_min;
-//		pTime_out->second  = time->tm_sec;
-//	}
-//
-//	if (time == NULL)
-//	{
-//		a_mcp794xx_print_error_msg(pHandle, "convert epoch time to human readable time");
-//		return 1;						/**< failed */
-//	}
+    pHandle->shadow.valid = 0;
+    pHandle->shadow.dirty = 0;
 
-    return 0;							/**< success */
+    return 0;              /**< success */
 }
 
 /**
- * @brief      This function reads the compile time and date of the application
- * @param[in]  pHandle points to a mcp794xx handle structure
- * @param[in]  Compile_time_date compile time and date string variable (__TIMESTAMP__)
- * @param[out] pTime points to a time structure object
- * @return     status code
- *             - 0 success
- *             - 1 failed
- *             - 2 handle or time is NULL
- *             - 3 handle is not initialized
- * @note       this function returns time in 24Hr format
+ * @brief     This function starts a configuration transaction
+ * @param[in] *pHandle points to mcp794xx pHandle structure
+ * @return  status code
+ *            - 0 success
+ *            - 1 failed to load the shadow
+ *            - 2 pHandle is NULL
+ *            - 3 pHandle is not initialized
+ *            - 4 transaction already in progress
+ * @note      - The shadow is enabled for the transaction and loaded with one burst read when needed.
+ *            - Until mcp794xx_txn_commit, the CONTROL, OSCTRIM and ALMxWKDAY setters only change the shadow.
+ *              Getters return the pending values.
+ *            - Setters needing volatile bits (RTCWKDAY) and registers outside the shadow are still written at once.
  */
-uint8_t mcp794xx_get_compile_time_date(mcp794xx_handle_t *const pHandle, char *pCompile_time, char *pCompile_date,  mcp794xx_time_t *pTime)
+uint8_t mcp794xx_txn_begin(mcp794xx_handle_t *const pHandle)
 {
-    char year_string[3], month_string[3], date_string[3], /* week_day_string[1],*/ hour_string[3], minute_string[3], second_string[3];
-    uint32_t epoch_time;
-    uint8_t sec_offset = 15;      /**< this is an offset time to compensate lost seconds during compiling and programming the device,
-    									purely depends on how fast your computer does the job */
-
     if(pHandle == NULL)
         return 2;     /**< return failed error */
     if(pHandle->inited != 1)
         return 3;      /**< return failed error */
 
-    year_string[0] = BUILD_YEAR_CH2(pCompile_date);
-    year_string[1] = BUILD_YEAR_CH3(pCompile_date);
+    if(pHandle->shadow.txn == 1)
+    {
+        a_mcp794xx_print_error_msg(pHandle, "begin transaction, transaction in progress");
+        return 4;
+    }
 
-    month_string[0] = BUILD_MONTH_CH0(pCompile_date);
-    month_string[1] = BUILD_MONTH_CH1(pCompile_date);
+    pHandle->shadow.txn_prev_enable = pHandle->shadow.enable;
+    if(pHandle->shadow.enable != 1)
+    {
+        pHandle->shadow.valid = 0;
+        pHandle->shadow.dirty = 0;
+        pHandle->shadow.enable = 1;
+    }
 
-    date_string[0] = BUILD_DATE_CH0(pCompile_date);
-    date_string[1] = BUILD_DATE_CH1(pCompile_date);
+    if((pHandle->shadow.valid & MCP794XX_SHADOW_CACHED_REGS) != MCP794XX_SHADOW_CACHED_REGS)
+    {
+        err = a_mcp794xx_shadow_load(pHandle);
+        if(err)
+        {
+            pHandle->shadow.enable = pHandle->shadow.txn_prev_enable;
+            a_mcp794xx_print_error_msg(pHandle, "begin transaction");
+            return 1;           /**< failed error */
+        }
+    }
 
-    hour_string[0] = BUILD_HOUR_CH0(pCompile_time);
-    hour_string[1] = BUILD_HOUR_CH1(pCompile_time);
+    pHandle->shadow.txn = 1;
 
-    minute_string[0] = BUILD_MIN_CH0(pCompile_time);
-    minute_string[1] = BUILD_MIN_CH1(pCompile_time);
+    return 0;              /**< success */
+}
 
-    second_string[0] = BUILD_SEC_CH0(pCompile_time);
-    second_string[1] = BUILD_SEC_CH1(pCompile_time);
+/**
+ * @brief     This function commits a configuration transaction
+ * @param[in] *pHandle points to mcp794xx pHandle structure
+ * @return  status code
+ *            - 0 success
+ *            - 1 failed to write, the transaction stays open
+ *            - 2 pHandle is NULL
+ *            - 3 pHandle is not initialized
+ *            - 4 no transaction in progress
+ * @note      Each run of consecutive changed registers is written with one burst
+ *            (CONTROL and OSCTRIM share one burst). The shadow enable status is then restored.
+ */
+uint8_t mcp794xx_txn_commit(mcp794xx_handle_t *const pHandle)
+{
+    if(pHandle == NULL)
+        return 2;     /**< return failed error */
+    if(pHandle->inited != 1)
+        return 3;      /**< return failed error */
 
-    //week_day_string[0] = BUILD_WEEK_DAY_CH(pCompile_time_date);
+    if(pHandle->shadow.txn != 1)
+    {
+        a_mcp794xx_print_error_msg(pHandle, "commit transaction, no transaction in progress");
+        return 4;
+    }
 
-    pTime->year = atoi((const char *)year_string);
-    pTime->month = atoi((const char *) month_string);
-    pTime->date = atoi((const char *) date_string);
-    //pTime->weekDay = atoi((const char *) week_day_string);
-    pTime->hour = atoi((const char *) hour_string);
-    pTime->minute = atoi((const char *) minute_string);
-    pTime->second = atoi((const char *) second_string);
+    err = a_mcp794xx_shadow_flush(pHandle);
+    if(err)
+    {
+        a_mcp794xx_print_error_msg(pHandle, "commit transaction");
+        return 1;           /**< failed error */
+    }
 
-	pTime->year = pTime->year + 2000;
-	//pHandle->debug_print("year:%d \n",pTime->year);
-	//pHandle->debug_print("month:%d \n",pTime->month);
-	//pHandle->debug_print("date:%d \n",pTime->date);
-	//pHandle->debug_print("hour:%d \n",pTime->hour);
-	//pHandle->debug_print("minute:%d \n",pTime->minute);
-	//pHandle->debug_print("sec:%d \n",pTime->second);
-	//pHandle->debug_print("weekday:%d \n",pTime->weekDay);
+    pHandle->shadow.txn = 0;
+    if(pHandle->shadow.txn_prev_enable != 1)
+    {
+        pHandle->shadow.enable = 0;
+        pHandle->shadow.valid = 0;
+    }
 
-	mcp794xx_read_epoch_unix_time_stamp(pHandle, pTime, (uint32_t *)&epoch_time);
-	mcp794xx_convert_epoch_unix_time_stamp(pHandle, epoch_time, pTime);
+    return 0;              /**< success */
+}
 
-	pTime->year = pTime->year - 2000;
+/**
+ * @brief     This function drops a configuration transaction
+ * @param[in] *pHandle points to mcp794xx pHandle structure
+ * @return  status code
+ *            - 0 success
+ *            - 2 pHandle is NULL
+ *            - 3 pHandle is not initialized
+ *            - 4 no transaction in progress
+ * @note      Pending changes are discarded and the shadow is invalidated.
+ */
+uint8_t mcp794xx_txn_abort(mcp794xx_handle_t *const pHandle)
+{
+    if(pHandle == NULL)
+        return 2;     /**< return failed error */
+    if(pHandle->inited != 1)
+        return 3;      /**< return failed error */
 
-	if(pTime->second < 45){
-		pTime->second += sec_offset;
-		}else{
-		pTime->second = (pTime->second + sec_offset) - 60;
-		if(pTime->minute < 58){
-			pTime->minute += 1;
-			}else{
-			pTime->hour += 1;
-			pTime->minute = 0;
-		}
-	}
+    if(pHandle->shadow.txn != 1)
+    {
+        a_mcp794xx_print_error_msg(pHandle, "abort transaction, no transaction in progress");
+        return 4;
+    }
 
-    return 0;
+    pHandle->shadow.txn = 0;
+    pHandle->shadow.enable = pHandle->shadow.txn_prev_enable;
+    pHandle->shadow.valid = 0;
+    pHandle->shadow.dirty = 0;
+
+    return 0;              /**< success */
 }
 
 /**
- * @brief     This function enables/disables countdown interrupt
+ * @brief     This function validates an init profile and compiles its register values
  * @param[in] *pHandle points to mcp794xx pHandle structure
- * @param[in] status is the enable boolean status to be set
+ * @param[in,out] pProfile point to the init profile
  * @return  status code
  *            - 0 success
- *            - 1 failed
  *            - 2 pHandle is NULL
  *            - 3 pHandle is not initialized
- * @note      This function use ALARM1 and disables ALARM 0
+ *            - 4 invalid profile field
+ * @note      Call it once, the profile can then be applied on every boot.
  */
-uint8_t mcp794xx_set_countdown_interrupt_enable_status(mcp794xx_handle_t *const pHandle, mcp794xx_bool_t status)
+uint8_t mcp794xx_init_profile_validate(mcp794xx_handle_t *const pHandle, mcp794xx_init_profile_t *pProfile)
 {
     if(pHandle == NULL)
         return 2;     /**< return failed error */
     if(pHandle->inited != 1)
         return 3;      /**< return failed error */
 
-	err = mcp794xx_set_alarm_enable_status(pHandle, MCP794XX_ALARM0, MCP794XX_BOOL_FALSE);
-	if(err != MCP794XX_DRV_OK)
-	{
-		a_mcp794xx_print_error_msg(pHandle, "set countdown interrupt, ALARM 0 not disabled");
-		return 1;
-	}
+    pProfile->validated = 0;
 
-    err = mcp794xx_set_alarm_enable_status(pHandle, MCP794XX_ALARM1, status);
-    if(err != MCP794XX_DRV_OK)
+    if((pProfile->alarm0_enable > MCP794XX_BOOL_TRUE) || (pProfile->alarm1_enable > MCP794XX_BOOL_TRUE) ||
+       (pProfile->clr_alarm_flags > MCP794XX_BOOL_TRUE) || (pProfile->mfp_logic_level > MCP794XX_MFP_LOGIC_HIGH) ||
+       (pProfile->sqr_wave_enable > MCP794XX_BOOL_TRUE) || (pProfile->sqr_wave_freq > MCP794XX_SQR_FREQ_SELCET_32_768KHZ) ||
+       (pProfile->coarse_trim_enable > MCP794XX_BOOL_TRUE) || (pProfile->ext_osc_enable > MCP794XX_OSC_ENABLED) ||
+       (pProfile->trim_update > MCP794XX_BOOL_TRUE) || (pProfile->trim_sign > MCP794XX_ADD_CLK_CYLCES) ||
+       (pProfile->trim_value > MCP794XX_TRIM_VAL_MASK) || (pProfile->ext_batt_update > MCP794XX_BOOL_TRUE) ||
+       (pProfile->ext_batt_enable > MCP794XX_BOOL_TRUE))
     {
-        a_mcp794xx_print_error_msg(pHandle, "set countdown interrupt");
-        return 1;
+        a_mcp794xx_print_error_msg(pHandle, "validate init profile, invalid field");
+        return 4;
     }
 
-    return 0;
+    if((pProfile->ext_batt_update == MCP794XX_BOOL_TRUE) && (pHandle->device_variant == MCP7940M_VARIANT))
+    {
+        a_mcp794xx_print_error_msg(pHandle, "validate init profile, external battery not supported for the mcp7940M variant");
+        return 4;
+    }
+
+    pProfile->control_reg = (uint8_t)((pProfile->mfp_logic_level << 7) | (pProfile->sqr_wave_enable << 6) |
+                                      (pProfile->alarm1_enable << 5) | (pProfile->alarm0_enable << 4) |
+                                      (pProfile->ext_osc_enable << 3) | (pProfile->coarse_trim_enable << 2) |
+                                      pProfile->sqr_wave_freq);
+    pProfile->trim_reg = (uint8_t)((pProfile->trim_sign << 7) | pProfile->trim_value);
+    pProfile->validated = 1;
+
+    return 0;              /**< success */
 }
 
 /**
- * @brief     This function set countdown time interrupt to fire every xx time set
+ * @brief     This function applies a validated init profile and starts the oscillator
  * @param[in] *pHandle points to mcp794xx pHandle structure
- * @param[in] pTime point to current time and date structure object
- * @param[in] u16Time_value is the time value to start counting down from
- * @param[in] time_unit is the time unit to countdown at (seconds/minutes/hours)
+ * @param[in] pProfile point to the validated init profile
+ * @param[out] pWarm_boot point to the warm boot status, true when the oscillator was already running
  * @return  status code
  *            - 0 success
  *            - 1 failed
  *            - 2 pHandle is NULL
  *            - 3 pHandle is not initialized
- *            - 4 invalid time unit
- *            - 5 invalid time value
- *
- * @note      - This function use ALARM1 and overwrite existing data within register
- *            - time must be reloaded after interrupt has occurred
- *			  - ALARM0 must not not used if countdown time is enabled
- *            - "mcp794xx_set_countdown_interrupt_enable_status"  must be called before using this function
- *            - Time and date must be set prior to calling this function
- *            - day of the week must be accurate when setting time
+ *            - 4 profile is not validated
+ * @note      - RTCSEC..ALM1WKDAY are read with one burst. Nothing is written on a warm boot where
+ *              the registers already match the profile.
+ *            - Otherwise only the differing registers are written, joined into as few bursts as possible.
+ *              CONTROL and OSCTRIM are always written together.
+ *            - On a cold boot the function waits MCP794XX_OSC_START_DELAY_MS after starting the oscillator.
  */
-uint8_t mcp794xx_set_countdown_interrupt_time(mcp794xx_handle_t *const pHandle, uint16_t u16Time_value, mcp794xx_countdwon_time_unit_t time_unit)
+uint8_t mcp794xx_init_profile_apply(mcp794xx_handle_t *const pHandle, mcp794xx_init_profile_t *pProfile, mcp794xx_bool_t *pWarm_boot)
 {
-	mcp794xx_time_t pTime;
-
-    uint32_t countdown_time_in_seconds;
-    uint32_t epoch_time;
+    uint8_t reg_image[MCP794XX_ALM1_WKDAY_REG + 1];
+    uint32_t u32Write = 0;
+    uint32_t u32Bridge;
+    uint8_t u8Cold_boot;
 
     if(pHandle == NULL)
         return 2;     /**< return failed error */
     if(pHandle->inited != 1)
         return 3;      /**< return failed error */
 
-    if((time_unit != MCP794XX_CNTDWN_SECONDS) && (time_unit != MCP794XX_CNTDWN_MINUTES) && (time_unit != MCP794XX_CNTDWN_HOURS))
+    if(pProfile->validated != 1)
     {
-        a_mcp794xx_print_error_msg(pHandle, "countdown interrupt, invalid time unit");
+        a_mcp794xx_print_error_msg(pHandle, "apply init profile, profile is not validated");
         return 4;
     }
 
-	mcp794xx_clr_alarm_interrupt_flag(pHandle, MCP794XX_ALARM1);						/**< clear alarm flag */
+    err = rtc_mcp794xx_i2c_read(pHandle, MCP794XX_RTC_SECOND_REG, (uint8_t *)reg_image, sizeof(reg_image));
+    if(err)
+    {
+        a_mcp794xx_print_error_msg(pHandle, "read registers before init");
+        return 1;           /**< failed error */
+    }
 
-	err = mcp794xx_get_time_and_date(pHandle, &pTime);										/**< get current time and date */
-	if(err)
-	{
-		a_mcp794xx_print_error_msg(pHandle, "read current time and date");
-		return err;
-	}
+    u8Cold_boot = ((reg_image[MCP794XX_RTC_SECOND_REG] & MCP794XX_ST_MASK) == 0) ||
+                  ((reg_image[MCP794XX_RTC_WKDAY_REG] & MCP794XX_OSC_RUN_STATUS_MASK) == 0);
 
-    if( u16Time_value < 0 || u16Time_value > 0xffff)
+    if((reg_image[MCP794XX_RTC_SECOND_REG] & MCP794XX_ST_MASK) == 0)
     {
-        a_mcp794xx_print_error_msg(pHandle, "countdown interrupt, value can not be less than 0 or greater than 65535");
-       return 5;
+        reg_image[MCP794XX_RTC_SECOND_REG] |= MCP794XX_ST_MASK;
+        u32Write |= 1UL << MCP794XX_RTC_SECOND_REG;
+    }
+    if((pProfile->ext_batt_update == MCP794XX_BOOL_TRUE) &&
+       (((reg_image[MCP794XX_RTC_WKDAY_REG] & MCP794XX_VBAT_EN_MASK) >> 3) != pProfile->ext_batt_enable))
+    {
+        reg_image[MCP794XX_RTC_WKDAY_REG] ^= MCP794XX_VBAT_EN_MASK;
+        u32Write |= 1UL << MCP794XX_RTC_WKDAY_REG;
+    }
+    if(reg_image[MCP794XX_CONTROL_REG] != pProfile->control_reg)
+    {
+        reg_image[MCP794XX_CONTROL_REG] = pProfile->control_reg;
+        u32Write |= 1UL << MCP794XX_CONTROL_REG;
+    }
+    if((pProfile->trim_update == MCP794XX_BOOL_TRUE) && (reg_image[MCP794XX_OSC_TRIM_REG] != pProfile->trim_reg))
+    {
+        reg_image[MCP794XX_OSC_TRIM_REG] = pProfile->trim_reg;
+        u32Write |= 1UL << MCP794XX_OSC_TRIM_REG;
+    }
+    if(u32Write & (1UL << MCP794XX_CONTROL_REG | 1UL << MCP794XX_OSC_TRIM_REG))
+    {
+        u32Write |= 1UL << MCP794XX_CONTROL_REG | 1UL << MCP794XX_OSC_TRIM_REG;        /**< one CONTROL + OSCTRIM burst */
+    }
+    if(pProfile->clr_alarm_flags == MCP794XX_BOOL_TRUE)
+    {
+        if(reg_image[MCP794XX_ALM0_WKDAY_REG] & MCP794XX_ALARMx_IF_MASK)
+            u32Write |= 1UL << MCP794XX_ALM0_WKDAY_REG;                                 /**< any write clears ALM0IF */
+        if(reg_image[MCP794XX_ALM1_WKDAY_REG] & MCP794XX_ALARMx_IF_MASK)
+            u32Write |= 1UL << MCP794XX_ALM1_WKDAY_REG;                                 /**< any write clears ALM1IF */
     }
 
-    err = mcp794xx_read_epoch_unix_time_stamp(pHandle, &pTime, (uint32_t *)&epoch_time);
+    if(pWarm_boot != NULL)
+        *pWarm_boot = (u8Cold_boot == 1) ? MCP794XX_BOOL_FALSE : MCP794XX_BOOL_TRUE;
+
+    if(u32Write == 0)
+        return 0;           /**< warm boot, profile already applied */
+
+    u32Bridge = (1UL << MCP794XX_CONTROL_REG) | (1UL << MCP794XX_OSC_TRIM_REG);
+    if((reg_image[MCP794XX_RTC_WKDAY_REG] & MCP794XX_OSC_RUN_STATUS_MASK) == 0)
+    {
+        u32Bridge |= (1UL << MCP794XX_RTC_SECOND_REG) | (1UL << MCP794XX_RTC_MINUTE_REG) | (1UL << MCP794XX_RTC_HOUR_REG) |
+                     (1UL << MCP794XX_RTC_WKDAY_REG) | (1UL << MCP794XX_RTC_DATE_REG) | (1UL << MCP794XX_RTC_MONTH_REG) |
+                     (1UL << MCP794XX_RTC_YEAR_REG);                                    /**< time is frozen, rewrite is safe */
+    }
+
+    err = a_mcp794xx_write_reg_runs(pHandle, reg_image, u32Write, u32Bridge);
     if(err)
     {
-        return err;
+        a_mcp794xx_print_error_msg(pHandle, "apply init profile");
+        return 1;           /**< failed error */
     }
 
-    switch(time_unit)
+    if((u32Write & (1UL << MCP794XX_RTC_SECOND_REG)) && (pHandle->delay_ms != NULL))
     {
+        pHandle->delay_ms(MCP794XX_OSC_START_DELAY_MS);                                  /**< let the oscillator start */
+    }
 
-        case MCP794XX_CNTDWN_SECONDS:
-            {
-                countdown_time_in_seconds = u16Time_value;
-                epoch_time += countdown_time_in_seconds;
-                break;
-            }
+    return 0;              /**< success */
+}
 
-        case MCP794XX_CNTDWN_MINUTES:
-            {
-                countdown_time_in_seconds = u16Time_value * 60;      /**< convert to second */
-                 epoch_time += countdown_time_in_seconds;
-                break;
-            }
+/**
+ * @brief     This function converts a proleptic Gregorian date to days since 1970-01-01
+ * @param[in] s32Year is the year (negative years are allowed)
+ * @param[in] u8Month is the month (1 - 12)
+ * @param[in] u8Day is the day of the month (1 - 31)
+ * @return    number of days since 1970-01-01, negative before
+ * @note      Closed form (no loop), handle free and reentrant. Valid for any year of the int32_t day range.
+ */
+int32_t mcp794xx_days_from_civil(int32_t s32Year, uint8_t u8Month, uint8_t u8Day)
+{
+    int32_t s32Era;
+    uint32_t u32Year_of_era;
+    uint32_t u32Day_of_year;
+    uint32_t u32Day_of_era;
+
+    s32Year -= (u8Month <= 2);                                                       /**< years start on March 1st */
+    s32Era = ((s32Year >= 0) ? s32Year : (s32Year - 399)) / 400;                      /**< 400 years era */
+    u32Year_of_era = (uint32_t)(s32Year - s32Era * 400);                             /**< [0, 399] */
+    u32Day_of_year = (153 * (u8Month + ((u8Month > 2) ? -3 : 9)) + 2) / 5 + u8Day - 1; /**< [0, 365] */
+    u32Day_of_era = u32Year_of_era * 365 + u32Year_of_era / 4 - u32Year_of_era / 100 + u32Day_of_year;  /**< [0, 146096] */
+
+    return s32Era * 146097 + (int32_t)u32Day_of_era - 719468;                        /**< shift 0000-03-01 to 1970-01-01 */
+}
 
-        case MCP794XX_CNTDWN_HOURS:
-            {
-                countdown_time_in_seconds = u16Time_value * 3600;    /**< convert to seconds */
-                 epoch_time += countdown_time_in_seconds;
-                break;
-            }
-    }
+/**
+ * @brief      This function converts days since 1970-01-01 to a proleptic Gregorian date
+ * @param[in]  s32Days is the number of days since 1970-01-01, negative before
+ * @param[out] pYear point to the year
+ * @param[out] pMonth point to the month (1 - 12)
+ * @param[out] pDay point to the day of the month (1 - 31)
+ * @return     none
+ * @note       Closed form (no loop), handle free and reentrant.
+ */
+void mcp794xx_civil_from_days(int32_t s32Days, int32_t *pYear, uint8_t *pMonth, uint8_t *pDay)
+{
+    int32_t s32Era;
+    uint32_t u32Day_of_era;
+    uint32_t u32Year_of_era;
+    uint32_t u32Day_of_year;
+    uint32_t u32Month_index;
+
+    s32Days += 719468;                                                               /**< shift 1970-01-01 to 0000-03-01 */
+    s32Era = ((s32Days >= 0) ? s32Days : (s32Days - 146096)) / 146097;               /**< 400 years era */
+    u32Day_of_era = (uint32_t)(s32Days - s32Era * 146097);                           /**< [0, 146096] */
+    u32Year_of_era = (u32Day_of_era - u32Day_of_era / 1460 + u32Day_of_era / 36524 - u32Day_of_era / 146096) / 365;  /**< [0, 399] */
+    u32Day_of_year = u32Day_of_era - (365 * u32Year_of_era + u32Year_of_era / 4 - u32Year_of_era / 100);  /**< [0, 365] */
+    u32Month_index = (5 * u32Day_of_year + 2) / 153;                                 /**< [0, 11], March based */
+
+    *pDay = (uint8_t)(u32Day_of_year - (153 * u32Month_index + 2) / 5 + 1);
+    *pMonth = (uint8_t)((u32Month_index < 10) ? (u32Month_index + 3) : (u32Month_index - 9));
+    *pYear = (int32_t)u32Year_of_era + s32Era * 400 + (*pMonth <= 2);
+}
 
-    err = mcp794xx_convert_epoch_unix_time_stamp(pHandle, epoch_time, &pTime);
-    if(err != MCP794XX_DRV_OK)
+/**
+ * @brief     This function returns the week day of a day count
+ * @param[in] s32Days is the number of days since 1970-01-01, negative before
+ * @return    week day (MCP794XX_WKDAY_SUNDAY - MCP794XX_WKDAY_SATURDAY)
+ * @note      handle free and reentrant
+ */
+mcp794xx_week_days_list_t mcp794xx_weekday_from_days(int32_t s32Days)
+{
+    return (mcp794xx_week_days_list_t)(((s32Days % 7) + 11) % 7 + 1);                /**< 1970-01-01 was a Thursday */
+}
+
+/**
+ * @brief  This function returns the hour in 24hr format
+ * @param[in] pTime point to the time and date
+ * @return hour (0 - 23)
+ * @note   none
+ */
+uint8_t a_mcp794xx_hour24(mcp794xx_time_t *pTime)
+{
+    if(pTime->time_Format == MCP794XX_12HR_FORMAT)
     {
-        return err;
+        return (pTime->hour % 12) + ((pTime->am_pm_indicator == MCP794XX_PM_INDICATOR) ? 12 : 0);
     }
 
-    err = mcp794xx_set_alarm(pHandle, MCP794XX_ALARM1, MCP794XX_MASK_S_M_H_WD_D_M, &pTime);
-    if(err != MCP794XX_DRV_OK)
+    return pTime->hour;
+}
+
+/**
+ * @brief  This function returns a comparable minute to month key
+ * @param[in] pTime point to the time and date
+ * @return key, larger for later in the year
+ * @note   the hour is taken in 24hr format
+ */
+uint32_t a_mcp794xx_time_key(mcp794xx_time_t *pTime)
+{
+    return ((uint32_t)pTime->month << 24) | ((uint32_t)pTime->date << 16) | ((uint32_t)a_mcp794xx_hour24(pTime) << 8) | pTime->minute;
+}
+
+/**
+ * @brief     This function set the century window of the 2-digit RTCYEAR register
+ * @param[in] *pHandle points to mcp794xx pHandle structure
+ * @param[in] u16Base_year is the first year of the window
+ * @return  status code
+ *            - 0 success
+ *            - 2 pHandle is NULL
+ *            - 3 pHandle is not initialized
+ *            - 4 base year out of range (1970 - 9900) or window holding a non-leap century year
+ * @note      - RTCYEAR 00..99 maps to u16Base_year..u16Base_year + 99, e.g. a base of 2301 reads 24 as 2324.
+ *              The default base is MCP794XX_CENTURY_BASE_DEFAULT.
+ *            - The chip takes every RTCYEAR multiple of 4 as a leap year. The window must not hold a century
+ *              year that is not a leap year (2100, 2200, 2300...), e.g. 1970 - 2000 or 2301 - 2400 are valid.
+ */
+uint8_t mcp794xx_set_century_base(mcp794xx_handle_t *const pHandle, uint16_t u16Base_year)
+{
+    if(pHandle == NULL)
+        return 2;     /**< return failed error */
+    if(pHandle->inited != 1)
+        return 3;      /**< return failed error */
+
+    if((u16Base_year < 1970) || (u16Base_year > 9900))
     {
-        return err;
+        a_mcp794xx_print_error_msg(pHandle, "set century base, year can not be less than 1970 or greater than 9900");
+        return 4;
+    }
+    if(((((u16Base_year + 99) / 100) * 100) % 400) != 0)
+    {
+        a_mcp794xx_print_error_msg(pHandle, "set century base, the window holds a century year that is not a leap year");
+        return 4;
     }
 
-    return 0;
+    pHandle->century_base = u16Base_year;
+
+    return 0;              /**< success */
 }
 
 /**
- * @brief     This function get the device unique identifier
+ * @brief     This function get the century window of the 2-digit RTCYEAR register
  * @param[in] *pHandle points to mcp794xx pHandle structure
- * @param[out] pUID point to the device Unique ID
+ * @param[out] pBase_year point to the first year of the window
  * @return  status code
  *            - 0 success
- *            - 1 failed to get S/N
  *            - 2 pHandle is NULL
  *            - 3 pHandle is not initialized
  * @note      none
  */
-uint8_t mcp794xx_uid_read(mcp794xx_handle_t *const pHandle, uint8_t *pUID)
+uint8_t mcp794xx_get_century_base(mcp794xx_handle_t *const pHandle, uint16_t *pBase_year)
 {
-    uint8_t temp_buffer[UID_MAX_LENGTH];
-
     if(pHandle == NULL)
         return 2;     /**< return failed error */
     if(pHandle->inited != 1)
         return 3;      /**< return failed error */
 
-    memset(temp_buffer, 0x00, sizeof(temp_buffer));                 /**< clear buffer before read */
+    *pBase_year = pHandle->century_base;
 
-    switch(pHandle->device_variant)
-    {
-        case MCP79400_VARIANT:
-        {
-            a_mcp794xx_print_error_msg(pHandle, "failed to read UID, unsupported cmd for mcp79400 variant");
-            return 1;           /**< failed error */
-            break;
-        }
+    return 0;              /**< success */
+}
 
-        case MCP79401_VARIANT:
-        {
-            err = eeprom_mcp794xx_i2c_read(pHandle, EEPROM_UID_ADDRESS + 2, (uint8_t *)temp_buffer, UID_MAX_LENGTH - 2);
+/**
+ * @brief         This function infers the year of a power-fail time stamp
+ * @param[in]     pNow point to the current time and date
+ * @param[in,out] pStamp point to the power-fail time stamp (minute to month)
+ * @return        none
+ * @note          - The time stamp has no year. It is given the year of its latest occurrence not after pNow,
+ *                  so a stamp later in the year than pNow belongs to the previous year.
+ *                - A 29 February stamp goes back to the latest leap year. The week day is then recomputed.
+ *                - Both times must use the same hour format, handle free and reentrant.
+ */
+void mcp794xx_infer_pwr_fail_year(mcp794xx_time_t *pNow, mcp794xx_time_t *pStamp)
+{
+    int32_t s32Year = pNow->year;
+
+    if(a_mcp794xx_time_key(pStamp) > a_mcp794xx_time_key(pNow))
+    {
+        s32Year--;                                                   /**< not reached yet this year */
+    }
+    if((pStamp->month == MCP794XX_MTH_FEBRUARY) && (pStamp->date == 29))
+    {
+        while(((s32Year % 4) != 0) || (((s32Year % 100) == 0) && ((s32Year % 400) != 0)))
+            s32Year--;                                               /**< latest leap year */
+    }
+
+    pStamp->year = (uint16_t)s32Year;
+    pStamp->weekDay = mcp794xx_weekday_from_days(mcp794xx_days_from_civil(s32Year, pStamp->month, pStamp->date));
+}
+
+/**
+ * @brief     This function read the current time in epoch/unix format
+ * @param[in] *pHandle points to mcp794xx pHandle structure
+ * @param[in] pTime point to the current time in human readable format
+ * @param[out] pEpoch_time point to the epoch time converted
+ * @return  status code
+ *            - 0 success
+ *            - 1 failed
+ *            - 2 pHandle is NULL
+ *            - 3 pHandle is not initialized
+ *            - 4 time out of the uint32_t epoch range (1970-01-01 - 2106-02-07 06:28:15)
+ * @note      24hr time is expected, the date is converted with mcp794xx_days_from_civil
+ */
+uint8_t mcp794xx_read_epoch_unix_time_stamp(mcp794xx_handle_t *const pHandle, mcp794xx_time_t *pTime, uint32_t *pEpoch_time)
+{
+    int32_t s32Days;
+    uint32_t u32Sec_of_day;
+
+    if(pHandle == NULL)
+        return 2;     /**< return failed error */
+    if(pHandle->inited != 1)
+        return 3;      /**< return failed error */
+
+    s32Days = mcp794xx_days_from_civil(pTime->year, pTime->month, pTime->date);      /**< days since 1 January 1970 */
+    u32Sec_of_day = (uint32_t)pTime->hour * 3600 + (uint16_t)pTime->minute * 60 + pTime->second;
+
+    if((s32Days < 0) || ((uint32_t)s32Days > (0xFFFFFFFFUL - u32Sec_of_day) / 86400))
+    {
+        a_mcp794xx_print_error_msg(pHandle, "read epoch time, time out of range");
+        return 4;
+    }
+
+    *pEpoch_time = (uint32_t)s32Days * 86400 + u32Sec_of_day;      /**< calculate number of seconds from current time and date */
+
+	return 0;   /**< success */
+}
+
+
+/**
+ * @brief  This function convert epoch time to human readable time format
+ * @param[in]  pHandle points to a mcp794xx handle structure
+ * @param[in] epoch_unix_time point to the epoch time converted
+ * @param[out] pTime point to time output in human readable time
+ * @return  status code
+ *            - 0 success
+ *            - 1 failed to get
+ *            - 2 pHandle is NULL
+ *            - 3 pHandle is not initialized
+ * @note      The date is converted with mcp794xx_civil_from_days, valid up to 2106-02-07 06:28:15
+ */
+uint8_t mcp794xx_convert_epoch_unix_time_stamp(mcp794xx_handle_t *const pHandle, uint32_t u32Epoch_time, mcp794xx_time_t *pTime_out)
+{
+    uint32_t sec_of_day;
+    int32_t s32Year;
+    uint8_t u8Month;
+    uint8_t u8Date;
+
+	if(pHandle == NULL)
+	return 2;     /**< return failed error */
+	if(pHandle->inited != 1)
+	return 3;      /**< return failed error */
+
+	u32Epoch_time += (pTime_out->local_time_zone * 3600);        /**< add time zone hours offset */
+
+	/**< get hour, minute and seconds */
+    sec_of_day = u32Epoch_time % 86400;
+
+    pTime_out->hour       = sec_of_day / 3600;
+    pTime_out->minute     = sec_of_day % 3600 / 60;
+    pTime_out->second     = sec_of_day % 60;
+
+    /**< get date and week day */
+    mcp794xx_civil_from_days((int32_t)(u32Epoch_time / 86400), &s32Year, &u8Month, &u8Date);
+    pTime_out->year = (uint16_t)s32Year;
+    pTime_out->month = (mcp794xx_months_list_t)u8Month;
+    pTime_out->date = u8Date;
+    pTime_out->weekDay = mcp794xx_weekday_from_days((int32_t)(u32Epoch_time / 86400));
+
+//	struct tm *time = localtime((const time_t *)&u32Epoch_time);          /**< built-in function from time.h library */
+//
+//	{ /** copy time structure members */
+//		pTime_out->year    = time->tm_year + 1900;
+//		pTime_out->month   = time->tm_mon + 1;
+//		pTime_out->date    = time->tm_mday;
+//		pTime_out->weekDay = time->tm_wday + 1;
+//		pTime_out->hour    = time->tm_hour;
+//		pTime_out->minute  = time->tm_min;
+//		pTime_out->second  = time->tm_sec;
+//	}
+//
+//	if (time == NULL)
+//	{
+//		a_mcp794xx_print_error_msg(pHandle, "convert epoch time to human readable time");
+//		return 1;						/**< failed */
+//	}
+
+    return 0;							/**< success */
+}
+
+/**
+ * @brief     This function converts a time and date to a 64-bit epoch/unix time
+ * @param[in] *pHandle points to mcp794xx pHandle structure
+ * @param[in] pTime point to the time and date, 4-digit year (0 - 9999)
+ * @param[out] pEpoch_time point to the epoch time converted
+ * @return  status code
+ *            - 0 success
+ *            - 2 pHandle is NULL
+ *            - 3 pHandle is not initialized
+ *            - 4 year out of range
+ * @note      24hr time is expected. No 64-bit division is used.
+ */
+uint8_t mcp794xx_read_epoch64_time_stamp(mcp794xx_handle_t *const pHandle, mcp794xx_time_t *pTime, int64_t *pEpoch_time)
+{
+    int32_t s32Days;
+
+    if(pHandle == NULL)
+        return 2;     /**< return failed error */
+    if(pHandle->inited != 1)
+        return 3;      /**< return failed error */
+
+    if(pTime->year > 9999)
+    {
+        a_mcp794xx_print_error_msg(pHandle, "read epoch time, year can not be greater than 9999");
+        return 4;
+    }
+
+    s32Days = mcp794xx_days_from_civil(pTime->year, pTime->month, pTime->date);      /**< days since 1 January 1970 */
+    *pEpoch_time = (int64_t)s32Days * 86400 + (int32_t)((uint32_t)pTime->hour * 3600 + (uint16_t)pTime->minute * 60 + pTime->second);
+
+    return 0;              /**< success */
+}
+
+/**
+ * @brief      This function converts a 64-bit epoch/unix time to human readable time
+ * @param[in]  *pHandle points to mcp794xx pHandle structure
+ * @param[in]  s64Epoch_time is the epoch time to convert
+ * @param[out] pTime_out point to time output in human readable time, local_time_zone is applied
+ * @return  status code
+ *            - 0 success
+ *            - 2 pHandle is NULL
+ *            - 3 pHandle is not initialized
+ *            - 4 time out of range (MCP794XX_EPOCH64_MIN - MCP794XX_EPOCH64_MAX)
+ * @note      The seconds are shifted by 7 (86400 = 128 * 675), only 32-bit divisions are left.
+ */
+uint8_t mcp794xx_convert_epoch64_time_stamp(mcp794xx_handle_t *const pHandle, int64_t s64Epoch_time, mcp794xx_time_t *pTime_out)
+{
+    uint64_t u64Shifted;
+    uint32_t u32Quotient;
+    uint32_t u32Sec_of_day;
+    int32_t s32Days;
+    int32_t s32Year;
+    uint8_t u8Month;
+    uint8_t u8Date;
+
+    if(pHandle == NULL)
+        return 2;     /**< return failed error */
+    if(pHandle->inited != 1)
+        return 3;      /**< return failed error */
+
+    s64Epoch_time += (int32_t)pTime_out->local_time_zone * 3600;        /**< add time zone hours offset */
+
+    if((s64Epoch_time < MCP794XX_EPOCH64_MIN) || (s64Epoch_time > MCP794XX_EPOCH64_MAX))
+    {
+        a_mcp794xx_print_error_msg(pHandle, "convert epoch time, time out of range");
+        return 4;
+    }
+
+    u64Shifted = (uint64_t)(s64Epoch_time + (int64_t)EPOCH64_DAY_OFFSET * 86400);   /**< positive, less than 2^39 */
+    u32Quotient = (uint32_t)(u64Shifted >> 7);                                        /**< seconds / 128, fits 32 bits */
+    s32Days = (int32_t)(u32Quotient / 675) - EPOCH64_DAY_OFFSET;
+    u32Sec_of_day = (u32Quotient % 675) * 128 + (uint32_t)(u64Shifted & 0x7F);
+
+    pTime_out->hour   = u32Sec_of_day / 3600;
+    pTime_out->minute = u32Sec_of_day % 3600 / 60;
+    pTime_out->second = u32Sec_of_day % 60;
+
+    mcp794xx_civil_from_days(s32Days, &s32Year, &u8Month, &u8Date);
+    pTime_out->year = (uint16_t)s32Year;
+    pTime_out->month = (mcp794xx_months_list_t)u8Month;
+    pTime_out->date = u8Date;
+    pTime_out->weekDay = mcp794xx_weekday_from_days(s32Days);
+
+    return 0;              /**< success */
+}
+
+/**
+ * @brief     This function configures the host interpolated clock
+ * @param[in] *pHandle points to mcp794xx pHandle structure
+ * @param[in] u32Resync_interval_ms is the bus re-anchor interval in ms, 0 to re-anchor only on request or on the 1 Hz edge
+ * @param[in] u32Drift_ppm is the combined RTC and MCU tick tolerance in ppm, used for the drift bound
+ * @return  status code
+ *            - 0 success
+ *            - 2 pHandle is NULL
+ *            - 3 pHandle is not initialized
+ *            - 4 get_tick_ms is not linked
+ * @note      The anchor is dropped, call mcp794xx_clock_anchor before mcp794xx_clock_now.
+ */
+uint8_t mcp794xx_set_clock_config(mcp794xx_handle_t *const pHandle, uint32_t u32Resync_interval_ms, uint32_t u32Drift_ppm)
+{
+    if(pHandle == NULL)
+        return 2;     /**< return failed error */
+    if(pHandle->inited != 1)
+        return 3;      /**< return failed error */
+
+    if(pHandle->get_tick_ms == NULL)
+    {
+        a_mcp794xx_print_error_msg(pHandle, "set clock config, get_tick_ms is not linked");
+        return 4;
+    }
+
+    pHandle->clock.seq++;                                 /**< odd: update in progress */
+    pHandle->clock.valid = 0;
+    pHandle->clock.phase_locked = 0;
+    pHandle->clock.resync_interval_ms = u32Resync_interval_ms;
+    pHandle->clock.drift_ppm = u32Drift_ppm;
+    pHandle->clock.last_correction_ms = 0;
+    pHandle->clock.seq++;
+
+    return 0;              /**< success */
+}
+
+/**
+ * @brief     This function re-anchors the host interpolated clock to the RTC
+ * @param[in] *pHandle points to mcp794xx pHandle structure
+ * @return  status code
+ *            - 0 success
+ *            - 1 failed to read the time
+ *            - 2 pHandle is NULL
+ *            - 3 pHandle is not initialized
+ *            - 4 get_tick_ms is not linked
+ * @note      One time snapshot is read. The RTC only gives the second, so an existing anchor is kept
+ *            when its prediction falls inside that second (the sub-second phase found on the 1 Hz edge
+ *            survives), otherwise it is clamped into it and last_correction_ms records the step.
+ */
+uint8_t mcp794xx_clock_anchor(mcp794xx_handle_t *const pHandle)
+{
+    mcp794xx_time_t now;
+    int64_t s64Seconds;
+    int64_t s64Predicted_sec;
+    int64_t s64Correction;
+    uint32_t u32Tick;
+    uint32_t u32Total;
+    uint16_t u16Frac = 0;
+    uint8_t u8Locked = 0;
+
+    if(pHandle == NULL)
+        return 2;     /**< return failed error */
+    if(pHandle->inited != 1)
+        return 3;      /**< return failed error */
+
+    if(pHandle->get_tick_ms == NULL)
+    {
+        a_mcp794xx_print_error_msg(pHandle, "clock anchor, get_tick_ms is not linked");
+        return 4;
+    }
+
+    now.time_Format = pHandle->time_param.time_Format;
+    err = mcp794xx_get_time_snapshot(pHandle, &now);
+    if(err)
+    {
+        return 1;           /**< failed error */
+    }
+    u32Tick = pHandle->get_tick_ms();
+
+    s64Seconds = (int64_t)mcp794xx_days_from_civil(now.year, now.month, now.date) * 86400 +
+                 (int32_t)((uint32_t)a_mcp794xx_hour24(&now) * 3600 + (uint16_t)now.minute * 60 + now.second);
+
+    pHandle->clock.seq++;                                 /**< odd: update in progress */
+    if(pHandle->clock.valid)
+    {
+        u32Total = pHandle->clock.anchor_frac_ms + (u32Tick - pHandle->clock.anchor_tick);
+        s64Predicted_sec = pHandle->clock.anchor_sec + u32Total / 1000;
+        u16Frac = u32Total % 1000;
+        s64Correction = (s64Predicted_sec - s64Seconds) * 1000 + u16Frac;   /**< predicted minus RTC second start */
+
+        if(s64Predicted_sec == s64Seconds)
+        {
+            s64Correction = 0;                            /**< prediction agrees with the RTC */
+            u8Locked = pHandle->clock.phase_locked;
+        }
+        else if(s64Predicted_sec < s64Seconds)
+        {
+            u16Frac = 0;                                  /**< host clock slow, clamp to the second start */
+        }
+        else
+        {
+            u16Frac = 999;                                /**< host clock fast, clamp to the second end */
+            s64Correction -= 999;
+        }
+        if(s64Correction > INT32_MAX)
+            s64Correction = INT32_MAX;
+        if(s64Correction < INT32_MIN)
+            s64Correction = INT32_MIN;
+        pHandle->clock.last_correction_ms = (int32_t)s64Correction;
+    }
+    pHandle->clock.anchor_sec = s64Seconds;
+    pHandle->clock.anchor_frac_ms = u16Frac;
+    pHandle->clock.anchor_tick = u32Tick;
+    pHandle->clock.phase_locked = u8Locked;
+    pHandle->clock.valid = 1;
+    pHandle->clock.seq++;
+
+    return 0;              /**< success */
+}
+
+/**
+ * @brief     This function re-anchors the host interpolated clock on the 1 Hz MFP edge
+ * @param[in] *pHandle points to mcp794xx pHandle structure
+ * @return  status code
+ *            - 0 success
+ *            - 2 pHandle is NULL
+ *            - 3 pHandle is not initialized
+ *            - 4 clock is not anchored
+ *            - 5 edge skipped, it interrupted a clock update
+ * @note      - No bus access, call it from the MFP interrupt on the edge where the seconds increment.
+ *            - The prediction is rounded to the nearest second, so the host drift between edges must stay below 500 ms.
+ */
+uint8_t mcp794xx_clock_on_second_edge(mcp794xx_handle_t *const pHandle)
+{
+    uint32_t u32Tick;
+    uint32_t u32Total;
+    uint32_t u32Seconds;
+
+    if(pHandle == NULL)
+        return 2;     /**< return failed error */
+    if(pHandle->inited != 1)
+        return 3;      /**< return failed error */
+
+    if(pHandle->clock.valid != 1)
+        return 4;
+    if(pHandle->clock.seq & 1)
+        return 5;                                         /**< interrupted a writer, keep its result */
+
+    u32Tick = pHandle->get_tick_ms();
+    u32Total = pHandle->clock.anchor_frac_ms + (u32Tick - pHandle->clock.anchor_tick);
+    u32Seconds = (u32Total + 500) / 1000;                 /**< nearest second boundary */
+
+    pHandle->clock.seq++;                                 /**< odd: update in progress */
+    pHandle->clock.last_correction_ms = (int32_t)(u32Total - u32Seconds * 1000);
+    pHandle->clock.anchor_sec += u32Seconds;
+    pHandle->clock.anchor_frac_ms = 0;
+    pHandle->clock.anchor_tick = u32Tick;
+    pHandle->clock.phase_locked = 1;
+    pHandle->clock.seq++;
+
+    return 0;              /**< success */
+}
+
+/**
+ * @brief      This function get the interpolated epoch time without a bus access
+ * @param[in]  *pHandle points to mcp794xx pHandle structure
+ * @param[out] pEpoch_ms point to the epoch time in ms
+ * @return  status code
+ *            - 0 success
+ *            - 1 failed to re-anchor
+ *            - 2 pHandle is NULL
+ *            - 3 pHandle is not initialized
+ *            - 4 clock is not anchored
+ * @note      - The time is the anchor plus the ticks elapsed since, the local time zone is not applied.
+ *            - When the resync interval has elapsed the clock is re-anchored first (one bus read).
+ *            - The tick is 32-bit, re-anchor at least every 49 days.
+ */
+uint8_t mcp794xx_clock_now(mcp794xx_handle_t *const pHandle, int64_t *pEpoch_ms)
+{
+    int64_t s64Anchor_sec;
+    uint32_t u32Elapsed;
+    uint16_t u16Frac;
+    uint8_t u8Seq;
+
+    if(pHandle == NULL)
+        return 2;     /**< return failed error */
+    if(pHandle->inited != 1)
+        return 3;      /**< return failed error */
+
+    if(pHandle->clock.valid != 1)
+        return 4;
+
+    if(pHandle->clock.resync_interval_ms != 0)
+    {
+        if((pHandle->get_tick_ms() - pHandle->clock.anchor_tick) >= pHandle->clock.resync_interval_ms)
+        {
+            err = mcp794xx_clock_anchor(pHandle);
             if(err)
             {
-                a_mcp794xx_print_error_msg(pHandle, "failed to read UID");
                 return 1;           /**< failed error */
             }
-            memcpy((uint8_t *)pUID, (uint8_t *)temp_buffer, sizeof(temp_buffer) - 2);
-            break;
         }
+    }
+
+    do
+    {
+        u8Seq = pHandle->clock.seq;                      /**< retry when the edge interrupt updated the anchor meanwhile */
+        s64Anchor_sec = pHandle->clock.anchor_sec;
+        u16Frac = pHandle->clock.anchor_frac_ms;
+        u32Elapsed = pHandle->get_tick_ms() - pHandle->clock.anchor_tick;
+    } while((u8Seq & 1) || (u8Seq != pHandle->clock.seq));
+
+    *pEpoch_ms = s64Anchor_sec * 1000 + u16Frac + u32Elapsed;
+
+    return 0;              /**< success */
+}
+
+/**
+ * @brief      This function get the error bound of the interpolated clock
+ * @param[in]  *pHandle points to mcp794xx pHandle structure
+ * @param[out] pBound_ms point to the worst case error of mcp794xx_clock_now in ms
+ * @return  status code
+ *            - 0 success
+ *            - 2 pHandle is NULL
+ *            - 3 pHandle is not initialized
+ *            - 4 clock is not anchored
+ * @note      The bound is the anchor phase uncertainty (999 ms until a 1 Hz edge was seen, else 0),
+ *            plus drift_ppm over the ticks elapsed since the anchor, plus one tick.
+ *            last_correction_ms in the clock structure holds the step measured at the last re-anchor.
+ */
+uint8_t mcp794xx_clock_get_drift_bound(mcp794xx_handle_t *const pHandle, uint32_t *pBound_ms)
+{
+    uint32_t u32Elapsed;
+
+    if(pHandle == NULL)
+        return 2;     /**< return failed error */
+    if(pHandle->inited != 1)
+        return 3;      /**< return failed error */
+
+    if(pHandle->clock.valid != 1)
+        return 4;
+
+    u32Elapsed = pHandle->get_tick_ms() - pHandle->clock.anchor_tick;
+    *pBound_ms = (pHandle->clock.phase_locked ? 0 : 999) + 1 +
+                 (uint32_t)(((uint64_t)u32Elapsed * pHandle->clock.drift_ppm + 999999) / 1000000);
+
+    return 0;              /**< success */
+}
+
+/**
+ * @brief  This function converts an edge count to the edges since the last second boundary
+ * @param[in] pHandle points to a mcp794xx handle structure
+ * @param[in] u32Count is the edge counter value
+ * @return phase in edges (0 - freq_hz - 1)
+ * @note   The frequencies are powers of two, so the phase is a mask: any counter width works as long as
+ *         it counts at least one second before wrapping.
+ */
+uint32_t a_mcp794xx_subsec_phase(mcp794xx_handle_t *const pHandle, uint32_t u32Count)
+{
+    return (u32Count - pHandle->subsec.boundary_count) & (pHandle->subsec.freq_hz - 1);
+}
+
+/**
+ * @brief  This function converts a phase in edges to us
+ * @param[in] pHandle points to a mcp794xx handle structure
+ * @param[in] u32Phase is the phase in edges
+ * @return time in us (0 - 999999)
+ * @note   1000000 = 15625 * 64 keeps the product in 32 bits.
+ */
+uint32_t a_mcp794xx_subsec_micros(mcp794xx_handle_t *const pHandle, uint32_t u32Phase)
+{
+    return (u32Phase * 15625) / (pHandle->subsec.freq_hz / 64);
+}
+
+/**
+ * @brief     This function aligns the square wave edge counter to the 1 Hz boundary
+ * @param[in] *pHandle points to mcp794xx pHandle structure
+ * @return  status code
+ *            - 0 success
+ *            - 1 failed to read the chip
+ *            - 2 pHandle is NULL
+ *            - 3 pHandle is not initialized
+ *            - 4 get_edge_count not linked, or MFP is not a 4.096, 8.192 or 32.768 kHz square wave
+ *            - 5 no second boundary seen within MCP794XX_SUBSEC_SYNC_MAX_POLLS reads, or a read lasts
+ *                longer than a quarter of a second in edges
+ * @note      - The seconds register is polled until it changes (up to one second of bus traffic), once.
+ *              Every later boundary is a whole number of periods away since the square wave and the
+ *              seconds share the crystal, so no further polling is needed.
+ *            - The 32.768 kHz output bypasses the digital trim: calibrate again after a trim change or
+ *              periodically when a trim is set.
+ */
+uint8_t mcp794xx_subsec_calibrate(mcp794xx_handle_t *const pHandle)
+{
+    static const uint32_t sqr_wave_freq_hz[4] = {1, 4096, 8192, 32768};
+    uint8_t u8Control;
+    uint8_t u8Second;
+    uint8_t u8First_second;
+    uint32_t u32Before;
+    uint32_t u32After;
+    uint32_t u32Previous;
+    uint32_t u32Poll;
+
+    if(pHandle == NULL)
+        return 2;     /**< return failed error */
+    if(pHandle->inited != 1)
+        return 3;      /**< return failed error */
+
+    if(pHandle->get_edge_count == NULL)
+    {
+        a_mcp794xx_print_error_msg(pHandle, "subsec calibrate, get_edge_count is not linked");
+        return 4;
+    }
+
+    err = a_mcp794xx_reg_read(pHandle, MCP794XX_CONTROL_REG, MCP794XX_CTRL_SQR_WAVE_EN_MASK | MCP794XX_CTRL_CRS_TRIM_EN_MASK |
+                              MCP794XX_CTRL_SQR_WAVE_FREQ_SELEC_MASK, (uint8_t *)&u8Control);
+    if(err)
+    {
+        a_mcp794xx_print_error_msg(pHandle, "read ctrl register");
+        return 1;           /**< failed error */
+    }
+    if(((u8Control & MCP794XX_CTRL_SQR_WAVE_EN_MASK) == 0) || (u8Control & MCP794XX_CTRL_CRS_TRIM_EN_MASK) ||
+       ((u8Control & MCP794XX_CTRL_SQR_WAVE_FREQ_SELEC_MASK) == MCP794XX_SQR_FREQ_SELCET_1HZ))
+    {
+        a_mcp794xx_print_error_msg(pHandle, "subsec calibrate, square wave output must be 4.096 kHz or faster");
+        return 4;
+    }
+
+    pHandle->subsec.valid = 0;
+    pHandle->subsec.freq_hz = sqr_wave_freq_hz[u8Control & MCP794XX_CTRL_SQR_WAVE_FREQ_SELEC_MASK];
+
+    u32Previous = pHandle->get_edge_count();
+    err = rtc_mcp794xx_i2c_read(pHandle, MCP794XX_RTC_SECOND_REG, (uint8_t *)&u8First_second, 1);
+    if(err)
+    {
+        a_mcp794xx_print_error_msg(pHandle, "read second register");
+        return 1;           /**< failed error */
+    }
+
+    for(u32Poll = 0; u32Poll < MCP794XX_SUBSEC_SYNC_MAX_POLLS; u32Poll++)
+    {
+        u32Before = pHandle->get_edge_count();
+        err = rtc_mcp794xx_i2c_read(pHandle, MCP794XX_RTC_SECOND_REG, (uint8_t *)&u8Second, 1);
+        u32After = pHandle->get_edge_count();
+        if(err)
+        {
+            a_mcp794xx_print_error_msg(pHandle, "read second register");
+            return 1;           /**< failed error */
+        }
+        if((u8Second & MCP794XX_SEC_BCD_MASK) != (u8First_second & MCP794XX_SEC_BCD_MASK))
+        {
+            /**< the boundary lies between the start of the previous read and the end of this one: take the
+                 latest end so the estimate is never early, the window bounds how late it can be */
+            pHandle->subsec.boundary_count = u32After;
+            pHandle->subsec.window = u32After - u32Previous + 1;
+            pHandle->subsec.valid = (pHandle->subsec.window < (pHandle->subsec.freq_hz / 4)) ? 1 : 0;
+            if(pHandle->subsec.valid != 1)
+            {
+                a_mcp794xx_print_error_msg(pHandle, "subsec calibrate, bus too slow for this frequency");
+                return 5;
+            }
+            return 0;              /**< success */
+        }
+        u32Previous = u32Before;
+    }
+
+    a_mcp794xx_print_error_msg(pHandle, "subsec calibrate, seconds did not change");
+    return 5;
+}
+
+/**
+ * @brief      This function get the time elapsed since the last second boundary
+ * @param[in]  *pHandle points to mcp794xx pHandle structure
+ * @param[out] pMicros point to the sub-second time in us (0 - 999999)
+ * @return  status code
+ *            - 0 success
+ *            - 2 pHandle is NULL
+ *            - 3 pHandle is not initialized
+ *            - 4 not calibrated
+ * @note      No bus access, interrupt safe: orders events within one second.
+ */
+uint8_t mcp794xx_subsec_get_phase(mcp794xx_handle_t *const pHandle, uint32_t *pMicros)
+{
+    if(pHandle == NULL)
+        return 2;     /**< return failed error */
+    if(pHandle->inited != 1)
+        return 3;      /**< return failed error */
+
+    if(pHandle->subsec.valid != 1)
+        return 4;
+
+    *pMicros = a_mcp794xx_subsec_micros(pHandle, a_mcp794xx_subsec_phase(pHandle, pHandle->get_edge_count()));
+
+    return 0;              /**< success */
+}
+
+/**
+ * @brief      This function get the time and date with a sub-second part
+ * @param[in]  *pHandle points to mcp794xx pHandle structure
+ * @param[out] pTime points to a time structure object
+ * @param[out] pMicros point to the sub-second time in us (0 - 999999)
+ * @return  status code
+ *            - 0 success
+ *            - 1 failed to read the time
+ *            - 2 pHandle is NULL
+ *            - 3 pHandle is not initialized
+ *            - 4 not calibrated
+ *            - 5 no consistent read in MCP794XX_SUBSEC_MAX_RETRY tries
+ * @note      The edge count is sampled around the time snapshot. When the read ends close to a second boundary
+ *            the seconds could belong to either side, the snapshot is then read again (a few reads at most).
+ *            The result is the time at the end of the read, the resolution is one square wave period (30.5 us
+ *            at 32.768 kHz) and the phase may lag by up to the calibration window.
+ */
+uint8_t mcp794xx_subsec_get_time(mcp794xx_handle_t *const pHandle, mcp794xx_time_t *pTime, uint32_t *pMicros)
+{
+    uint32_t u32Before;
+    uint32_t u32After;
+    uint8_t u8Try;
+
+    if(pHandle == NULL)
+        return 2;     /**< return failed error */
+    if(pHandle->inited != 1)
+        return 3;      /**< return failed error */
+
+    if(pHandle->subsec.valid != 1)
+        return 4;
+
+    for(u8Try = 0; u8Try < MCP794XX_SUBSEC_MAX_RETRY; u8Try++)
+    {
+        u32Before = pHandle->get_edge_count();
+        err = mcp794xx_get_time_snapshot(pHandle, pTime);
+        if(err)
+        {
+            return 1;           /**< failed error */
+        }
+        u32After = pHandle->get_edge_count();
+
+        /**< the estimated boundary is at most window edges late: the seconds read match the phase when no
+             estimated boundary falls in the read and the read ends at least window edges before the next one */
+        if((a_mcp794xx_subsec_phase(pHandle, u32Before) <= a_mcp794xx_subsec_phase(pHandle, u32After)) &&
+           (a_mcp794xx_subsec_phase(pHandle, u32After) < (pHandle->subsec.freq_hz - pHandle->subsec.window)))
+        {
+            *pMicros = a_mcp794xx_subsec_micros(pHandle, a_mcp794xx_subsec_phase(pHandle, u32After));
+            return 0;              /**< success */
+        }
+    }
+
+    a_mcp794xx_print_error_msg(pHandle, "subsec get time, edge counter does not match the seconds");
+    return 5;
+}
+
+/**
+ * @brief      This function reads the compile time and date of the application
+ * @param[in]  pHandle points to a mcp794xx handle structure
+ * @param[in]  Compile_time_date compile time and date string variable (__TIMESTAMP__)
+ * @param[out] pTime points to a time structure object
+ * @return     status code
+ *             - 0 success
+ *             - 1 failed
+ *             - 2 handle or time is NULL
+ *             - 3 handle is not initialized
+ * @note       this function returns time in 24Hr format
+ */
+uint8_t mcp794xx_get_compile_time_date(mcp794xx_handle_t *const pHandle, char *pCompile_time, char *pCompile_date,  mcp794xx_time_t *pTime)
+{
+    char year_string[3], month_string[3], date_string[3], /* week_day_string[1],*/ hour_string[3], minute_string[3], second_string[3];
+    uint32_t epoch_time;
+    uint8_t sec_offset = 15;      /**< this is an offset time to compensate lost seconds during compiling and programming the device,
+    									purely depends on how fast your computer does the job */
+
+    if(pHandle == NULL)
+        return 2;     /**< return failed error */
+    if(pHandle->inited != 1)
+        return 3;      /**< return failed error */
+
+    year_string[0] = BUILD_YEAR_CH2(pCompile_date);
+    year_string[1] = BUILD_YEAR_CH3(pCompile_date);
+
+    month_string[0] = BUILD_MONTH_CH0(pCompile_date);
+    month_string[1] = BUILD_MONTH_CH1(pCompile_date);
+
+    date_string[0] = BUILD_DATE_CH0(pCompile_date);
+    date_string[1] = BUILD_DATE_CH1(pCompile_date);
+
+    hour_string[0] = BUILD_HOUR_CH0(pCompile_time);
+    hour_string[1] = BUILD_HOUR_CH1(pCompile_time);
+
+    minute_string[0] = BUILD_MIN_CH0(pCompile_time);
+    minute_string[1] = BUILD_MIN_CH1(pCompile_time);
+
+    second_string[0] = BUILD_SEC_CH0(pCompile_time);
+    second_string[1] = BUILD_SEC_CH1(pCompile_time);
+
+    //week_day_string[0] = BUILD_WEEK_DAY_CH(pCompile_time_date);
+
+    pTime->year = atoi((const char *)year_string);
+    pTime->month = atoi((const char *) month_string);
+    pTime->date = atoi((const char *) date_string);
+    //pTime->weekDay = atoi((const char *) week_day_string);
+    pTime->hour = atoi((const char *) hour_string);
+    pTime->minute = atoi((const char *) minute_string);
+    pTime->second = atoi((const char *) second_string);
+
+	pTime->year = pTime->year + 2000;
+	//pHandle->debug_print("year:%d \n",pTime->year);
+	//pHandle->debug_print("month:%d \n",pTime->month);
+	//pHandle->debug_print("date:%d \n",pTime->date);
+	//pHandle->debug_print("hour:%d \n",pTime->hour);
+	//pHandle->debug_print("minute:%d \n",pTime->minute);
+	//pHandle->debug_print("sec:%d \n",pTime->second);
+	//pHandle->debug_print("weekday:%d \n",pTime->weekDay);
+
+	mcp794xx_read_epoch_unix_time_stamp(pHandle, pTime, (uint32_t *)&epoch_time);
+	mcp794xx_convert_epoch_unix_time_stamp(pHandle, epoch_time, pTime);
+
+	pTime->year = pTime->year - 2000;
+
+	if(pTime->second < 45){
+		pTime->second += sec_offset;
+		}else{
+		pTime->second = (pTime->second + sec_offset) - 60;
+		if(pTime->minute < 58){
+			pTime->minute += 1;
+			}else{
+			pTime->hour += 1;
+			pTime->minute = 0;
+		}
+	}
+
+    return 0;
+}
+
+/**
+ * @brief     This function enables/disables countdown interrupt
+ * @param[in] *pHandle points to mcp794xx pHandle structure
+ * @param[in] status is the enable boolean status to be set
+ * @return  status code
+ *            - 0 success
+ *            - 1 failed
+ *            - 2 pHandle is NULL
+ *            - 3 pHandle is not initialized
+ * @note      This function use ALARM1 and disables ALARM 0
+ */
+uint8_t mcp794xx_set_countdown_interrupt_enable_status(mcp794xx_handle_t *const pHandle, mcp794xx_bool_t status)
+{
+    if(pHandle == NULL)
+        return 2;     /**< return failed error */
+    if(pHandle->inited != 1)
+        return 3;      /**< return failed error */
+
+	err = mcp794xx_set_alarm_enable_status(pHandle, MCP794XX_ALARM0, MCP794XX_BOOL_FALSE);
+	if(err != MCP794XX_DRV_OK)
+	{
+		a_mcp794xx_print_error_msg(pHandle, "set countdown interrupt, ALARM 0 not disabled");
+		return 1;
+	}
+
+    err = mcp794xx_set_alarm_enable_status(pHandle, MCP794XX_ALARM1, status);
+    if(err != MCP794XX_DRV_OK)
+    {
+        a_mcp794xx_print_error_msg(pHandle, "set countdown interrupt");
+        return 1;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief     This function set countdown time interrupt to fire every xx time set
+ * @param[in] *pHandle points to mcp794xx pHandle structure
+ * @param[in] pTime point to current time and date structure object
+ * @param[in] u16Time_value is the time value to start counting down from
+ * @param[in] time_unit is the time unit to countdown at (seconds/minutes/hours)
+ * @return  status code
+ *            - 0 success
+ *            - 1 failed
+ *            - 2 pHandle is NULL
+ *            - 3 pHandle is not initialized
+ *            - 4 invalid time unit
+ *            - 5 invalid time value
+ *
+ * @note      - This function use ALARM1 and overwrite existing data within register
+ *            - time must be reloaded after interrupt has occurred
+ *			  - ALARM0 must not not used if countdown time is enabled
+ *            - "mcp794xx_set_countdown_interrupt_enable_status"  must be called before using this function
+ *            - Time and date must be set prior to calling this function
+ *            - day of the week must be accurate when setting time
+ */
+uint8_t mcp794xx_set_countdown_interrupt_time(mcp794xx_handle_t *const pHandle, uint16_t u16Time_value, mcp794xx_countdwon_time_unit_t time_unit)
+{
+	mcp794xx_time_t pTime;
+
+    uint32_t countdown_time_in_seconds;
+    uint32_t epoch_time;
+
+    if(pHandle == NULL)
+        return 2;     /**< return failed error */
+    if(pHandle->inited != 1)
+        return 3;      /**< return failed error */
+
+    if((time_unit != MCP794XX_CNTDWN_SECONDS) && (time_unit != MCP794XX_CNTDWN_MINUTES) && (time_unit != MCP794XX_CNTDWN_HOURS))
+    {
+        a_mcp794xx_print_error_msg(pHandle, "countdown interrupt, invalid time unit");
+        return 4;
+    }
+
+	mcp794xx_clr_alarm_interrupt_flag(pHandle, MCP794XX_ALARM1);						/**< clear alarm flag */
+
+	err = mcp794xx_get_time_and_date(pHandle, &pTime);										/**< get current time and date */
+	if(err)
+	{
+		a_mcp794xx_print_error_msg(pHandle, "read current time and date");
+		return err;
+	}
+
+    if( u16Time_value < 0 || u16Time_value > 0xffff)
+    {
+        a_mcp794xx_print_error_msg(pHandle, "countdown interrupt, value can not be less than 0 or greater than 65535");
+       return 5;
+    }
+
+    err = mcp794xx_read_epoch_unix_time_stamp(pHandle, &pTime, (uint32_t *)&epoch_time);
+    if(err)
+    {
+        return err;
+    }
+
+    switch(time_unit)
+    {
+
+        case MCP794XX_CNTDWN_SECONDS:
+            {
+                countdown_time_in_seconds = u16Time_value;
+                epoch_time += countdown_time_in_seconds;
+                break;
+            }
+
+        case MCP794XX_CNTDWN_MINUTES:
+            {
+                countdown_time_in_seconds = u16Time_value * 60;      /**< convert to second */
+                 epoch_time += countdown_time_in_seconds;
+                break;
+            }
+
+        case MCP794XX_CNTDWN_HOURS:
+            {
+                countdown_time_in_seconds = u16Time_value * 3600;    /**< convert to seconds */
+                 epoch_time += countdown_time_in_seconds;
+                break;
+            }
+    }
+
+    err = mcp794xx_convert_epoch_unix_time_stamp(pHandle, epoch_time, &pTime);
+    if(err != MCP794XX_DRV_OK)
+    {
+        return err;
+    }
+
+    err = mcp794xx_set_alarm(pHandle, MCP794XX_ALARM1, MCP794XX_MASK_S_M_H_WD_D_M, &pTime);
+    if(err != MCP794XX_DRV_OK)
+    {
+        return err;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief  This function reads the current time as a unix epoch
+ * @param[in] pHandle points to a mcp794xx handle structure
+ * @param[out] pEpoch_time point to the epoch time read
+ * @return status code
+ *          - 0 success
+ *          - 1 failed
+ * @note   12hr time is converted to 24hr before the epoch conversion
+ */
+uint8_t a_mcp794xx_now_epoch(mcp794xx_handle_t *const pHandle, uint32_t *pEpoch_time)
+{
+    mcp794xx_time_t now;
+
+    memset(&now, 0, sizeof(now));
+    if(mcp794xx_get_time_and_date(pHandle, &now) != MCP794XX_DRV_OK)
+    {
+        return 1;
+    }
+    now.hour = a_mcp794xx_hour24(&now);
+    now.time_Format = MCP794XX_24HR_FORMAT;
+    if(mcp794xx_read_epoch_unix_time_stamp(pHandle, &now, pEpoch_time) != MCP794XX_DRV_OK)
+    {
+        return 1;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief  This function converts a 24hr alarm hour to the chip hour format
+ * @param[in] pHandle points to a mcp794xx handle structure
+ * @param[in,out] pTime point to the alarm time
+ * @note   none
+ */
+void a_mcp794xx_alarm_hour_format(mcp794xx_handle_t *const pHandle, mcp794xx_time_t *pTime)
+{
+    pTime->time_Format = pHandle->time_param.time_Format;
+    if(pTime->time_Format == MCP794XX_12HR_FORMAT)
+    {
+        pTime->am_pm_indicator = (pTime->hour >= 12) ? MCP794XX_PM_INDICATOR : MCP794XX_AM_INDICATOR;
+        pTime->hour = ((pTime->hour % 12) == 0) ? 12 : (pTime->hour % 12);
+    }
+}
+
+/**
+ * @brief  This function converts a unix epoch to an alarm time in the chip hour format
+ * @param[in] pHandle points to a mcp794xx handle structure
+ * @param[in] u32Epoch_time is the epoch time
+ * @param[out] pTime point to the alarm time
+ * @return status code
+ *          - 0 success
+ *          - 1 failed
+ * @note   none
+ */
+uint8_t a_mcp794xx_epoch_to_alarm_time(mcp794xx_handle_t *const pHandle, uint32_t u32Epoch_time, mcp794xx_time_t *pTime)
+{
+    memset(pTime, 0, sizeof(mcp794xx_time_t));
+    if(mcp794xx_convert_epoch_unix_time_stamp(pHandle, u32Epoch_time, pTime) != MCP794XX_DRV_OK)
+    {
+        return 1;
+    }
+    a_mcp794xx_alarm_hour_format(pHandle, pTime);
+
+    return 0;
+}
+
+/**
+ * @brief  This function swaps two scheduler heap entries
+ * @param[in] pSched points to the scheduler
+ * @param[in] u8A is the first heap index
+ * @param[in] u8B is the second heap index
+ * @note   none
+ */
+void a_mcp794xx_sched_swap(mcp794xx_sched_t *pSched, uint8_t u8A, uint8_t u8B)
+{
+    uint8_t u8Id = pSched->heap[u8A];
+
+    pSched->heap[u8A] = pSched->heap[u8B];
+    pSched->heap[u8B] = u8Id;
+    pSched->pos[pSched->heap[u8A]] = u8A;
+    pSched->pos[pSched->heap[u8B]] = u8B;
+}
+
+/**
+ * @brief  This function moves a scheduler heap entry up to its place
+ * @param[in] pSched points to the scheduler
+ * @param[in] u8Index is the heap index
+ * @note   none
+ */
+void a_mcp794xx_sched_sift_up(mcp794xx_sched_t *pSched, uint8_t u8Index)
+{
+    uint8_t u8Parent;
+
+    while(u8Index > 0)
+    {
+        u8Parent = (u8Index - 1) / 2;
+        if(pSched->deadline[pSched->heap[u8Parent]] <= pSched->deadline[pSched->heap[u8Index]])
+            break;
+        a_mcp794xx_sched_swap(pSched, u8Index, u8Parent);
+        u8Index = u8Parent;
+    }
+}
+
+/**
+ * @brief  This function moves a scheduler heap entry down to its place
+ * @param[in] pSched points to the scheduler
+ * @param[in] u8Index is the heap index
+ * @note   none
+ */
+void a_mcp794xx_sched_sift_down(mcp794xx_sched_t *pSched, uint8_t u8Index)
+{
+    uint8_t u8Child;
+
+    while((u8Child = (2 * u8Index) + 1) < pSched->count)
+    {
+        if(((u8Child + 1) < pSched->count) && (pSched->deadline[pSched->heap[u8Child + 1]] < pSched->deadline[pSched->heap[u8Child]]))
+            u8Child++;
+        if(pSched->deadline[pSched->heap[u8Index]] <= pSched->deadline[pSched->heap[u8Child]])
+            break;
+        a_mcp794xx_sched_swap(pSched, u8Index, u8Child);
+        u8Index = u8Child;
+    }
+}
+
+/**
+ * @brief  This function removes a scheduler heap entry
+ * @param[in] pSched points to the scheduler
+ * @param[in] u8Index is the heap index
+ * @note   the id of the entry is freed
+ */
+void a_mcp794xx_sched_remove(mcp794xx_sched_t *pSched, uint8_t u8Index)
+{
+    uint8_t u8Last = pSched->count - 1;
+    uint8_t u8Moved = pSched->heap[u8Last];
+
+    pSched->pos[pSched->heap[u8Index]] = MCP794XX_SCHED_FREE;
+    pSched->count--;
+    if(u8Index == u8Last)
+    {
+        return;
+    }
+    pSched->heap[u8Index] = u8Moved;                                        /**< last entry fills the hole */
+    pSched->pos[u8Moved] = u8Index;
+    a_mcp794xx_sched_sift_up(pSched, u8Index);
+    if(pSched->pos[u8Moved] == u8Index)
+    {
+        a_mcp794xx_sched_sift_down(pSched, u8Index);
+    }
+}
+
+/**
+ * @brief  This function runs the due software alarms and programs the earliest pending one
+ * @param[in] pHandle points to a mcp794xx handle structure
+ * @return status code
+ *          - 0 success
+ *          - 1 failed
+ * @note   The time is read after the alarm is written, a deadline reached meanwhile is run instead of missed.
+ *         Callbacks may add or cancel alarms, the loop picks the changes up.
+ */
+uint8_t a_mcp794xx_sched_run(mcp794xx_handle_t *const pHandle)
+{
+    mcp794xx_sched_t *pSched = &pHandle->sched;
+    mcp794xx_time_t alarm_time;
+    mcp794xx_sched_callback_t callback;
+    uint32_t u32Now;
+    uint8_t u8Id;
+
+    if(pSched->running)
+    {
+        return 0;                                                           /**< called from a callback, the outer loop reprograms */
+    }
+    pSched->running = 1;
+
+    while(pSched->count != 0)
+    {
+        u8Id = pSched->heap[0];
+        if((pSched->armed != 1) || (pSched->armed_deadline != pSched->deadline[u8Id]))
+        {
+            if((a_mcp794xx_epoch_to_alarm_time(pHandle, pSched->deadline[u8Id], &alarm_time) != MCP794XX_DRV_OK) ||
+               (mcp794xx_set_alarm(pHandle, (mcp794xx_alarm_t)pSched->alarm, MCP794XX_MASK_S_M_H_WD_D_M, &alarm_time) != MCP794XX_DRV_OK))
+            {
+                pSched->running = 0;
+                return 1;
+            }
+            if(pSched->armed != 1)
+            {
+                if(mcp794xx_set_alarm_enable_status(pHandle, (mcp794xx_alarm_t)pSched->alarm, MCP794XX_BOOL_TRUE) != MCP794XX_DRV_OK)
+                {
+                    pSched->running = 0;
+                    return 1;
+                }
+                pSched->armed = 1;
+            }
+            pSched->armed_deadline = pSched->deadline[u8Id];
+        }
+
+        if(a_mcp794xx_now_epoch(pHandle, &u32Now) != MCP794XX_DRV_OK)
+        {
+            pSched->running = 0;
+            return 1;
+        }
+        if(pSched->deadline[u8Id] > u32Now)
+        {
+            pSched->running = 0;
+            return 0;                                                       /**< earliest alarm is programmed */
+        }
+
+        while((pSched->count != 0) && (pSched->deadline[pSched->heap[0]] <= u32Now))
+        {
+            u8Id = pSched->heap[0];
+            callback = pSched->callback[u8Id];
+            a_mcp794xx_sched_remove(pSched, 0);
+            callback(u8Id);
+        }
+    }
+
+    if(pSched->armed == 1)
+    {
+        pSched->armed = 0;
+        if(mcp794xx_set_alarm_enable_status(pHandle, (mcp794xx_alarm_t)pSched->alarm, MCP794XX_BOOL_FALSE) != MCP794XX_DRV_OK)
+        {
+            pSched->running = 0;
+            return 1;
+        }
+    }
+    pSched->running = 0;
+
+    return 0;
+}
+
+/**
+ * @brief  This function releases the hardware alarm a feature owns
+ * @param[in] pHandle points to a mcp794xx handle structure
+ * @param[in] owner is the feature
+ * @note   none
+ */
+void a_mcp794xx_alarm_release(mcp794xx_handle_t *const pHandle, mcp794xx_alarm_owner_t owner)
+{
+    uint8_t index;
+
+    for(index = 0; index < 2; index++)
+    {
+        if(pHandle->alarm_owner[index] == owner)
+        {
+            pHandle->alarm_owner[index] = MCP794XX_ALARM_OWNER_NONE;
+        }
+    }
+}
+
+/**
+ * @brief  This function checks that a hardware alarm is free for a feature being started
+ * @param[in] pHandle points to a mcp794xx handle structure
+ * @param[in] alarm is the hardware alarm
+ * @param[in] owner is the feature
+ * @return status code
+ *          - 0 the alarm is free or already owned by the feature
+ *          - 1 another feature owns the alarm
+ *          - 2 failed to disable the other alarm the feature owned
+ * @note   The alarm the feature owned before is released, the start sets the new owner once it succeeds.
+ *         When the feature moves to the other alarm, the old one is disabled first so it can not fire without an owner.
+ */
+uint8_t a_mcp794xx_alarm_claim(mcp794xx_handle_t *const pHandle, mcp794xx_alarm_t alarm, mcp794xx_alarm_owner_t owner)
+{
+    uint8_t index;
+
+    if((pHandle->alarm_owner[alarm] != MCP794XX_ALARM_OWNER_NONE) && (pHandle->alarm_owner[alarm] != owner))
+    {
+        return 1;
+    }
+    for(index = 0; index < 2; index++)
+    {
+        if((index != (uint8_t)alarm) && (pHandle->alarm_owner[index] == owner))
+        {
+            if(mcp794xx_set_alarm_enable_status(pHandle, (mcp794xx_alarm_t)index, MCP794XX_BOOL_FALSE) != MCP794XX_DRV_OK)
+            {
+                return 2;                                                   /**< the feature keeps the old alarm */
+            }
+        }
+    }
+    a_mcp794xx_alarm_release(pHandle, owner);
+
+    return 0;
+}
+
+/**
+ * @brief     This function starts the software alarm scheduler
+ * @param[in] *pHandle points to mcp794xx pHandle structure
+ * @param[in] alarm is the hardware alarm the scheduler owns (ALARM0/ALARM1)
+ * @return  status code
+ *            - 0 success
+ *            - 1 failed
+ *            - 2 pHandle is NULL
+ *            - 3 pHandle is not initialized
+ *            - 4 invalid alarm
+ *            - 5 alarm owned by the periodic timer or the cron alarm
+ * @note      Pending software alarms are dropped and the hardware alarm is disabled until one is added.
+ *            Restarting on the other hardware alarm disables the one used before.
+ */
+uint8_t mcp794xx_sched_start(mcp794xx_handle_t *const pHandle, mcp794xx_alarm_t alarm)
+{
+    if(pHandle == NULL)
+        return 2;     /**< return failed error */
+    if(pHandle->inited != 1)
+        return 3;      /**< return failed error */
+
+    if((alarm != MCP794XX_ALARM0) && (alarm != MCP794XX_ALARM1))
+    {
+        a_mcp794xx_print_error_msg(pHandle, "scheduler, invalid alarm selected");
+        return 4;
+    }
+    err = a_mcp794xx_alarm_claim(pHandle, alarm, MCP794XX_ALARM_OWNER_SCHED);
+    if(err == 1)
+    {
+        a_mcp794xx_print_error_msg(pHandle, "scheduler, alarm used by another feature");
+        return 5;
+    }
+    if(err != 0)
+    {
+        a_mcp794xx_print_error_msg(pHandle, "scheduler, disable the previous alarm");
+        return 1;
+    }
+
+    memset(&pHandle->sched, 0, sizeof(pHandle->sched));
+    memset(pHandle->sched.pos, MCP794XX_SCHED_FREE, sizeof(pHandle->sched.pos));
+    pHandle->sched.alarm = alarm;
+
+    err = mcp794xx_set_alarm_enable_status(pHandle, alarm, MCP794XX_BOOL_FALSE);
+    if(err != MCP794XX_DRV_OK)
+    {
+        a_mcp794xx_print_error_msg(pHandle, "scheduler, disable alarm");
+        return 1;
+    }
+    pHandle->sched.started = 1;
+    pHandle->alarm_owner[alarm] = MCP794XX_ALARM_OWNER_SCHED;
+
+    return 0;              /**< success */
+}
+
+/**
+ * @brief     This function adds a software alarm to the scheduler
+ * @param[in] *pHandle points to mcp794xx pHandle structure
+ * @param[in] u32Epoch_time is the deadline (unix epoch, RTC time)
+ * @param[in] callback is the function called once the deadline is reached
+ * @param[out] *pId points to the software alarm id, used to cancel it
+ * @return  status code
+ *            - 0 success
+ *            - 1 failed to program the hardware alarm
+ *            - 2 pHandle is NULL
+ *            - 3 pHandle is not initialized
+ *            - 4 callback is NULL
+ *            - 5 scheduler not started
+ *            - 6 no free software alarm
+ * @note      O(log n). The hardware alarm is reprogrammed only when the new deadline is the earliest,
+ *            a deadline already passed runs its callback before returning.
+ */
+uint8_t mcp794xx_sched_add(mcp794xx_handle_t *const pHandle, uint32_t u32Epoch_time, mcp794xx_sched_callback_t callback, uint8_t *pId)
+{
+    mcp794xx_sched_t *pSched;
+    uint8_t u8Id;
+
+    if(pHandle == NULL)
+        return 2;     /**< return failed error */
+    if(pHandle->inited != 1)
+        return 3;      /**< return failed error */
+
+    pSched = &pHandle->sched;
+    if(callback == NULL)
+    {
+        a_mcp794xx_print_error_msg(pHandle, "scheduler add, callback is NULL");
+        return 4;
+    }
+    if(pSched->started != 1)
+    {
+        a_mcp794xx_print_error_msg(pHandle, "scheduler add, scheduler not started");
+        return 5;
+    }
+
+    for(u8Id = 0; u8Id < MCP794XX_SCHED_MAX_ALARMS; u8Id++)
+    {
+        if(pSched->pos[u8Id] == MCP794XX_SCHED_FREE)
+            break;
+    }
+    if(u8Id == MCP794XX_SCHED_MAX_ALARMS)
+    {
+        a_mcp794xx_print_error_msg(pHandle, "scheduler add, no free software alarm");
+        return 6;
+    }
+
+    pSched->deadline[u8Id] = u32Epoch_time;
+    pSched->callback[u8Id] = callback;
+    pSched->heap[pSched->count] = u8Id;
+    pSched->pos[u8Id] = pSched->count;
+    pSched->count++;
+    a_mcp794xx_sched_sift_up(pSched, pSched->pos[u8Id]);
+    *pId = u8Id;
+
+    if(pSched->heap[0] == u8Id)
+    {
+        err = a_mcp794xx_sched_run(pHandle);
+        if(err)
+        {
+            a_mcp794xx_print_error_msg(pHandle, "scheduler add, program alarm");
+            return 1;
+        }
+    }
+
+    return 0;              /**< success */
+}
+
+/**
+ * @brief     This function cancels a pending software alarm
+ * @param[in] *pHandle points to mcp794xx pHandle structure
+ * @param[in] u8Id is the software alarm id
+ * @return  status code
+ *            - 0 success
+ *            - 1 failed to program the hardware alarm
+ *            - 2 pHandle is NULL
+ *            - 3 pHandle is not initialized
+ *            - 4 invalid id or alarm not pending
+ *            - 5 scheduler not started
+ * @note      O(log n), the hardware alarm is reprogrammed only when the earliest alarm is cancelled
+ */
+uint8_t mcp794xx_sched_cancel(mcp794xx_handle_t *const pHandle, uint8_t u8Id)
+{
+    mcp794xx_sched_t *pSched;
+    uint8_t u8Was_first;
+
+    if(pHandle == NULL)
+        return 2;     /**< return failed error */
+    if(pHandle->inited != 1)
+        return 3;      /**< return failed error */
+
+    pSched = &pHandle->sched;
+    if(pSched->started != 1)
+    {
+        a_mcp794xx_print_error_msg(pHandle, "scheduler cancel, scheduler not started");
+        return 5;
+    }
+    if((u8Id >= MCP794XX_SCHED_MAX_ALARMS) || (pSched->pos[u8Id] == MCP794XX_SCHED_FREE))
+    {
+        a_mcp794xx_print_error_msg(pHandle, "scheduler cancel, alarm not pending");
+        return 4;
+    }
+
+    u8Was_first = (pSched->pos[u8Id] == 0);
+    a_mcp794xx_sched_remove(pSched, pSched->pos[u8Id]);
+
+    if(u8Was_first)
+    {
+        err = a_mcp794xx_sched_run(pHandle);
+        if(err)
+        {
+            a_mcp794xx_print_error_msg(pHandle, "scheduler cancel, program alarm");
+            return 1;
+        }
+    }
+
+    return 0;              /**< success */
+}
+
+/**
+ * @brief     This function services the scheduler after its hardware alarm fired
+ * @param[in] *pHandle points to mcp794xx pHandle structure
+ * @return  status code
+ *            - 0 success
+ *            - 1 failed
+ *            - 2 pHandle is NULL
+ *            - 3 pHandle is not initialized
+ *            - 5 scheduler not started
+ * @note      Call from thread context once the MFP interrupt of the scheduler alarm is seen. The alarm flag is
+ *            cleared, every due software alarm is called, earliest first, and the next deadline is programmed.
+ */
+uint8_t mcp794xx_sched_service(mcp794xx_handle_t *const pHandle)
+{
+    if(pHandle == NULL)
+        return 2;     /**< return failed error */
+    if(pHandle->inited != 1)
+        return 3;      /**< return failed error */
+
+    if(pHandle->sched.started != 1)
+    {
+        a_mcp794xx_print_error_msg(pHandle, "scheduler service, scheduler not started");
+        return 5;
+    }
+
+    err = mcp794xx_clr_alarm_interrupt_flag(pHandle, (mcp794xx_alarm_t)pHandle->sched.alarm);
+    if(err != MCP794XX_DRV_OK)
+    {
+        a_mcp794xx_print_error_msg(pHandle, "scheduler service, clear alarm flag");
+        return 1;
+    }
+
+    err = a_mcp794xx_sched_run(pHandle);
+    if(err)
+    {
+        a_mcp794xx_print_error_msg(pHandle, "scheduler service");
+        return 1;
+    }
+
+    return 0;              /**< success */
+}
+
+/**
+ * @brief     This function stops the software alarm scheduler
+ * @param[in] *pHandle points to mcp794xx pHandle structure
+ * @return  status code
+ *            - 0 success
+ *            - 1 failed
+ *            - 2 pHandle is NULL
+ *            - 3 pHandle is not initialized
+ * @note      Pending software alarms are dropped, the hardware alarm is disabled and released.
+ */
+uint8_t mcp794xx_sched_stop(mcp794xx_handle_t *const pHandle)
+{
+    if(pHandle == NULL)
+        return 2;     /**< return failed error */
+    if(pHandle->inited != 1)
+        return 3;      /**< return failed error */
+
+    a_mcp794xx_alarm_release(pHandle, MCP794XX_ALARM_OWNER_SCHED);
+    if(pHandle->sched.started != 1)
+    {
+        return 0;
+    }
+    pHandle->sched.started = 0;
+    pHandle->sched.count = 0;
+
+    err = mcp794xx_set_alarm_enable_status(pHandle, (mcp794xx_alarm_t)pHandle->sched.alarm, MCP794XX_BOOL_FALSE);
+    if(err != MCP794XX_DRV_OK)
+    {
+        a_mcp794xx_print_error_msg(pHandle, "scheduler stop, disable alarm");
+        return 1;
+    }
+
+    return 0;              /**< success */
+}
+
+/**
+ * @brief  This function checks whether a full match alarm was written after its deadline
+ * @param[in] pHandle points to a mcp794xx handle structure
+ * @param[in] alarm is the hardware alarm written
+ * @param[in] u32Deadline is the deadline written to the alarm (unix epoch)
+ * @param[out] pNow point to the time read after the write (unix epoch)
+ * @param[out] pMissed point to the result, 1 when the deadline passed without the alarm firing
+ * @return status code
+ *          - 0 success
+ *          - 1 failed
+ * @note   The full match alarm has no year field, a missed deadline would only match again a year later.
+ *         The alarm flag is read only when the deadline is not in the future.
+ */
+uint8_t a_mcp794xx_alarm_missed(mcp794xx_handle_t *const pHandle, mcp794xx_alarm_t alarm, uint32_t u32Deadline, uint32_t *pNow, uint8_t *pMissed)
+{
+    mcp794xx_alarm_int_flag_t flag;
+
+    *pMissed = 0;
+    if(a_mcp794xx_now_epoch(pHandle, pNow) != MCP794XX_DRV_OK)
+    {
+        return 1;
+    }
+    if(u32Deadline > *pNow)
+    {
+        return 0;                                                           /**< the match is still ahead */
+    }
+    if(mcp794xx_get_alarm_interrupt_flag(pHandle, alarm, &flag) != MCP794XX_DRV_OK)
+    {
+        return 1;
+    }
+    *pMissed = (flag == MCP794XX_ALARM_INT_OCCURED) ? 0 : 1;
+
+    return 0;
+}
+
+/**
+ * @brief  This function writes the periodic timer deadline to its alarm in one burst
+ * @param[in] pHandle points to a mcp794xx handle structure
+ * @return status code
+ *          - 0 success
+ *          - 1 failed
+ * @note   - The six alarm registers are built from the cached hour format bit and the current polarity (from the
+ *           shadow when it holds ALMxWKDAY, otherwise one read). The full match mask is set and the alarm flag
+ *           is cleared by the same write.
+ *         - The time is read after the write. A deadline passed before the write landed is skipped and the next
+ *           one is written.
+ */
+uint8_t a_mcp794xx_periodic_arm(mcp794xx_handle_t *const pHandle)
+{
+    mcp794xx_periodic_t *pTimer = &pHandle->periodic;
+    uint8_t ptimeBuffer[MCP794XX_TIME_BUFFER_SIZE - 1];
+    mcp794xx_time_t alarm_time;
+    uint8_t u8Wkday;
+    uint8_t u8Missed;
+    uint32_t u32Now;
+
+    if(a_mcp794xx_reg_read(pHandle, (pTimer->alarm == MCP794XX_ALARM0) ? MCP794XX_ALM0_WKDAY_REG : MCP794XX_ALM1_WKDAY_REG,
+                           MCP794XX_ALARMx_INT_POL_MASK, &u8Wkday) != MCP794XX_DRV_OK)
+    {
+        return 1;
+    }
+
+    for(;;)
+    {
+        if(a_mcp794xx_epoch_to_alarm_time(pHandle, pTimer->deadline, &alarm_time) != MCP794XX_DRV_OK)
+        {
+            return 1;
+        }
+
+        ptimeBuffer[0] = a_pcf85xxx_dec2bcd(alarm_time.second);
+        ptimeBuffer[1] = a_pcf85xxx_dec2bcd(alarm_time.minute);
+        ptimeBuffer[2] = a_pcf85xxx_dec2bcd(alarm_time.hour) | pTimer->hour_bits;
+        if(alarm_time.time_Format == MCP794XX_12HR_FORMAT)
+        {
+            ptimeBuffer[2] |= ((alarm_time.am_pm_indicator << 5) & MCP794XX_ALARMx_AM_PM_MASK);
+        }
+        ptimeBuffer[3] = (u8Wkday & MCP794XX_ALARMx_INT_POL_MASK) | ((MCP794XX_MASK_S_M_H_WD_D_M << 4) & MCP794XX_ALARMx_TYPE_MASK) |
+                         a_pcf85xxx_dec2bcd(alarm_time.weekDay);              /**< ALMxIF written 0 */
+        ptimeBuffer[4] = a_pcf85xxx_dec2bcd(alarm_time.date);
+        ptimeBuffer[5] = a_pcf85xxx_dec2bcd(alarm_time.month);
+
+        if(rtc_mcp794xx_i2c_write(pHandle, (pTimer->alarm == MCP794XX_ALARM0) ? MCP794XX_ALM0_SEC_REG : MCP794XX_ALM1_SEC_REG,
+                                  (uint8_t *)ptimeBuffer, sizeof(ptimeBuffer)) != MCP794XX_DRV_OK)
+        {
+            return 1;
+        }
+
+        if(a_mcp794xx_alarm_missed(pHandle, (mcp794xx_alarm_t)pTimer->alarm, pTimer->deadline, &u32Now, &u8Missed) != MCP794XX_DRV_OK)
+        {
+            return 1;
+        }
+        if(u8Missed != 1)
+        {
+            return 0;
+        }
+        pTimer->deadline += (((u32Now - pTimer->deadline) / pTimer->period) + 1) * pTimer->period;   /**< written too late, skip it */
+    }
+}
+
+/**
+ * @brief     This function starts a self re-arming periodic timer on a hardware alarm
+ * @param[in] *pHandle points to mcp794xx pHandle structure
+ * @param[in] alarm is the hardware alarm used (ALARM0/ALARM1)
+ * @param[in] u32Period is the period (seconds, 1 second to several years)
+ * @return  status code
+ *            - 0 success
+ *            - 1 failed
+ *            - 2 pHandle is NULL
+ *            - 3 pHandle is not initialized
+ *            - 4 invalid alarm
+ *            - 5 invalid period
+ *            - 6 alarm owned by the scheduler or the cron alarm
+ * @note      The first deadline is one period from now.
+ *            mcp794xx_periodic_timer_service re-arms the timer after each interrupt.
+ *            Restarting on the other hardware alarm disables the one used before.
+ */
+uint8_t mcp794xx_periodic_timer_start(mcp794xx_handle_t *const pHandle, mcp794xx_alarm_t alarm, uint32_t u32Period)
+{
+    uint8_t u8Hour;
+    uint32_t u32Now;
+
+    if(pHandle == NULL)
+        return 2;     /**< return failed error */
+    if(pHandle->inited != 1)
+        return 3;      /**< return failed error */
+
+    if((alarm != MCP794XX_ALARM0) && (alarm != MCP794XX_ALARM1))
+    {
+        a_mcp794xx_print_error_msg(pHandle, "periodic timer, invalid alarm selected");
+        return 4;
+    }
+    if(u32Period == 0)
+    {
+        a_mcp794xx_print_error_msg(pHandle, "periodic timer, period can not be 0");
+        return 5;
+    }
+    err = a_mcp794xx_alarm_claim(pHandle, alarm, MCP794XX_ALARM_OWNER_PERIODIC);
+    if(err == 1)
+    {
+        a_mcp794xx_print_error_msg(pHandle, "periodic timer, alarm used by another feature");
+        return 6;
+    }
+    if(err != 0)
+    {
+        a_mcp794xx_print_error_msg(pHandle, "periodic timer, disable the previous alarm");
+        return 1;
+    }
+
+    pHandle->periodic.started = 0;
+    err = rtc_mcp794xx_i2c_read(pHandle, ((alarm == MCP794XX_ALARM0) ? MCP794XX_ALM0_SEC_REG : MCP794XX_ALM1_SEC_REG) + 2, (uint8_t *)&u8Hour, 1);
+    if(err)
+    {
+        a_mcp794xx_print_error_msg(pHandle, "periodic timer, read alarm");
+        return 1;
+    }
+    err = a_mcp794xx_now_epoch(pHandle, &u32Now);
+    if(err)
+    {
+        a_mcp794xx_print_error_msg(pHandle, "periodic timer, read time");
+        return 1;
+    }
+
+    pHandle->periodic.alarm = alarm;
+    pHandle->periodic.period = u32Period;
+    pHandle->periodic.deadline = u32Now + u32Period;
+    pHandle->periodic.hour_bits = u8Hour & MCP794XX_ALARMx_12HR_24HR_FRMT_STAT_MASK;
+
+    err = a_mcp794xx_periodic_arm(pHandle);
+    if(err)
+    {
+        a_mcp794xx_print_error_msg(pHandle, "periodic timer, write alarm");
+        return 1;
+    }
+    err = mcp794xx_set_alarm_enable_status(pHandle, alarm, MCP794XX_BOOL_TRUE);
+    if(err != MCP794XX_DRV_OK)
+    {
+        a_mcp794xx_print_error_msg(pHandle, "periodic timer, enable alarm");
+        return 1;
+    }
+    pHandle->periodic.started = 1;
+    pHandle->alarm_owner[alarm] = MCP794XX_ALARM_OWNER_PERIODIC;
+
+    return 0;              /**< success */
+}
+
+/**
+ * @brief     This function re-arms the periodic timer after its interrupt
+ * @param[in] *pHandle points to mcp794xx pHandle structure
+ * @return  status code
+ *            - 0 success
+ *            - 1 failed
+ *            - 2 pHandle is NULL
+ *            - 3 pHandle is not initialized
+ *            - 4 periodic timer not started
+ * @note      - One burst write of the alarm registers, which also clears the alarm flag. The next deadline is the
+ *              previous one plus the period, so service latency does not accumulate.
+ *            - Periods missed while the service was late are skipped, a past deadline would only match again
+ *              a year later. The time comes from the interpolated clock when anchored (mcp794xx_clock_anchor),
+ *              otherwise it is read once.
+ *            - The time is read back after the write. A deadline passed before the write landed (e.g. a 1 second
+ *              period) is skipped and the next one is written.
+ *            - The polarity is taken from ALMxWKDAY at each re-arm, mcp794xx_set_alarm_interrupt_output_polarity
+ *              may be called while the timer runs.
+ */
+uint8_t mcp794xx_periodic_timer_service(mcp794xx_handle_t *const pHandle)
+{
+    mcp794xx_periodic_t *pTimer;
+    int64_t s64Now_ms;
+    uint32_t u32Now;
+
+    if(pHandle == NULL)
+        return 2;     /**< return failed error */
+    if(pHandle->inited != 1)
+        return 3;      /**< return failed error */
+
+    pTimer = &pHandle->periodic;
+    if(pTimer->started != 1)
+    {
+        a_mcp794xx_print_error_msg(pHandle, "periodic timer service, timer not started");
+        return 4;
+    }
+
+    pTimer->deadline += pTimer->period;
+    if((pHandle->clock.valid == 1) && (mcp794xx_clock_now(pHandle, &s64Now_ms) == MCP794XX_DRV_OK))
+    {
+        u32Now = (uint32_t)(s64Now_ms / 1000);
+    }
+    else if(a_mcp794xx_now_epoch(pHandle, &u32Now) != MCP794XX_DRV_OK)
+    {
+        a_mcp794xx_print_error_msg(pHandle, "periodic timer service, read time");
+        return 1;
+    }
+    if(pTimer->deadline <= u32Now)
+    {
+        pTimer->deadline += (((u32Now - pTimer->deadline) / pTimer->period) + 1) * pTimer->period;   /**< skip missed periods */
+    }
+
+    err = a_mcp794xx_periodic_arm(pHandle);
+    if(err)
+    {
+        a_mcp794xx_print_error_msg(pHandle, "periodic timer service, write alarm");
+        return 1;
+    }
+
+    return 0;              /**< success */
+}
+
+/**
+ * @brief     This function stops the periodic timer
+ * @param[in] *pHandle points to mcp794xx pHandle structure
+ * @return  status code
+ *            - 0 success
+ *            - 1 failed
+ *            - 2 pHandle is NULL
+ *            - 3 pHandle is not initialized
+ * @note      the hardware alarm is disabled
+ */
+uint8_t mcp794xx_periodic_timer_stop(mcp794xx_handle_t *const pHandle)
+{
+    if(pHandle == NULL)
+        return 2;     /**< return failed error */
+    if(pHandle->inited != 1)
+        return 3;      /**< return failed error */
+
+    a_mcp794xx_alarm_release(pHandle, MCP794XX_ALARM_OWNER_PERIODIC);
+    if(pHandle->periodic.started != 1)
+    {
+        return 0;
+    }
+    pHandle->periodic.started = 0;
+
+    err = mcp794xx_set_alarm_enable_status(pHandle, (mcp794xx_alarm_t)pHandle->periodic.alarm, MCP794XX_BOOL_FALSE);
+    if(err != MCP794XX_DRV_OK)
+    {
+        a_mcp794xx_print_error_msg(pHandle, "periodic timer, disable alarm");
+        return 1;
+    }
+
+    return 0;              /**< success */
+}
+
+/**
+ * @brief  This function returns the first set bit at or above a position
+ * @param[in] u64Mask is the bit mask
+ * @param[in] u8From is the first bit position tried
+ * @return bit position, MCP794XX_CRON_NONE when no bit is set
+ * @note   constant time, six halving steps
+ */
+uint8_t a_mcp794xx_cron_next_bit(uint64_t u64Mask, uint8_t u8From)
+{
+    uint8_t u8Bit = 0;
+
+    if(u8From > 63)
+        return MCP794XX_CRON_NONE;
+    u64Mask &= ~0ULL << u8From;
+    if(u64Mask == 0)
+        return MCP794XX_CRON_NONE;
+
+    if((u64Mask & 0xFFFFFFFFULL) == 0) { u64Mask >>= 32; u8Bit += 32; }
+    if((u64Mask & 0xFFFFULL) == 0)     { u64Mask >>= 16; u8Bit += 16; }
+    if((u64Mask & 0xFFULL) == 0)       { u64Mask >>= 8;  u8Bit += 8; }
+    if((u64Mask & 0xFULL) == 0)        { u64Mask >>= 4;  u8Bit += 4; }
+    if((u64Mask & 0x3ULL) == 0)        { u64Mask >>= 2;  u8Bit += 2; }
+    if((u64Mask & 0x1ULL) == 0)        { u8Bit += 1; }
+
+    return u8Bit;
+}
+
+/**
+ * @brief  This function tells whether exactly one bit is set
+ * @param[in] u64Mask is the bit mask
+ * @return 1 single value, 0 otherwise
+ * @note   none
+ */
+uint8_t a_mcp794xx_cron_single(uint64_t u64Mask)
+{
+    return (u64Mask != 0) && ((u64Mask & (u64Mask - 1)) == 0);
+}
+
+/**
+ * @brief  This function parses a decimal number of a cron field
+ * @param[in,out] ppExpr point to the parse position
+ * @param[out] pValue point to the number
+ * @return status code
+ *          - 0 success
+ *          - 1 no number or larger than 255
+ * @note   none
+ */
+uint8_t a_mcp794xx_cron_number(const char **ppExpr, uint16_t *pValue)
+{
+    const char *pChar = *ppExpr;
+
+    *pValue = 0;
+    if((*pChar < '0') || (*pChar > '9'))
+        return 1;
+    while((*pChar >= '0') && (*pChar <= '9'))
+    {
+        *pValue = (*pValue * 10) + (*pChar - '0');
+        if(*pValue > 255)
+            return 1;
+        pChar++;
+    }
+    *ppExpr = pChar;
+
+    return 0;
+}
+
+/**
+ * @brief  This function parses one cron field into a bit mask
+ * @param[in,out] ppExpr point to the parse position
+ * @param[in] u8Min is the lowest value of the field
+ * @param[in] u8Max is the highest value of the field
+ * @param[out] pMask point to the allowed values, one bit per value
+ * @return status code
+ *          - 0 success
+ *          - 1 invalid field
+ * @note   a step after a single value runs to the end of the field range (5/15 is 5-max/15)
+ */
+uint8_t a_mcp794xx_cron_field(const char **ppExpr, uint8_t u8Min, uint8_t u8Max, uint64_t *pMask)
+{
+    const char *pChar = *ppExpr;
+    uint16_t u16Low;
+    uint16_t u16High;
+    uint16_t u16Step;
+    uint16_t u16Value;
+    uint8_t u8Star;
+
+    *pMask = 0;
+    for(;;)
+    {
+        u8Star = (*pChar == '*');
+        if(u8Star)
+        {
+            u16Low = u8Min;
+            u16High = u8Max;
+            pChar++;
+        }
+        else
+        {
+            if(a_mcp794xx_cron_number(&pChar, &u16Low) != 0)
+                return 1;
+            u16High = u16Low;
+            if(*pChar == '-')
+            {
+                pChar++;
+                if(a_mcp794xx_cron_number(&pChar, &u16High) != 0)
+                    return 1;
+            }
+        }
+        u16Step = 1;
+        if(*pChar == '/')
+        {
+            pChar++;
+            if((a_mcp794xx_cron_number(&pChar, &u16Step) != 0) || (u16Step == 0))
+                return 1;
+            if((u16High == u16Low) && !u8Star)
+                u16High = u8Max;
+        }
+        if((u16Low < u8Min) || (u16High > u8Max) || (u16Low > u16High))
+            return 1;
+        for(u16Value = u16Low; u16Value <= u16High; u16Value += u16Step)
+        {
+            *pMask |= 1ULL << u16Value;
+        }
+        if(*pChar != ',')
+            break;
+        pChar++;
+    }
+    if((*pChar != ' ') && (*pChar != '\0'))
+        return 1;
+    *ppExpr = pChar;
+
+    return 0;
+}
+
+/**
+ * @brief  This function programs the cron deadline in its alarm with the full match mask
+ * @param[in] pHandle points to a mcp794xx handle structure
+ * @return status code
+ *          - 0 success
+ *          - 1 failed
+ * @note   The alarm flag is cleared by the same write. The time is read after the write, a match passed before
+ *         the write landed is skipped and the next one is written.
+ */
+uint8_t a_mcp794xx_cron_rearm(mcp794xx_handle_t *const pHandle)
+{
+    mcp794xx_time_t alarm_time;
+    uint8_t u8Missed;
+    uint32_t u32Now;
+
+    for(;;)
+    {
+        if(a_mcp794xx_epoch_to_alarm_time(pHandle, pHandle->cron.deadline, &alarm_time) != MCP794XX_DRV_OK)
+        {
+            return 1;
+        }
+        if(a_mcp794xx_write_alarm_regs(pHandle, (mcp794xx_alarm_t)pHandle->cron.alarm, &alarm_time,
+                                       MCP794XX_ALARMx_TYPE_MASK | MCP794XX_ALARMx_IF_MASK, (uint8_t)(MCP794XX_MASK_S_M_H_WD_D_M << 4)) != MCP794XX_DRV_OK)
+        {
+            return 1;
+        }
+
+        if(a_mcp794xx_alarm_missed(pHandle, (mcp794xx_alarm_t)pHandle->cron.alarm, pHandle->cron.deadline, &u32Now, &u8Missed) != MCP794XX_DRV_OK)
+        {
+            return 1;
+        }
+        if(u8Missed != 1)
+        {
+            return 0;
+        }
+        if(mcp794xx_cron_next(pHandle, &pHandle->cron.rule, u32Now, &pHandle->cron.deadline) != MCP794XX_DRV_OK)   /**< written too late, skip it */
+        {
+            return 1;
+        }
+    }
+}
+
+/**
+ * @brief      This function compiles a cron expression
+ * @param[in]  pHandle points to mcp794xx pHandle structure
+ * @param[in]  pExpr point to the expression "minute hour day-of-month month day-of-week"
+ * @param[out] pCron point to the compiled rule
+ * @return  status code
+ *            - 0 success
+ *            - 2 pHandle is NULL
+ *            - 3 pHandle is not initialized
+ *            - 4 invalid expression
+ * @note      - Fields accept *, n, a-b, lists (a,b) and steps (x/s), day of week 0 - 7 with 0 and 7 Sunday.
+ *              When both day fields are restricted a day matching either one matches.
+ *            - The cheapest hardware alarm mask whose own matches are exactly the rule is picked:
+ *              "* * * * *" seconds, "m * * * *" minutes, "0 h * * *" hours, "0 0 * * d" week day, "0 0 d * *" date.
+ *              Any other rule uses the full mask, re-programmed with the next match after each interrupt.
+ */
+uint8_t mcp794xx_cron_compile(mcp794xx_handle_t *const pHandle, const char *pExpr, mcp794xx_cron_t *pCron)
+{
+    static const uint8_t field_min[5] = {0, 0, 1, 1, 0};
+    static const uint8_t field_max[5] = {59, 23, 31, 12, 7};
+    uint64_t mask[5];
+    uint8_t index;
+
+    if(pHandle == NULL)
+        return 2;     /**< return failed error */
+    if(pHandle->inited != 1)
+        return 3;      /**< return failed error */
+
+    for(index = 0; index < 5; index++)
+    {
+        while(*pExpr == ' ')
+            pExpr++;
+        if(a_mcp794xx_cron_field(&pExpr, field_min[index], field_max[index], &mask[index]) != 0)
+        {
+            a_mcp794xx_print_error_msg(pHandle, "cron compile, invalid expression");
+            return 4;
+        }
+    }
+    while(*pExpr == ' ')
+        pExpr++;
+    if(*pExpr != '\0')
+    {
+        a_mcp794xx_print_error_msg(pHandle, "cron compile, invalid expression");
+        return 4;
+    }
+
+    memset(pCron, 0, sizeof(mcp794xx_cron_t));
+    pCron->minute = mask[0];
+    pCron->hour = (uint32_t)mask[1];
+    pCron->dom = (uint32_t)mask[2];
+    pCron->month = (uint16_t)mask[3];
+    pCron->dow = (uint8_t)((mask[4] | (mask[4] >> 7)) & MCP794XX_CRON_ALL_DOW);      /**< 7 is Sunday too */
+    pCron->dom_star = (pCron->dom == MCP794XX_CRON_ALL_DOM);                       /**< only a full range leaves a day field free */
+    pCron->dow_star = (pCron->dow == MCP794XX_CRON_ALL_DOW);
+
+    pCron->mask = MCP794XX_MASK_S_M_H_WD_D_M;
+    pCron->hardware = 0;
+    if((pCron->month == MCP794XX_CRON_ALL_MONTH) && pCron->dom_star && pCron->dow_star && (pCron->hour == MCP794XX_CRON_ALL_HOUR) &&
+       (pCron->minute == MCP794XX_CRON_ALL_MINUTE))
+    {
+        pCron->mask = MCP794XX_MASK_SECONDS;                                                  /**< every minute */
+        pCron->hardware = 1;
+    }
+    else if((pCron->month == MCP794XX_CRON_ALL_MONTH) && pCron->dom_star && pCron->dow_star && (pCron->hour == MCP794XX_CRON_ALL_HOUR) &&
+            a_mcp794xx_cron_single(pCron->minute))
+    {
+        pCron->mask = MCP794XX_MASK_MINUTES;                                                  /**< every hour */
+        pCron->hardware = 1;
+    }
+    else if((pCron->month == MCP794XX_CRON_ALL_MONTH) && (pCron->minute == 1) && a_mcp794xx_cron_single(pCron->hour))
+    {
+        if(pCron->dom_star && pCron->dow_star)
+        {
+            pCron->mask = MCP794XX_MASK_HOURS;                                                /**< every day */
+            pCron->hardware = 1;
+        }
+        else if((pCron->hour == 1) && pCron->dom_star && a_mcp794xx_cron_single(pCron->dow))
+        {
+            pCron->mask = MCP794XX_MASK_WDAYS;                                                /**< every week */
+            pCron->hardware = 1;
+        }
+        else if((pCron->hour == 1) && pCron->dow_star && a_mcp794xx_cron_single(pCron->dom))
+        {
+            pCron->mask = MCP794XX_MASK_DATE;                                                 /**< every month */
+            pCron->hardware = 1;
+        }
+    }
+
+    return 0;              /**< success */
+}
+
+/**
+ * @brief      This function returns the first time a cron rule matches after a given time
+ * @param[in]  pHandle points to mcp794xx pHandle structure
+ * @param[in]  pCron point to the compiled rule
+ * @param[in]  u32From_epoch is the time searched from (unix epoch)
+ * @param[out] pNext_epoch point to the next match (unix epoch, second 0)
+ * @return  status code
+ *            - 0 success
+ *            - 2 pHandle is NULL
+ *            - 3 pHandle is not initialized
+ *            - 4 no match (e.g. 30th of February) or beyond the uint32_t epoch range
+ * @note      Each field jumps straight to its next allowed value with a bit scan, a lower field restarts at its
+ *            first allowed value when a higher one moves.
+ */
+uint8_t mcp794xx_cron_next(mcp794xx_handle_t *const pHandle, const mcp794xx_cron_t *pCron, uint32_t u32From_epoch, uint32_t *pNext_epoch)
+{
+    int32_t s32Days;
+    int32_t s32Year;
+    uint8_t u8Month;
+    uint8_t u8Day;
+    uint8_t u8Hour;
+    uint8_t u8Minute;
+    uint8_t u8Dim;
+    uint8_t u8Next;
+    uint8_t u8Dow_next;
+    uint8_t u8Wday;
+    uint16_t u16Step;
+    int64_t s64Epoch;
+
+    if(pHandle == NULL)
+        return 2;     /**< return failed error */
+    if(pHandle->inited != 1)
+        return 3;      /**< return failed error */
+
+    s32Days = (int32_t)(u32From_epoch / 86400);
+    u8Hour = (uint8_t)((u32From_epoch % 86400) / 3600);
+    u8Minute = (uint8_t)(((u32From_epoch % 3600) / 60) + 1);                  /**< strictly after the given minute */
+    mcp794xx_civil_from_days(s32Days, &s32Year, &u8Month, &u8Day);
+
+    for(u16Step = 0; u16Step < MCP794XX_CRON_MAX_STEPS; u16Step++)
+    {
+        u8Next = a_mcp794xx_cron_next_bit(pCron->month, u8Month);
+        if(u8Next != u8Month)
+        {
+            if(u8Next == MCP794XX_CRON_NONE)
+            {
+                s32Year++;
+                u8Next = a_mcp794xx_cron_next_bit(pCron->month, 1);
+            }
+            u8Month = u8Next;
+            u8Day = 1;
+            u8Hour = 0;
+            u8Minute = 0;
+            continue;
+        }
+
+        u8Dim = (uint8_t)(mcp794xx_days_from_civil((u8Month == 12) ? s32Year + 1 : s32Year, (u8Month == 12) ? 1 : u8Month + 1, 1) -
+                          mcp794xx_days_from_civil(s32Year, u8Month, 1));
+        u8Next = a_mcp794xx_cron_next_bit(pCron->dom, u8Day);
+        if(!pCron->dow_star)
+        {
+            u8Wday = (uint8_t)mcp794xx_weekday_from_days(mcp794xx_days_from_civil(s32Year, u8Month, u8Day)) - 1;    /**< 0 is Sunday */
+            u8Dow_next = a_mcp794xx_cron_next_bit(pCron->dow, u8Wday);
+            u8Dow_next = u8Day + ((u8Dow_next != MCP794XX_CRON_NONE) ? (u8Dow_next - u8Wday) :
+                                  (a_mcp794xx_cron_next_bit(pCron->dow, 0) + 7 - u8Wday));
+            u8Next = (pCron->dom_star || (u8Dow_next < u8Next)) ? u8Dow_next : u8Next;                 /**< either day field */
+        }
+        if(u8Next != u8Day)
+        {
+            if((u8Next == MCP794XX_CRON_NONE) || (u8Next > u8Dim))
+            {
+                u8Month = (u8Month == 12) ? 1 : (u8Month + 1);
+                s32Year += (u8Month == 1) ? 1 : 0;
+                u8Next = 1;
+            }
+            u8Day = u8Next;
+            u8Hour = 0;
+            u8Minute = 0;
+            continue;
+        }
+        if(u8Day > u8Dim)
+        {
+            u8Month = (u8Month == 12) ? 1 : (u8Month + 1);
+            s32Year += (u8Month == 1) ? 1 : 0;
+            u8Day = 1;
+            u8Hour = 0;
+            u8Minute = 0;
+            continue;
+        }
+
+        if(u8Minute > 59)
+        {
+            u8Minute = 0;
+            u8Hour++;
+        }
+        u8Next = a_mcp794xx_cron_next_bit(pCron->hour, u8Hour);
+        if(u8Next != u8Hour)
+        {
+            u8Day++;                                                          /**< no hour left today, checked above on the next pass */
+            u8Hour = 0;
+            u8Minute = 0;
+            if(u8Next != MCP794XX_CRON_NONE)
+            {
+                u8Day--;
+                u8Hour = u8Next;
+            }
+            continue;
+        }
+
+        u8Next = a_mcp794xx_cron_next_bit(pCron->minute, u8Minute);
+        if(u8Next == MCP794XX_CRON_NONE)
+        {
+            u8Minute = 60;                                                    /**< next hour */
+            continue;
+        }
+
+        s64Epoch = (int64_t)mcp794xx_days_from_civil(s32Year, u8Month, u8Day) * 86400 + (int64_t)u8Hour * 3600 + (int64_t)u8Next * 60;
+        if((s64Epoch < 0) || (s64Epoch > 0xFFFFFFFFLL))
+        {
+            break;
+        }
+        *pNext_epoch = (uint32_t)s64Epoch;
+
+        return 0;          /**< success */
+    }
+
+    a_mcp794xx_print_error_msg(pHandle, "cron next, no match");
+    return 4;
+}
+
+/**
+ * @brief     This function starts a recurring alarm from a compiled cron rule
+ * @param[in] pHandle points to mcp794xx pHandle structure
+ * @param[in] alarm is the hardware alarm used (ALARM0/ALARM1)
+ * @param[in] pCron point to the compiled rule
+ * @return  status code
+ *            - 0 success
+ *            - 1 failed
+ *            - 2 pHandle is NULL
+ *            - 3 pHandle is not initialized
+ *            - 4 invalid alarm
+ *            - 5 the rule never matches
+ *            - 6 alarm owned by the scheduler or the periodic timer
+ * @note      A rule the hardware mask expresses alone is written once and needs no re-arm. Other rules program the
+ *            next match, mcp794xx_cron_service or mcp794xx_process_events programs the following one.
+ *            Restarting on the other hardware alarm disables the one used before.
+ */
+uint8_t mcp794xx_cron_start(mcp794xx_handle_t *const pHandle, mcp794xx_alarm_t alarm, const mcp794xx_cron_t *pCron)
+{
+    mcp794xx_time_t alarm_time;
+    uint32_t u32Now;
+
+    if(pHandle == NULL)
+        return 2;     /**< return failed error */
+    if(pHandle->inited != 1)
+        return 3;      /**< return failed error */
+
+    if((alarm != MCP794XX_ALARM0) && (alarm != MCP794XX_ALARM1))
+    {
+        a_mcp794xx_print_error_msg(pHandle, "cron start, invalid alarm selected");
+        return 4;
+    }
+    err = a_mcp794xx_alarm_claim(pHandle, alarm, MCP794XX_ALARM_OWNER_CRON);
+    if(err == 1)
+    {
+        a_mcp794xx_print_error_msg(pHandle, "cron start, alarm used by another feature");
+        return 6;
+    }
+    if(err != 0)
+    {
+        a_mcp794xx_print_error_msg(pHandle, "cron start, disable the previous alarm");
+        return 1;
+    }
+
+    pHandle->cron.started = 0;
+    pHandle->cron.rule = *pCron;
+    pHandle->cron.alarm = alarm;
+
+    if(pCron->hardware == 1)
+    {
+        memset(&alarm_time, 0, sizeof(alarm_time));
+        alarm_time.minute = (pCron->mask == MCP794XX_MASK_MINUTES) ? a_mcp794xx_cron_next_bit(pCron->minute, 0) : 0;
+        alarm_time.hour = (pCron->mask == MCP794XX_MASK_HOURS) ? a_mcp794xx_cron_next_bit(pCron->hour, 0) : 0;
+        alarm_time.weekDay = (mcp794xx_week_days_list_t)((pCron->mask == MCP794XX_MASK_WDAYS) ? (a_mcp794xx_cron_next_bit(pCron->dow, 0) + 1) : 1);
+        alarm_time.date = (pCron->mask == MCP794XX_MASK_DATE) ? a_mcp794xx_cron_next_bit(pCron->dom, 1) : 1;
+        alarm_time.month = (mcp794xx_months_list_t)1;
+        a_mcp794xx_alarm_hour_format(pHandle, &alarm_time);
+
+        err = a_mcp794xx_write_alarm_regs(pHandle, alarm, &alarm_time, MCP794XX_ALARMx_TYPE_MASK | MCP794XX_ALARMx_IF_MASK,
+                                          (uint8_t)(pCron->mask << 4));
+    }
+    else
+    {
+        err = a_mcp794xx_now_epoch(pHandle, &u32Now);
+        if(err)
+        {
+            a_mcp794xx_print_error_msg(pHandle, "cron start, read time");
+            return 1;
+        }
+        if(mcp794xx_cron_next(pHandle, pCron, u32Now, &pHandle->cron.deadline) != MCP794XX_DRV_OK)
+        {
+            return 5;
+        }
+        err = a_mcp794xx_cron_rearm(pHandle);
+    }
+    if(err)
+    {
+        a_mcp794xx_print_error_msg(pHandle, "cron start, write alarm");
+        return 1;
+    }
+
+    err = mcp794xx_set_alarm_enable_status(pHandle, alarm, MCP794XX_BOOL_TRUE);
+    if(err != MCP794XX_DRV_OK)
+    {
+        a_mcp794xx_print_error_msg(pHandle, "cron start, enable alarm");
+        return 1;
+    }
+    pHandle->cron.started = 1;
+    pHandle->alarm_owner[alarm] = MCP794XX_ALARM_OWNER_CRON;
+
+    return 0;              /**< success */
+}
+
+/**
+ * @brief     This function services the cron alarm after its interrupt
+ * @param[in] pHandle points to mcp794xx pHandle structure
+ * @return  status code
+ *            - 0 success
+ *            - 1 failed
+ *            - 2 pHandle is NULL
+ *            - 3 pHandle is not initialized
+ *            - 4 cron alarm not started
+ * @note      A hardware mask rule only has its flag cleared. Other rules program the first match after both the one
+ *            that fired and the current time in one read-modify-write of the alarm registers, which also clears the
+ *            flag. The time comes from the interpolated clock when anchored (mcp794xx_clock_anchor), otherwise it
+ *            is read once. The time is read back after the write, a match passed before the write landed (service
+ *            at hh:mm:59) is skipped and the next one is written.
+ */
+uint8_t mcp794xx_cron_service(mcp794xx_handle_t *const pHandle)
+{
+    int64_t s64Now_ms;
+    uint32_t u32Now;
+
+    if(pHandle == NULL)
+        return 2;     /**< return failed error */
+    if(pHandle->inited != 1)
+        return 3;      /**< return failed error */
+
+    if(pHandle->cron.started != 1)
+    {
+        a_mcp794xx_print_error_msg(pHandle, "cron service, cron alarm not started");
+        return 4;
+    }
+
+    if(pHandle->cron.rule.hardware == 1)
+    {
+        err = mcp794xx_clr_alarm_interrupt_flag(pHandle, (mcp794xx_alarm_t)pHandle->cron.alarm);
+    }
+    else
+    {
+        if((pHandle->clock.valid == 1) && (mcp794xx_clock_now(pHandle, &s64Now_ms) == MCP794XX_DRV_OK))
+        {
+            u32Now = (uint32_t)(s64Now_ms / 1000);
+        }
+        else if(a_mcp794xx_now_epoch(pHandle, &u32Now) != MCP794XX_DRV_OK)
+        {
+            a_mcp794xx_print_error_msg(pHandle, "cron service, read time");
+            return 1;
+        }
+        if(u32Now < pHandle->cron.deadline)
+        {
+            u32Now = pHandle->cron.deadline;                                  /**< serviced before the alarm second ended */
+        }
+        err = mcp794xx_cron_next(pHandle, &pHandle->cron.rule, u32Now, &pHandle->cron.deadline);   /**< missed matches skipped */
+        if(err == MCP794XX_DRV_OK)
+            err = a_mcp794xx_cron_rearm(pHandle);
+    }
+    if(err)
+    {
+        a_mcp794xx_print_error_msg(pHandle, "cron service");
+        return 1;
+    }
+
+    return 0;              /**< success */
+}
+
+/**
+ * @brief     This function stops the cron alarm
+ * @param[in] pHandle points to mcp794xx pHandle structure
+ * @return  status code
+ *            - 0 success
+ *            - 1 failed
+ *            - 2 pHandle is NULL
+ *            - 3 pHandle is not initialized
+ * @note      the hardware alarm is disabled
+ */
+uint8_t mcp794xx_cron_stop(mcp794xx_handle_t *const pHandle)
+{
+    if(pHandle == NULL)
+        return 2;     /**< return failed error */
+    if(pHandle->inited != 1)
+        return 3;      /**< return failed error */
+
+    a_mcp794xx_alarm_release(pHandle, MCP794XX_ALARM_OWNER_CRON);
+    if(pHandle->cron.started != 1)
+    {
+        return 0;
+    }
+    pHandle->cron.started = 0;
+
+    err = mcp794xx_set_alarm_enable_status(pHandle, (mcp794xx_alarm_t)pHandle->cron.alarm, MCP794XX_BOOL_FALSE);
+    if(err != MCP794XX_DRV_OK)
+    {
+        a_mcp794xx_print_error_msg(pHandle, "cron stop, disable alarm");
+        return 1;
+    }
+
+    return 0;              /**< success */
+}
+
+/**
+ * @brief     This function queues an alarm interrupt event, for use in the MFP interrupt service routine
+ * @param[in] pHandle points to mcp794xx pHandle structure
+ * @return  status code
+ *            - 0 success
+ *            - 2 pHandle is NULL
+ *            - 3 pHandle is not initialized
+ *            - 4 queue full, the event is dropped
+ * @note      - No bus access and no blocking call, mcp794xx_process_events does the i2c work later.
+ *            - Single producer: call from one interrupt only. The event is time stamped with get_tick_ms when linked.
+ *            - A dropped event loses nothing as long as one is queued, the flags are read when the queue is drained.
+ */
+uint8_t mcp794xx_irq_post(mcp794xx_handle_t *const pHandle)
+{
+    mcp794xx_event_queue_t *pQueue;
+    uint8_t u8Head;
+
+    if(pHandle == NULL)
+        return 2;     /**< return failed error */
+    if(pHandle->inited != 1)
+        return 3;      /**< return failed error */
+
+    pQueue = &pHandle->events;
+    u8Head = pQueue->head;
+    if((uint8_t)(u8Head - pQueue->tail) >= MCP794XX_EVENT_QUEUE_SIZE)
+    {
+        pQueue->dropped++;
+        return 4;
+    }
+
+    pQueue->tick[u8Head & (MCP794XX_EVENT_QUEUE_SIZE - 1)] = (pHandle->get_tick_ms != NULL) ? pHandle->get_tick_ms() : 0;
+    pQueue->head = u8Head + 1;                                            /**< publish after the slot is written */
+
+    return 0;              /**< success */
+}
+
+/**
+ * @brief      This function drains the alarm event queue and does the deferred i2c work
+ * @param[in]  pHandle points to mcp794xx pHandle structure
+ * @param[out] pServiced point to the alarms serviced (MCP794XX_IRQ_ALARM0_FLAG | MCP794XX_IRQ_ALARM1_FLAG), can be NULL
+ * @param[out] pTick point to the time stamp of the oldest event drained, can be NULL
+ * @return  status code
+ *            - 0 success, nothing queued or events serviced
+ *            - 1 failed to service the alarms
+ *            - 2 pHandle is NULL
+ *            - 3 pHandle is not initialized
+ * @note      - Call from thread context (main loop or task). Single consumer.
+ *            - Any number of queued events is serviced with one mcp794xx_irq_service call, then the scheduler
+ *              (mcp794xx_sched_start), the periodic timer (mcp794xx_periodic_timer_start) and the cron alarm
+ *              (mcp794xx_cron_start) owning a serviced alarm are re-armed.
+ */
+uint8_t mcp794xx_process_events(mcp794xx_handle_t *const pHandle, uint8_t *pServiced, uint32_t *pTick)
+{
+    mcp794xx_event_queue_t *pQueue;
+    uint8_t u8Head;
+    uint8_t u8Serviced = 0;
+
+    if(pHandle == NULL)
+        return 2;     /**< return failed error */
+    if(pHandle->inited != 1)
+        return 3;      /**< return failed error */
+
+    if(pServiced != NULL)
+        *pServiced = 0;
+
+    pQueue = &pHandle->events;
+    u8Head = pQueue->head;
+    if(u8Head == pQueue->tail)
+    {
+        return 0;   /**< nothing queued */
+    }
+    if(pTick != NULL)
+        *pTick = pQueue->tick[pQueue->tail & (MCP794XX_EVENT_QUEUE_SIZE - 1)];
+    pQueue->tail = u8Head;                                                /**< drained before the flags are read, a later interrupt queues again */
+
+    err = mcp794xx_irq_service(pHandle, &u8Serviced);
+    if(err)
+    {
+        a_mcp794xx_print_error_msg(pHandle, "process events, service alarms");
+        return 1;
+    }
+
+    if((pHandle->sched.started == 1) && (u8Serviced & (1U << pHandle->sched.alarm)))
+    {
+        err = a_mcp794xx_sched_run(pHandle);
+        if(err)
+        {
+            a_mcp794xx_print_error_msg(pHandle, "process events, scheduler");
+            return 1;
+        }
+    }
+    if((pHandle->periodic.started == 1) && (u8Serviced & (1U << pHandle->periodic.alarm)))
+    {
+        err = mcp794xx_periodic_timer_service(pHandle);
+        if(err)
+        {
+            a_mcp794xx_print_error_msg(pHandle, "process events, periodic timer");
+            return 1;
+        }
+    }
+    if((pHandle->cron.started == 1) && (pHandle->cron.rule.hardware != 1) && (u8Serviced & (1U << pHandle->cron.alarm)))
+    {
+        err = mcp794xx_cron_service(pHandle);
+        if(err)
+        {
+            a_mcp794xx_print_error_msg(pHandle, "process events, cron alarm");
+            return 1;
+        }
+    }
+
+    if(pServiced != NULL)
+        *pServiced = u8Serviced;
+
+    return 0;              /**< success */
+}
+
+/**
+ * @brief     This function get the device unique identifier
+ * @param[in] *pHandle points to mcp794xx pHandle structure
+ * @param[out] pUID point to the device Unique ID
+ * @return  status code
+ *            - 0 success
+ *            - 1 failed to get S/N
+ *            - 2 pHandle is NULL
+ *            - 3 pHandle is not initialized
+ * @note      none
+ */
+uint8_t mcp794xx_uid_read(mcp794xx_handle_t *const pHandle, uint8_t *pUID)
+{
+    uint8_t temp_buffer[UID_MAX_LENGTH];
+
+    if(pHandle == NULL)
+        return 2;     /**< return failed error */
+    if(pHandle->inited != 1)
+        return 3;      /**< return failed error */
+
+    memset(temp_buffer, 0x00, sizeof(temp_buffer));                 /**< clear buffer before read */
+
+    switch(pHandle->device_variant)
+    {
+        case MCP79400_VARIANT:
+        {
+            a_mcp794xx_print_error_msg(pHandle, "failed to read UID, unsupported cmd for mcp79400 variant");
+            return 1;           /**< failed error */
+            break;
+        }
+
+        case MCP79401_VARIANT:
+        {
+            err = eeprom_mcp794xx_i2c_read(pHandle, EEPROM_UID_ADDRESS + 2, (uint8_t *)temp_buffer, UID_MAX_LENGTH - 2);
+            if(err)
+            {
+                a_mcp794xx_print_error_msg(pHandle, "failed to read UID");
+                return 1;           /**< failed error */
+            }
+            memcpy((uint8_t *)pUID, (uint8_t *)temp_buffer, sizeof(temp_buffer) - 2);
+            break;
+        }
+
+        case MCP79402_VARIANT:
+        {
+            err = eeprom_mcp794xx_i2c_read(pHandle, EEPROM_UID_ADDRESS, (uint8_t *)temp_buffer, UID_MAX_LENGTH);
+            if(err)
+            {
+                a_mcp794xx_print_error_msg(pHandle, "failed to read UID");
+                return 1;           /**< failed error */
+            }
+            memcpy((uint8_t *)pUID, (uint8_t *)temp_buffer, sizeof(temp_buffer));
+            break;
+        }
+
+        case MCP7940M_VARIANT:
+        {
+            a_mcp794xx_print_error_msg(pHandle, "failed to read UID, unsupported cmd for mcp7940m variant");
+            return 1;           /**< failed error */
+            break;
+        }
+
+        case MCP7940N_VARIANT:
+        {
+            a_mcp794xx_print_error_msg(pHandle, "failed to read UID, unsupported cmd for mcp7940n variant");
+            return 1;           /**< failed error */
+            break;
+        }
+
+        case MCP79410_VARIANT:
+        {
+            a_mcp794xx_print_error_msg(pHandle, "failed to read UID, unsupported cmd for mcp79410 variant");
+            return 1;           /**< failed error */
+            break;
+        }
+
+        case MCP79411_VARIANT:
+        {
+            err = eeprom_mcp794xx_i2c_read(pHandle, EEPROM_UID_ADDRESS + 2, (uint8_t *)temp_buffer, UID_MAX_LENGTH - 2);
+            if(err)
+            {
+                a_mcp794xx_print_error_msg(pHandle, "failed to read UID");
+                return 1;           /**< failed error */
+            }
+            memcpy((uint8_t *)pUID, (uint8_t *)temp_buffer, sizeof(temp_buffer) - 2);
+            break;
+        }
+
+        case MCP79412_VARIANT:
+        {
+            err = eeprom_mcp794xx_i2c_read(pHandle, EEPROM_UID_ADDRESS, (uint8_t *)temp_buffer, UID_MAX_LENGTH);
+            if(err)
+            {
+                a_mcp794xx_print_error_msg(pHandle, "failed to read UID");
+                return 1;           /**< failed error */
+            }
+            memcpy((uint8_t *)pUID, (uint8_t *)temp_buffer, sizeof(temp_buffer));
+            break;
+        }
+
+    }
+
+    return 0;              /**< success */
+}
+
+/**
+* @brief This function write data bytes to sram
+* @param[in] *pHandle points to mcp794xx handle structure
+* @param[in] addr is the register address to write to
+* @param[in] *pBuffer point to data to write
+* @param[in] length is the number of bytes the write
+* @return status code
+*          - 0 success
+*          - 1 failed to write
+*          - 2 pHandle is NULL
+*          - 3 pHandle is not initialized
+*          - 4 invalid address
+* @note none
+*/
+uint8_t mcp794xx_sram_write_byte(mcp794xx_handle_t *const pHandle, uint8_t addr, uint8_t *pBuffer, size_t length)
+{
+
+    if(pHandle == NULL)
+        return 2;     /**< return failed error */
+    if(pHandle->inited != 1)
+        return 3;      /**< return failed error */
+
+    if(addr > SRAM_LAST_ADDRESS || addr < SRAM_FIRST_ADDRESS)
+    {
+    	a_mcp794xx_print_error_msg(pHandle, "write sram, invalid address");
+    	return 4;
+    }if(length > SRAM_MEMORY_SIZE){
+    	a_mcp794xx_print_error_msg(pHandle, "write sram, address can't be greater than 0x5F");
+    	return 5;
+    }if((addr - SRAM_FIRST_ADDRESS)+ length > SRAM_MEMORY_SIZE){
+    	a_mcp794xx_print_error_msg(pHandle, "write sram, address out of range");
+    	return 5;
+    }
+
+    err = sram_mcp794xx_i2c_write(pHandle, addr, (uint8_t *)pBuffer, length);
+    if(err)
+    {
+       a_mcp794xx_print_error_msg(pHandle, "write to sram");
+       return 1;
+    }
+	return 0;          /**< success */
+}
+
+/**
+* @brief This function reads data bytes from sram
+* @param[in] *pHandle points to mcp794xx handle structure
+* @param[in] addr is the register address to write to
+* @param[out] *pBuffer point to data to read
+* @param[in] length is the number of bytes the read
+* @return status code
+*          - 0 success
+*          - 1 failed to read
+*          - 2 pHandle is NULL
+*          - 3 pHandle is not initialized
+*          - 4 invalid address
+* @note none
+*/
+uint8_t mcp794xx_sram_read_byte(mcp794xx_handle_t *const pHandle, uint8_t addr, uint8_t *pBuffer, size_t length)
+{
+
+    if(pHandle == NULL)
+        return 2;     /**< return failed error */
+    if(pHandle->inited != 1)
+        return 3;      /**< return failed error */
+
+    if(addr > SRAM_LAST_ADDRESS || addr < SRAM_FIRST_ADDRESS)
+    {
+    	a_mcp794xx_print_error_msg(pHandle, "read sram, invalid address");
+    	return 4;
+    }if(length > SRAM_MEMORY_SIZE){
+    	a_mcp794xx_print_error_msg(pHandle, "read sram, address can't be greater than 0x5F");
+    	return 5;
+    }if((addr - SRAM_FIRST_ADDRESS)+ length > SRAM_MEMORY_SIZE){
+    	a_mcp794xx_print_error_msg(pHandle, "read sram, address out of range");
+    	return 5;
+    }
+
+    err = rtc_mcp794xx_i2c_read(pHandle, addr, (uint8_t *)pBuffer, length);
+    if(err)
+    {
+       a_mcp794xx_print_error_msg(pHandle, "read sram");
+       return 1;
+    }
+
+ return 0;          /**< success */
+}
+
+/**
+* @brief This function fills a range of the sram with a pattern
+* @param[in] *pHandle points to mcp794xx handle structure
+* @param[in] start_addr is the first register address to fill
+* @param[in] end_addr is the last register address to fill
+* @param[in] u8Pattern is the byte written
+* @return status code
+*          - 0 success
+*          - 1 failed to write
+*          - 2 pHandle is NULL
+*          - 3 pHandle is not initialized
+*          - 4 invalid address
+* @note one burst write from the handle staging buffer
+*/
+uint8_t mcp794xx_sram_fill(mcp794xx_handle_t *const pHandle, uint8_t start_addr, uint8_t end_addr, uint8_t u8Pattern)
+{
+    if(pHandle == NULL)
+        return 2;     /**< return failed error */
+    if(pHandle->inited != 1)
+        return 3;      /**< return failed error */
+
+    if(start_addr > SRAM_LAST_ADDRESS || start_addr < SRAM_FIRST_ADDRESS || end_addr > SRAM_LAST_ADDRESS || end_addr < start_addr)
+    {
+    	a_mcp794xx_print_error_msg(pHandle, "fill sram, invalid address (0x20 - 0x5F)");
+    	return 4;
+    }
+
+    memset(&pHandle->sram_staging[1], u8Pattern, (end_addr - start_addr) + 1);
+    err = a_mcp794xx_sram_burst(pHandle, start_addr, (end_addr - start_addr) + 1);
+    if(err)
+    {
+       a_mcp794xx_print_error_msg(pHandle, "fill sram");
+       return 1;
+    }
+
+	return 0;   /**< success */
+}
+
+/**
+* @brief This function erases a sector of the sram
+* @param[in] *pHandle points to mcp794xx handle structure
+* @param[in] start_addr is the first register address erase
+* @param[in] end_addr is the last register address erase
+* @return status code
+*          - 0 success
+*          - 1 failed to write
+*          - 2 pHandle is NULL
+*          - 3 pHandle is not initialized
+*          - 4 invalid address
+* @note data from the start to the end address will be erased, in one burst write
+*/
+uint8_t mcp794xx_sram_erase_selector(mcp794xx_handle_t *const pHandle, uint8_t start_addr, uint8_t end_addr)
+{
+    return mcp794xx_sram_fill(pHandle, start_addr, end_addr, 0x00);
+}
+
+/**
+* @brief This function wipes the entire sram memory
+* @param[in] *pHandle points to mcp794xx handle structure
+* @return status code
+*          - 0 success
+*          - 1 failed to write
+*          - 2 pHandle is NULL
+*          - 3 pHandle is not initialized
+* @note one burst write
+*/
+uint8_t mcp794xx_wipe_sram(mcp794xx_handle_t *const pHandle)
+{
+    return mcp794xx_sram_fill(pHandle, SRAM_FIRST_ADDRESS, SRAM_LAST_ADDRESS, 0x00);
+}
+
+/**
+* @brief This function copies a block of sram to another sram address
+* @param[in] *pHandle points to mcp794xx handle structure
+* @param[in] dst_addr is the destination address
+* @param[in] src_addr is the source address
+* @param[in] length is the number of bytes to copy
+* @return status code
+*          - 0 success
+*          - 1 failed to read or write
+*          - 2 pHandle is NULL
+*          - 3 pHandle is not initialized
+*          - 4 invalid address
+*          - 5 address out of range
+* @note The block is read in one burst then written in one burst, overlapping ranges are moved correctly.
+*/
+uint8_t mcp794xx_sram_copy(mcp794xx_handle_t *const pHandle, uint8_t dst_addr, uint8_t src_addr, uint8_t length)
+{
+    if(pHandle == NULL)
+        return 2;     /**< return failed error */
+    if(pHandle->inited != 1)
+        return 3;      /**< return failed error */
+
+    if(dst_addr > SRAM_LAST_ADDRESS || dst_addr < SRAM_FIRST_ADDRESS || src_addr > SRAM_LAST_ADDRESS || src_addr < SRAM_FIRST_ADDRESS)
+    {
+    	a_mcp794xx_print_error_msg(pHandle, "copy sram, invalid address (0x20 - 0x5F)");
+    	return 4;
+    }if(((dst_addr - SRAM_FIRST_ADDRESS) + length > SRAM_MEMORY_SIZE) || ((src_addr - SRAM_FIRST_ADDRESS) + length > SRAM_MEMORY_SIZE)){
+    	a_mcp794xx_print_error_msg(pHandle, "copy sram, address out of range");
+    	return 5;
+    }
+    if((length == 0) || (dst_addr == src_addr))
+    {
+        return 0;   /**< nothing to copy */
+    }
+
+    err = rtc_mcp794xx_i2c_read(pHandle, src_addr, (uint8_t *)&pHandle->sram_staging[1], length);
+    if(err)
+    {
+       a_mcp794xx_print_error_msg(pHandle, "copy sram, read");
+       return 1;
+    }
+    err = a_mcp794xx_sram_burst(pHandle, dst_addr, length);
+    if(err)
+    {
+       a_mcp794xx_print_error_msg(pHandle, "copy sram, write");
+       return 1;
+    }
+
+	return 0;   /**< success */
+}
+
+/**
+* @brief This function returns the number of record slots an sram log range holds
+* @param[in] start_addr is the first sram address of the log
+* @param[in] end_addr is the last sram address of the log
+* @param[in] record_size is the payload size of one record
+* @return number of slots, 0 if the range is invalid
+* @note none
+*/
+uint8_t a_mcp794xx_sram_log_geometry(uint8_t start_addr, uint8_t end_addr, uint8_t record_size)
+{
+    if((start_addr < SRAM_FIRST_ADDRESS) || (end_addr > SRAM_LAST_ADDRESS) || (end_addr < start_addr + 2) || (record_size == 0)
+       || (record_size >= SRAM_MEMORY_SIZE))
+    {
+        return 0;
+    }
+    return ((end_addr - start_addr) - 1) / (record_size + 1);
+}
+
+/**
+* @brief This function reads the sram log in one burst and recovers its head
+* @param[in] *pHandle points to mcp794xx handle structure
+* @param[out] *pBuffer points to the record buffer, oldest first, may be NULL
+* @return status code
+*          - 0 success
+*          - 1 failed to read
+*          - 6 log header not found
+* @note the newest record is the one whose next slot does not carry the following stamp
+*/
+uint8_t a_mcp794xx_sram_log_scan(mcp794xx_handle_t *const pHandle, uint8_t *pBuffer)
+{
+    mcp794xx_sram_log_t *pLog = &pHandle->sram_log;
+    uint8_t u8Slot_size = pLog->record_size + 1;
+    uint8_t *pSlots = &pHandle->sram_staging[3];
+    uint8_t u8Newest = 0;
+    uint8_t u8Oldest;
+    uint8_t u8Seq;
+    uint8_t u8Next;
+    uint8_t index;
+
+    pLog->mounted = 0;
+    if(rtc_mcp794xx_i2c_read(pHandle, pLog->base, &pHandle->sram_staging[1], (pLog->end - pLog->base) + 1) != MCP794XX_DRV_OK)
+    {
+        return 1;
+    }
+    if((pHandle->sram_staging[1] != MCP794XX_SRAM_LOG_MAGIC) || (pHandle->sram_staging[2] != pLog->record_size))
+    {
+        return 6;
+    }
+
+    pLog->count = 0;
+    pLog->seq = 0;
+    for(index = 0; index < pLog->slots; index++)
+    {
+        u8Seq = pSlots[(index * u8Slot_size) + pLog->record_size];
+        if(u8Seq == 0)
+        {
+            continue;                                                        /**< empty slot */
+        }
+        pLog->count++;
+        u8Next = pSlots[(((index + 1) % pLog->slots) * u8Slot_size) + pLog->record_size];
+        if((pLog->seq == 0) && (u8Next != ((u8Seq == 0xFF) ? 1 : (u8Seq + 1))))
+        {
+            u8Newest = index;
+            pLog->seq = u8Seq;
+        }
+    }
+    pLog->head = (pLog->count == 0) ? 0 : ((u8Newest + 1) % pLog->slots);
+    pLog->mounted = 1;
+
+    if(pBuffer != NULL)
+    {
+        u8Oldest = (pLog->head + pLog->slots - pLog->count) % pLog->slots;
+        for(index = 0; index < pLog->count; index++)
+        {
+            memcpy(&pBuffer[index * pLog->record_size], &pSlots[((u8Oldest + index) % pLog->slots) * u8Slot_size], pLog->record_size);
+        }
+    }
+
+    return 0;
+}
+
+/**
+* @brief This function formats an sram range as an empty event log
+* @param[in] *pHandle points to mcp794xx handle structure
+* @param[in] start_addr is the first sram address of the log
+* @param[in] end_addr is the last sram address of the log
+* @param[in] record_size is the payload size of one record (bytes)
+* @return status code
+*          - 0 success
+*          - 1 failed to read or write
+*          - 2 pHandle is NULL
+*          - 3 pHandle is not initialized
+*          - 4 invalid range or record size (at least two records must fit)
+* @note the range holds a 2 byte header then slots of record_size + 1 bytes, the whole range is written in one burst
+*/
+uint8_t mcp794xx_sram_log_format(mcp794xx_handle_t *const pHandle, uint8_t start_addr, uint8_t end_addr, uint8_t record_size)
+{
+    uint8_t u8Length;
+
+    if(pHandle == NULL)
+        return 2;     /**< return failed error */
+    if(pHandle->inited != 1)
+        return 3;      /**< return failed error */
+
+    if(a_mcp794xx_sram_log_geometry(start_addr, end_addr, record_size) < 2)
+    {
+    	a_mcp794xx_print_error_msg(pHandle, "format sram log, invalid range or record size");
+    	return 4;
+    }
+
+    u8Length = (end_addr - start_addr) + 1;
+    memset(&pHandle->sram_staging[1], 0x00, u8Length);
+    pHandle->sram_staging[1] = MCP794XX_SRAM_LOG_MAGIC;
+    pHandle->sram_staging[2] = record_size;
+    err = a_mcp794xx_sram_burst(pHandle, start_addr, u8Length);
+    if(err)
+    {
+       a_mcp794xx_print_error_msg(pHandle, "format sram log");
+       pHandle->sram_log.mounted = 0;
+       return 1;
+    }
+
+    pHandle->sram_log.base = start_addr;
+    pHandle->sram_log.end = end_addr;
+    pHandle->sram_log.record_size = record_size;
+    pHandle->sram_log.slots = a_mcp794xx_sram_log_geometry(start_addr, end_addr, record_size);
+    pHandle->sram_log.head = 0;
+    pHandle->sram_log.seq = 0;
+    pHandle->sram_log.count = 0;
+    pHandle->sram_log.mounted = 1;
+
+	return 0;   /**< success */
+}
+
+/**
+* @brief This function mounts an event log kept in sram
+* @param[in] *pHandle points to mcp794xx handle structure
+* @param[in] start_addr is the first sram address of the log
+* @param[in] end_addr is the last sram address of the log
+* @param[in] record_size is the payload size of one record (bytes)
+* @return status code
+*          - 0 success
+*          - 1 failed to read or write
+*          - 2 pHandle is NULL
+*          - 3 pHandle is not initialized
+*          - 4 invalid range or record size
+*          - 6 no log with this record size found, format it first
+* @note one burst read, the head is recovered from the record sequence stamps
+*/
+uint8_t mcp794xx_sram_log_mount(mcp794xx_handle_t *const pHandle, uint8_t start_addr, uint8_t end_addr, uint8_t record_size)
+{
+    if(pHandle == NULL)
+        return 2;     /**< return failed error */
+    if(pHandle->inited != 1)
+        return 3;      /**< return failed error */
+
+    if(a_mcp794xx_sram_log_geometry(start_addr, end_addr, record_size) < 2)
+    {
+    	a_mcp794xx_print_error_msg(pHandle, "mount sram log, invalid range or record size");
+    	return 4;
+    }
+
+    pHandle->sram_log.base = start_addr;
+    pHandle->sram_log.end = end_addr;
+    pHandle->sram_log.record_size = record_size;
+    pHandle->sram_log.slots = a_mcp794xx_sram_log_geometry(start_addr, end_addr, record_size);
+
+    err = a_mcp794xx_sram_log_scan(pHandle, NULL);
+    if(err == 1)
+    {
+       a_mcp794xx_print_error_msg(pHandle, "mount sram log");
+    }else if(err == 6)
+    {
+       a_mcp794xx_print_error_msg(pHandle, "mount sram log, no log found");
+    }
+
+	return err;
+}
+
+/**
+* @brief This function appends one record to the sram event log
+* @param[in] *pHandle points to mcp794xx handle structure
+* @param[in] *pRecord points to record_size bytes to log
+* @return status code
+*          - 0 success
+*          - 1 failed to read or write
+*          - 2 pHandle is NULL
+*          - 3 pHandle is not initialized
+*          - 5 log not mounted
+* @note one burst write, the payload then its stamp. Once the log is full the oldest record is overwritten
+*       and its stamp is cleared first by a one byte write, so a reset during the burst leaves an empty slot.
+*/
+uint8_t mcp794xx_sram_log_append(mcp794xx_handle_t *const pHandle, const uint8_t *pRecord)
+{
+    mcp794xx_sram_log_t *pLog;
+    uint8_t u8Seq;
+    uint8_t u8Addr;
+
+    if(pHandle == NULL)
+        return 2;     /**< return failed error */
+    if(pHandle->inited != 1)
+        return 3;      /**< return failed error */
+
+    pLog = &pHandle->sram_log;
+    if(pLog->mounted != 1)
+    {
+    	a_mcp794xx_print_error_msg(pHandle, "append sram log, log not mounted");
+    	return 5;
+    }
+
+    u8Addr = pLog->base + 2 + (pLog->head * (pLog->record_size + 1));
+    if(pLog->count == pLog->slots)
+    {
+        pHandle->sram_staging[1] = 0;                                              /**< the overwritten record is dropped first */
+        err = a_mcp794xx_sram_burst(pHandle, u8Addr + pLog->record_size, 1);
+        if(err)
+        {
+           a_mcp794xx_print_error_msg(pHandle, "append sram log, clear stamp");
+           return 1;
+        }
+        pLog->count--;
+    }
+
+    u8Seq = (pLog->seq == 0xFF) ? 1 : (pLog->seq + 1);                 /**< 0 marks an empty slot */
+    memcpy(&pHandle->sram_staging[1], pRecord, pLog->record_size);
+    pHandle->sram_staging[1 + pLog->record_size] = u8Seq;                          /**< stamp written last, a torn record stays empty */
+    err = a_mcp794xx_sram_burst(pHandle, u8Addr, pLog->record_size + 1);
+    if(err)
+    {
+       a_mcp794xx_print_error_msg(pHandle, "append sram log");
+       return 1;
+    }
+
+    pLog->seq = u8Seq;
+    pLog->head = (pLog->head + 1) % pLog->slots;
+    if(pLog->count < pLog->slots)
+    {
+    	pLog->count++;
+    }
+
+	return 0;   /**< success */
+}
+
+/**
+* @brief This function reads every record of the sram event log
+* @param[in] *pHandle points to mcp794xx handle structure
+* @param[out] *pBuffer points to a buffer of at least slots * record_size bytes
+* @param[out] *pCount points to the number of records copied
+* @return status code
+*          - 0 success
+*          - 1 failed to read or write
+*          - 2 pHandle is NULL
+*          - 3 pHandle is not initialized
+*          - 5 log not mounted
+*          - 6 log header lost
+* @note one burst read, records are copied oldest first, the log is left unchanged
+*/
+uint8_t mcp794xx_sram_log_drain(mcp794xx_handle_t *const pHandle, uint8_t *pBuffer, uint8_t *pCount)
+{
+    if(pHandle == NULL)
+        return 2;     /**< return failed error */
+    if(pHandle->inited != 1)
+        return 3;      /**< return failed error */
+
+    if(pHandle->sram_log.mounted != 1)
+    {
+    	a_mcp794xx_print_error_msg(pHandle, "drain sram log, log not mounted");
+    	return 5;
+    }
+
+    err = a_mcp794xx_sram_log_scan(pHandle, pBuffer);
+    if(err)
+    {
+       a_mcp794xx_print_error_msg(pHandle, "drain sram log");
+       *pCount = 0;
+       return err;
+    }
+    *pCount = pHandle->sram_log.count;
+
+	return 0;   /**< success */
+}
+
+/**
+ * @brief     This function writes to the eeprom, retrying while a write cycle is in progress
+ * @param[in] pHandle points to mcp794xx handle structure
+ * @param[in] u8Addr is the eeprom address to write to
+ * @param[in] *pBuf points to data buffer to be written, can be NULL when u8Length is 0
+ * @param[in] u8Length is the data buffer length, 0 only sends the address
+ * @return    status code
+ *            - 0 success, the eeprom acknowledged
+ *            - 1 timeout
+ * @note      The eeprom does not acknowledge its address during a write cycle, a refused transfer is
+ *            retried 1 ms apart up to eeprom_timeout_ms.
+ */
+uint8_t a_mcp794xx_eeprom_write_retry(mcp794xx_handle_t *const pHandle, uint8_t u8Addr, uint8_t *pBuf, uint8_t u8Length)
+{
+    uint16_t u16Timeout = 0;
+
+    for(;;)
+    {
+        if(eeprom_mcp794xx_i2c_write(pHandle, u8Addr, pBuf, u8Length) == MCP794XX_DRV_OK)
+        {
+            return 0;           /**< acknowledged */
+        }
+
+        if(u16Timeout >= pHandle->eeprom_timeout_ms)
+        {
+            return 1;           /**< timeout */
+        }
+
+        if(pHandle->delay_ms != NULL)
+        {
+            pHandle->delay_ms(1);
+        }
+        u16Timeout++;
+    }
+}
+
+/**
+ * @brief     This function waits for the end of an eeprom write cycle
+ * @param[in] pHandle points to mcp794xx handle structure
+ * @param[in] u8Addr is the address sent with each poll
+ * @return    status code
+ *            - 0 success, the eeprom acknowledged
+ *            - 1 timeout
+ * @note      Each poll only sends the address byte, it moves the address pointer and nothing is written.
+ */
+uint8_t a_mcp794xx_eeprom_ack_poll(mcp794xx_handle_t *const pHandle, uint8_t u8Addr)
+{
+    return a_mcp794xx_eeprom_write_retry(pHandle, u8Addr, NULL, 0);
+}
+
+/**
+ * @brief     This function write n byte to eeprom
+ * @param[in] pHandle points to mcp794xx handle structure
+ * @param[in] addr is the eeprom address to write to
+ * @param[in] *buf points to data buffer to be written
+ * @param[in] length is the data buffer length
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 invalid address
+ *            - 5 attempt to write a protected block array
+ *            - 6 data length is larger than page size
+ *            - 7 write cycle did not complete within the timeout
+ * @note      The eeprom has a 5ms write cycle time, the function returns once it completed (ACK polling).
+ */
+uint8_t mcp794xx_eeprom_write_byte(mcp794xx_handle_t *const pHandle, uint8_t u8Addr, uint8_t *pBuf, uint8_t length)
+{
+    if(pHandle == NULL)
+        return 2;     /**< return failed error */
+    if(pHandle->inited != 1)
+        return 3;      /**< return failed error */
+
+    if(u8Addr < EEPROM_LOWEST_ADDRESS || u8Addr > EEPROM_HIGHEST_ADDRESS){
+    	a_mcp794xx_print_error_msg(pHandle, "to write eeprom, invalid address");
+    	return 4;
+    }if((u8Addr + length) > EEPROM_MEMORY_SIZE)
+    {
+    	a_mcp794xx_print_error_msg(pHandle, "to write eeprom, address out of range");
+    	return 4;
+    }
+
+    err = mcp794xx_eeprom_check_bp_before_write(pHandle, u8Addr);   /**< check to make sure that the address to write is not protected */
+    if(err != MCP794XX_DRV_OK)
+    {
+    	a_mcp794xx_print_error_msg(pHandle, "write eeprom, attempt to write a block protected region");
+    	return 5;
+    }
+
+    err = eeprom_mcp794xx_i2c_write(pHandle, u8Addr, (uint8_t *)pBuf, length);
+    if(err)
+    {
+    	a_mcp794xx_print_error_msg(pHandle, "write eeprom");
+        return 1;           /**< failed error */
+    }
+
+    err = a_mcp794xx_eeprom_ack_poll(pHandle, u8Addr);     /**< wait for the write cycle */
+    if(err)
+    {
+    	a_mcp794xx_print_error_msg(pHandle, "write eeprom, write cycle timeout");
+        return 7;           /**< failed error */
+    }
+
+    return 0;              /**< success */
+}
+
+/**
+ * @brief     This function writes a buffer of any length at any eeprom address
+ * @param[in] pHandle points to mcp794xx handle structure
+ * @param[in] u8Addr is the eeprom address to start writing
+ * @param[in] *pBuf points to data buffer to be written
+ * @param[in] u16Length is the data buffer length (1 - EEPROM_MEMORY_SIZE)
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 invalid address or length
+ *            - 5 attempt to write a protected block array
+ *            - 6 invalid device variant
+ *            - 7 write cycle did not complete within the timeout
+ * @note      The buffer is split on the 8-byte page boundaries, one bus write per page. The eeprom is idle on
+ *            entry, a refused first page is a bus failure. The next pages are retried while the eeprom is busy
+ *            with the previous one, so the write itself is the ACK poll.
+ *            The function returns once the last write cycle completed.
+ */
+uint8_t mcp794xx_eeprom_write(mcp794xx_handle_t *const pHandle, uint8_t u8Addr, uint8_t *pBuf, uint16_t u16Length)
+{
+    uint16_t u16Offset = 0;
+    uint8_t u8Chunk;
+
+    if(pHandle == NULL)
+        return 2;     /**< return failed error */
+    if(pHandle->inited != 1)
+        return 3;      /**< return failed error */
+
+    if((u16Length == 0) || (u8Addr > EEPROM_HIGHEST_ADDRESS) || ((u8Addr + u16Length) > EEPROM_MEMORY_SIZE))
+    {
+    	a_mcp794xx_print_error_msg(pHandle, "to write eeprom, address out of range");
+    	return 4;
+    }
+
+    if(pHandle->device_variant == MCP79400_VARIANT || pHandle->device_variant == MCP7940M_VARIANT || pHandle->device_variant == MCP7940N_VARIANT || pHandle->device_variant == MCP79410_VARIANT){
+ 	   a_mcp794xx_print_error_msg(pHandle, "invalid device variant, the device does have a eeprom built-in");
+ 	   return 6;
+    }
+
+    err = mcp794xx_eeprom_check_bp_before_write(pHandle, (uint8_t)(u8Addr + u16Length - 1));   /**< protection covers the top of the array */
+    if(err != MCP794XX_DRV_OK)
+    {
+    	a_mcp794xx_print_error_msg(pHandle, "write eeprom, attempt to write a block protected region");
+    	return 5;
+    }
+
+    while(u16Offset < u16Length)
+    {
+        u8Chunk = EEPROM_PAGE_SIZE - ((u8Addr + u16Offset) & (EEPROM_PAGE_SIZE - 1));      /**< up to the end of the page */
+        if(u8Chunk > (u16Length - u16Offset))
+        {
+            u8Chunk = (uint8_t)(u16Length - u16Offset);
+        }
+
+        if(u16Offset == 0)
+        {
+            err = eeprom_mcp794xx_i2c_write(pHandle, u8Addr, (uint8_t *)pBuf, u8Chunk);   /**< no write cycle running yet */
+            if(err)
+            {
+            	a_mcp794xx_print_error_msg(pHandle, "write eeprom");
+                return 1;           /**< failed error */
+            }
+        }else
+        {
+            err = a_mcp794xx_eeprom_write_retry(pHandle, (uint8_t)(u8Addr + u16Offset), (uint8_t *)&pBuf[u16Offset], u8Chunk);
+            if(err)
+            {
+            	a_mcp794xx_print_error_msg(pHandle, "write eeprom, write cycle timeout");
+                return 7;           /**< failed error */
+            }
+        }
+        u16Offset += u8Chunk;
+    }
+
+    err = a_mcp794xx_eeprom_ack_poll(pHandle, u8Addr);     /**< wait for the last write cycle */
+    if(err)
+    {
+    	a_mcp794xx_print_error_msg(pHandle, "write eeprom, write cycle timeout");
+        return 7;           /**< failed error */
+    }
+
+    return 0;              /**< success */
+}
+
+/**
+ * @brief     This function read n byte to eeprom
+ * @param[in] pHandle points to mcp794xx handle structure
+ * @param[in] addr is the eeprom address to read
+ * @param[out] *buf points to data buffer read
+ * @param[in] length is the data buffer length
+ * @return    status code
+ *            - 0 success
+ *            - 1 read failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 invalid address
+ *            - 5 invalid device variant
+ * @note      none
+ */
+uint8_t mcp794xx_eeprom_read_byte(mcp794xx_handle_t *const pHandle, uint8_t u8Addr, uint8_t *pBuf, uint8_t length)
+{
+
+    if(pHandle == NULL)
+        return 2;     /**< return failed error */
+    if(pHandle->inited != 1)
+        return 3;      /**< return failed error */
+
+    if(u8Addr < EEPROM_LOWEST_ADDRESS || u8Addr > EEPROM_HIGHEST_ADDRESS){
+    	a_mcp794xx_print_error_msg(pHandle, "to read eeprom, invalid address");
+    	return 4;
+    }if((u8Addr + length) > EEPROM_MEMORY_SIZE)
+    {
+    	a_mcp794xx_print_error_msg(pHandle, "to read eeprom, address out of range");
+    	return 4;
+    }
+
+    if(pHandle->device_variant == MCP79400_VARIANT || pHandle->device_variant == MCP7940M_VARIANT || pHandle->device_variant == MCP7940N_VARIANT || pHandle->device_variant == MCP79410_VARIANT){
+ 	   a_mcp794xx_print_error_msg(pHandle, "invalid device variant, the device does have a eeprom built-in");
+ 	   return 5;
+    }
+
+    err = eeprom_mcp794xx_i2c_read(pHandle, u8Addr, (uint8_t *)pBuf, length);
+    if(err)
+    {
+    	a_mcp794xx_print_error_msg(pHandle, "read eeprom");
+        return 1;           /**< failed error */
+    }
+
+    return 0;              /**< success */
+}
+
+/**
+ * @brief     This function writes data larger than a byte > 255 (equivalent to eeprom.put on Arduino)
+ * @param[in] pHandle points to mcp794xx handle structure
+ * @param[in] addr is the eeprom address to start writing
+ * @param[in] *buf points to data buffer write
+ * @param[in] u8Length is the buffer size
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 invalid address (failed to validate address)
+ *            - 5 attempt to write a protected block array
+ *            - 6 data length is larger than page can contain
+ * @note      none
+ */
+
+uint8_t mcp794xx_eeprom_put_byte(mcp794xx_handle_t *const pHandle, uint8_t u8Addr, uint32_t *pBuf, uint8_t u8Length)
+{
+	uint8_t *pTemp_buffer; /**< Temporarily buffer */
+    uint32_t dataOut;
+    uint8_t index;
+
+    if(pHandle == NULL)
+        return 2;     /**< return failed error */
+    if(pHandle->inited != 1)
+        return 3;      /**< return failed error */
+
+    pTemp_buffer = (uint8_t*)calloc(u8Length, sizeof(uint8_t));
+	if(pTemp_buffer == NULL)
+		pHandle->debug_print("failed to allocate dynamic memory\n\r");
+
+    memcpy(pTemp_buffer, pBuf, u8Length);
+
+    err = mcp794xx_eeprom_validate_page_boundary(pHandle, u8Addr, u8Length);
+    if(err != MCP794XX_DRV_OK){
+    	return err;
+    }
+
+    /**< Reverse array data to big Indian*/
+	for (index = 0; index < (uint8_t)u8Length / 2; index++)
+	{
+		dataOut = pTemp_buffer[index];
+		pTemp_buffer[index] = pTemp_buffer[u8Length - index - 1];
+		pTemp_buffer[u8Length - index - 1] = dataOut;
+	}
+
+	err = mcp794xx_eeprom_write_byte(pHandle, u8Addr, (uint8_t *)pTemp_buffer, u8Length);
+	if (err)
+	{
+		a_mcp794xx_print_error_msg(pHandle, "put bytes");
+		return 1; /**< failed to write */
+	}
+	free(pTemp_buffer);
+
+    return 0;              /**< success */
+}
+
+/**
+ * @brief     This function reads data larger than a byte > 255 (equivalent to eeprom.get on Arduino)
+ * @param[in] pHandle points to mcp794xx handle structure
+ * @param[in] addr is the eeprom address to start writing
+ * @param[out] *buf points to data buffer read
+ * @param[in] u8Length is the buffer size
+ * @return    status code
+ *            - 0 success
+ *            - 1 read failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 invalid address (failed to validate address)
+ * @note      none
+ */
+
+uint8_t mcp794xx_eeprom_get_byte(mcp794xx_handle_t *const pHandle, uint8_t u8Addr, uint32_t *pBuf, uint8_t u8Length)
+{
+    uint8_t index, dataOut;
+    uint8_t *temp_buffer;
+
+    if(pHandle == NULL)
+        return 2;     /**< return failed error */
+    if(pHandle->inited != 1)
+        return 3;      /**< return failed error */
+
+	temp_buffer = (uint8_t*)calloc(u8Length, sizeof(uint8_t));
+
+    err = mcp794xx_eeprom_validate_page_boundary(pHandle, u8Addr, u8Length);
+    if(err != MCP794XX_DRV_OK){
+    	return err;
+    }
+
+    err = (mcp794xx_eeprom_read_byte(pHandle, u8Addr, (uint8_t*) temp_buffer, u8Length));
+    if (err != MCP794XX_DRV_OK)
+    {
+    	a_mcp794xx_print_error_msg(pHandle, "get bytes");
+        return 1; /**< return error code */
+    }
+
+    /**< Reverse array data to Big Indian*/
+    for (index = 0; index < (uint8_t)u8Length / 2; index++)
+    {
+        dataOut = temp_buffer[index];
+        temp_buffer[index] = temp_buffer[u8Length - index - 1];
+        temp_buffer[u8Length - index - 1] = dataOut;
+    }
+
+    memcpy(eeprom.buffer, temp_buffer, u8Length);
+
+    *pBuf = (uint32_t)eeprom.data;
+
+    return 0;              /**< success */
+}
+
+/**
+ * @brief      This function writes the eeprom bytes that differ from a known current image
+ * @param[in]  pHandle points to mcp794xx handle structure
+ * @param[in]  u8Address is the address to write
+ * @param[in]  *pCurrent point to the current eeprom content of the range
+ * @param[in]  *pBuffer point to data write
+ * @param[in]  u8Length is the data size
+ * @param[out] pCycles_saved point to the write cycles saved against one write per changed byte, can be NULL
+ * @return status code
+ *            - 0 success
+ *            - 5 attempt to write a protected block array
+ *            - 7 write cycle did not complete within the timeout
+ * @note    none
+ */
+uint8_t a_mcp794xx_eeprom_write_diff(mcp794xx_handle_t *const pHandle, uint8_t u8Address, const uint8_t *pCurrent, uint8_t *pBuffer,
+                                     uint8_t u8Length, uint8_t *pCycles_saved)
+{
+    uint8_t u8Index;
+    uint8_t u8Page_end;
+    int16_t s16First;
+    int16_t s16Last;
+    int16_t s16Top = -1;
+    uint8_t u8Changed = 0;
+    uint8_t u8Cycles = 0;
+
+    for(u8Index = 0; u8Index < u8Length; u8Index++)      /**< the highest changed byte decides the protection check */
+    {
+        if(pCurrent[u8Index] != pBuffer[u8Index])
+        {
+            s16Top = u8Index;
+            u8Changed++;
+        }
+    }
+    if(s16Top < 0)
+    {
+        return 0;    /**< nothing to write */
+    }
+
+    err = mcp794xx_eeprom_check_bp_before_write(pHandle, (uint8_t)(u8Address + s16Top));
+    if(err != MCP794XX_DRV_OK)
+    {
+    	a_mcp794xx_print_error_msg(pHandle, "update eeprom, attempt to write a block protected region");
+    	return 5;
+    }
+
+    u8Index = 0;
+    while(u8Index < u8Length)
+    {
+        u8Page_end = u8Index + EEPROM_PAGE_SIZE - ((u8Address + u8Index) & (EEPROM_PAGE_SIZE - 1));
+        if(u8Page_end > u8Length)
+            u8Page_end = u8Length;
+
+        s16First = -1;
+        s16Last = -1;
+        for(; u8Index < u8Page_end; u8Index++)
+        {
+            if(pCurrent[u8Index] != pBuffer[u8Index])
+            {
+                if(s16First < 0)
+                    s16First = u8Index;
+                s16Last = u8Index;
+            }
+        }
+
+        if(s16First >= 0)
+        {
+            err = a_mcp794xx_eeprom_write_retry(pHandle, (uint8_t)(u8Address + s16First), (uint8_t *)&pBuffer[s16First],
+                                                (uint8_t)(s16Last - s16First + 1));
+            if(err)
+            {
+            	a_mcp794xx_print_error_msg(pHandle, "update eeprom, write cycle timeout");
+                return 7;           /**< failed error */
+            }
+            u8Cycles++;
+        }
+    }
+
+    err = a_mcp794xx_eeprom_ack_poll(pHandle, u8Address);     /**< wait for the last write cycle */
+    if(err)
+    {
+    	a_mcp794xx_print_error_msg(pHandle, "update eeprom, write cycle timeout");
+        return 7;           /**< failed error */
+    }
+
+    if(pCycles_saved != NULL)
+        *pCycles_saved = u8Changed - u8Cycles;
+
+	return 0;    /**< success */
+}
+
+/**
+ * @brief      This function writes only the eeprom bytes that differ, one write cycle per touched page
+ * @param[in]  pHandle points to mcp794xx handle structure
+ * @param[in]  u8Address is the address to write
+ * @param[in]  *pBuffer point to data write
+ * @param[in]  u8Length is the data size
+ * @param[out] pCycles_saved point to the write cycles saved against one write per changed byte, can be NULL
+ * @return status code
+ *            - 0 success
+ *            - 1 read or write failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 invalid address (failed to validate address)
+ *            - 5 attempt to write a protected block array
+ *            - 7 write cycle did not complete within the timeout
+ * @note    The range is read once. In every page the span from the first to the last changed byte is
+ *          written in one transfer, untouched pages are skipped. Fewer cycles also means less wear.
+ */
+uint8_t mcp794xx_eeprom_update_diff(mcp794xx_handle_t *const pHandle, uint8_t u8Address, uint8_t *pBuffer, uint8_t u8Length, uint8_t *pCycles_saved)
+{
+    uint8_t tempBuf[EEPROM_MEMORY_SIZE];
+
+    if(pHandle == NULL)
+        return 2;     					/**< return failed error */
+    if(pHandle->inited != 1)
+        return 3;     					/**< return failed error */
+
+    if(pCycles_saved != NULL)
+        *pCycles_saved = 0;
+
+    err = mcp794xx_eeprom_read_byte(pHandle, u8Address, (uint8_t *)tempBuf, u8Length);
+    if(err != MCP794XX_DRV_OK){
+    	a_mcp794xx_print_error_msg(pHandle, "update eeprom, read failed");
+    	return (err == 4) ? 4 : 1;
+    }
+
+    return a_mcp794xx_eeprom_write_diff(pHandle, u8Address, tempBuf, pBuffer, u8Length, pCycles_saved);
+}
+
+/**
+ * @brief This function write a byte to the EEPROM.
+ * @param[in] pHandle points to mcp794xx handle structure
+ * @param[in] u8Address is the address to write
+ * @param[in] *pBuffer point to data write
+ * @param[in] u8Length is the data size
+ * @return status code
+ *            - 0 success
+ *            - 1 read or write failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 invalid address (failed to validate address)
+ *            - 5 attempt to write a protected block array
+ *            - 7 write cycle did not complete within the timeout
+ * @note    The value is written only if differs from the one already saved at the same address,
+ *          one write cycle per touched page (see mcp794xx_eeprom_update_diff).
+ */
+uint8_t mcp794xx_eeprom_update(mcp794xx_handle_t *const pHandle, uint8_t u8Address, uint8_t *pBuffer, uint8_t u8Length)
+{
+    return mcp794xx_eeprom_update_diff(pHandle, u8Address, pBuffer, u8Length, NULL);
+}
+
+/**
+ * @brief     This function erase eeprom page
+ * @param[in] pHandle points to mcp794xx handle structure
+ * @param[in] u8Page_number is the eeprom page number to erase
+ * @return    status code
+ *            - 0 success
+ *            - 1 read failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 invalid page (out of boundary)
+ * @note      Page erase instruction will erase all bits (FFh) within a the given page.
+ */
+uint8_t mcp794xx_eeprom_erase_page(mcp794xx_handle_t *const pHandle, uint8_t u8Page_number)
+{
+	uint8_t page_start_addr;
+	uint8_t dummy_byte_arr[EEPROM_PAGE_SIZE];
+
+    if(pHandle == NULL)
+        return 2;     /**< return failed error */
+    if(pHandle->inited != 1)
+        return 3;      /**< return failed error */
+
+    memset((uint8_t *)dummy_byte_arr, 0xff, sizeof(dummy_byte_arr));
+
+    err = mcp794xxx_eeprom_validate_page(pHandle, u8Page_number, (uint8_t *)&page_start_addr);
+    if(err)
+    {
+    	a_mcp794xx_print_error_msg(pHandle, "to erase page, invalid page number");
+    	return err;
+    }
+
+    err = mcp794xx_eeprom_write_byte(pHandle, page_start_addr, (uint8_t *)dummy_byte_arr, EEPROM_PAGE_SIZE);
+    if(err)
+    {
+    	a_mcp794xx_print_error_msg(pHandle, "to erase page");
+    	return err;
+    }
+
+    return 0;              /**< success */
+}
+
+/**
+ * @brief     This function erase a sector stored data
+ * @param[in] pHandle points to mcp794xx handle structure
+ * @param[in] pSector_addr is the eeprom sector address (start address and end address) to erase
+ * @return    status code
+ *            - 0 success
+ *            - 1 erase failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 invalid address
+ * @note      sector erase instruction will erase all bits (FFh) within a given sector
+ */
+uint8_t mcp794xx_eeprom_erase_sector(mcp794xx_handle_t *const pHandle, uint8_t *pSector_addr)
+{
+	uint8_t index;
+	uint8_t dummy_data = 0xff;
 
-        case MCP79402_VARIANT:
-        {
-            err = eeprom_mcp794xx_i2c_read(pHandle, EEPROM_UID_ADDRESS, (uint8_t *)temp_buffer, UID_MAX_LENGTH);
-            if(err)
-            {
-                a_mcp794xx_print_error_msg(pHandle, "failed to read UID");
-                return 1;           /**< failed error */
-            }
-            memcpy((uint8_t *)pUID, (uint8_t *)temp_buffer, sizeof(temp_buffer));
-            break;
-        }
+    if(pHandle == NULL)
+        return 2;     /**< return failed error */
+    if(pHandle->inited != 1)
+        return 3;      /**< return failed error */
 
-        case MCP7940M_VARIANT:
+    for(index = pSector_addr[0]; index < pSector_addr[1]; index++){
+        err = mcp794xx_eeprom_write_byte(pHandle, index, (uint8_t *)&dummy_data, 1);
+        if(err)
         {
-            a_mcp794xx_print_error_msg(pHandle, "failed to read UID, unsupported cmd for mcp7940m variant");
+        	a_mcp794xx_print_error_msg(pHandle, "erase eeprom sector");
             return 1;           /**< failed error */
-            break;
         }
+    }
 
-        case MCP7940N_VARIANT:
-        {
-            a_mcp794xx_print_error_msg(pHandle, "failed to read UID, unsupported cmd for mcp7940n variant");
-            return 1;           /**< failed error */
-            break;
-        }
+    return 0;              /**< success */
+}
 
-        case MCP79410_VARIANT:
-        {
-            a_mcp794xx_print_error_msg(pHandle, "failed to read UID, unsupported cmd for mcp79410 variant");
-            return 1;           /**< failed error */
-            break;
-        }
+/**
+ * @brief     This function erase chip stored data
+ * @param[in] pHandle points to mcp794xx handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 erase failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      chip erase instruction will erase all bits (FFh) in the array.
+ */
+uint8_t mcp794xx_eeprom_erase_chip(mcp794xx_handle_t *const pHandle)
+{
+	uint8_t index;
+	uint8_t dummy_data_arr[EEPROM_PAGE_SIZE];
 
-        case MCP79411_VARIANT:
-        {
-            err = eeprom_mcp794xx_i2c_read(pHandle, EEPROM_UID_ADDRESS + 2, (uint8_t *)temp_buffer, UID_MAX_LENGTH - 2);
-            if(err)
-            {
-                a_mcp794xx_print_error_msg(pHandle, "failed to read UID");
-                return 1;           /**< failed error */
-            }
-            memcpy((uint8_t *)pUID, (uint8_t *)temp_buffer, sizeof(temp_buffer) - 2);
-            break;
-        }
+    if(pHandle == NULL)
+        return 2;     /**< return failed error */
+    if(pHandle->inited != 1)
+        return 3;      /**< return failed error */
 
-        case MCP79412_VARIANT:
+    memset((uint8_t *)dummy_data_arr, 0xff, sizeof(dummy_data_arr));          /**< fill the entire array with a value of 0xff */
+
+    for(index = EEPROM_LOWEST_ADDRESS; index < EEPROM_MEMORY_SIZE; (index += EEPROM_PAGE_SIZE))
+    {
+        err = mcp794xx_eeprom_write_byte(pHandle, index, (uint8_t *)dummy_data_arr, EEPROM_PAGE_SIZE);
+        if(err)
         {
-            err = eeprom_mcp794xx_i2c_read(pHandle, EEPROM_UID_ADDRESS, (uint8_t *)temp_buffer, UID_MAX_LENGTH);
-            if(err)
-            {
-                a_mcp794xx_print_error_msg(pHandle, "failed to read UID");
-                return 1;           /**< failed error */
-            }
-            memcpy((uint8_t *)pUID, (uint8_t *)temp_buffer, sizeof(temp_buffer));
-            break;
+        	a_mcp794xx_print_error_msg(pHandle, "wipe eeprom");
+            return 1;           /**< failed error */
         }
-
     }
 
     return 0;              /**< success */
 }
 
+
 /**
-* @brief This function write data bytes to sram
-* @param[in] *pHandle points to mcp794xx handle structure
-* @param[in] addr is the register address to write to
-* @param[in] *pBuffer point to data to write
-* @param[in] length is the number of bytes the write
-* @return status code
-*          - 0 success
-*          - 1 failed to write
-*          - 2 pHandle is NULL
-*          - 3 pHandle is not initialized
-*          - 4 invalid address
-* @note none
-*/
-uint8_t mcp794xx_sram_write_byte(mcp794xx_handle_t *const pHandle, uint8_t addr, uint8_t *pBuffer, size_t length)
+ * @brief This function caches the block protect status as the first protected address
+ * @param[in] pHandle points to mcp794xx handle structure
+ * @param[in] status is the block protect status
+ * @return none
+ * @note   none
+ */
+void a_mcp794xx_eeprom_bp_cache(mcp794xx_handle_t *const pHandle, mcp794xx_eeprom_block_protect_stat_t status)
+{
+    static const uint8_t protected_bound[4] = {EEPROM_MEMORY_SIZE,                  /**< BP00: none */
+                                               (EEPROM_MEMORY_SIZE / 4) * 3,        /**< BP01: upper 1/4 */
+                                               EEPROM_MEMORY_SIZE / 2,              /**< BP10: upper 1/2 */
+                                               EEPROM_LOWEST_ADDRESS};              /**< BP11: all */
+
+    pHandle->eeprom_bp_bound = protected_bound[status & 0x03];
+    pHandle->eeprom_bp_valid = 1;
+}
+
+/**
+ * @brief     This function set write enable latch status
+ * @param[in] pHandle points to mcp794xx handle structure
+ * @param[in] status is the value to write
+ * @return    status code
+ *            - 0 success
+ *            - 1 set bp failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 write cycle did not complete within the timeout
+ * @note      the STATUS register is an eeprom cell, the function returns once its write cycle completed.
+ */
+uint8_t mcp794xx_eeprom_set_bp_status(mcp794xx_handle_t *const pHandle, mcp794xx_eeprom_block_protect_stat_t status)
 {
+    uint8_t block_protect_status = 0;
 
     if(pHandle == NULL)
         return 2;     /**< return failed error */
     if(pHandle->inited != 1)
         return 3;      /**< return failed error */
 
-    if(addr > SRAM_LAST_ADDRESS || addr < SRAM_FIRST_ADDRESS)
+    block_protect_status |=  (status << 2);
+    err = eeprom_mcp794xx_i2c_write(pHandle, EEPROM_BLOCK_PROTECT_REG, (uint8_t *)&block_protect_status, 1);
+    if(err)
     {
-    	a_mcp794xx_print_error_msg(pHandle, "write sram, invalid address");
-    	return 4;
-    }if(length > SRAM_MEMORY_SIZE){
-    	a_mcp794xx_print_error_msg(pHandle, "write sram, address can't be greater than 0x5F");
-    	return 5;
-    }if((addr - SRAM_FIRST_ADDRESS)+ length > SRAM_MEMORY_SIZE){
-    	a_mcp794xx_print_error_msg(pHandle, "write sram, address out of range");
-    	return 5;
+        a_mcp794xx_print_error_msg(pHandle, "write eeprom block protect  reg");
+        return 1;           /**< failed error */
     }
 
-    err = sram_mcp794xx_i2c_write(pHandle, addr, (uint8_t *)pBuffer, length);
+    a_mcp794xx_eeprom_bp_cache(pHandle, status);
+
+    err = a_mcp794xx_eeprom_ack_poll(pHandle, EEPROM_BLOCK_PROTECT_REG);     /**< wait for the write cycle */
     if(err)
     {
-       a_mcp794xx_print_error_msg(pHandle, "write to sram");
-       return 1;
+        a_mcp794xx_print_error_msg(pHandle, "write eeprom block protect reg, write cycle timeout");
+        return 4;           /**< failed error */
     }
-	return 0;          /**< success */
+
+    return 0;              /**< success */
 }
 
 /**
-* @brief This function reads data bytes from sram
-* @param[in] *pHandle points to mcp794xx handle structure
-* @param[in] addr is the register address to write to
-* @param[out] *pBuffer point to data to read
-* @param[in] length is the number of bytes the read
-* @return status code
-*          - 0 success
-*          - 1 failed to read
-*          - 2 pHandle is NULL
-*          - 3 pHandle is not initialized
-*          - 4 invalid address
-* @note none
-*/
-uint8_t mcp794xx_sram_read_byte(mcp794xx_handle_t *const pHandle, uint8_t addr, uint8_t *pBuffer, size_t length)
+ * @brief     This function get write enable latch status
+ * @param[in] pHandle points to mcp794xx handle structure
+ * @param[out] *pStatus is the value to write
+ * @return    status code
+ *            - 0 success
+ *            - 1 get bp failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t mcp794xx_eeprom_get_bp_status(mcp794xx_handle_t *const pHandle, mcp794xx_eeprom_block_protect_stat_t *pStatus)
 {
+	uint8_t block_protect_status = 0;
 
     if(pHandle == NULL)
         return 2;     /**< return failed error */
     if(pHandle->inited != 1)
         return 3;      /**< return failed error */
 
-    if(addr > SRAM_LAST_ADDRESS || addr < SRAM_FIRST_ADDRESS)
-    {
-    	a_mcp794xx_print_error_msg(pHandle, "read sram, invalid address");
-    	return 4;
-    }if(length > SRAM_MEMORY_SIZE){
-    	a_mcp794xx_print_error_msg(pHandle, "read sram, address can't be greater than 0x5F");
-    	return 5;
-    }if((addr - SRAM_FIRST_ADDRESS)+ length > SRAM_MEMORY_SIZE){
-    	a_mcp794xx_print_error_msg(pHandle, "read sram, address out of range");
-    	return 5;
-    }
-
-    err = rtc_mcp794xx_i2c_read(pHandle, addr, (uint8_t *)pBuffer, length);
+    err = eeprom_mcp794xx_i2c_read(pHandle, EEPROM_BLOCK_PROTECT_REG, (uint8_t *)&block_protect_status, 1);
     if(err)
     {
-       a_mcp794xx_print_error_msg(pHandle, "read sram");
-       return 1;
+    	a_mcp794xx_print_error_msg(pHandle, "read eeprom block protect reg");
+        return 1;           /**< failed error */
     }
 
- return 0;          /**< success */
+    *pStatus = (mcp794xx_eeprom_block_protect_stat_t)(block_protect_status & EEPROM_BLOCK_PROTECT_MASK) >> 2;
+    a_mcp794xx_eeprom_bp_cache(pHandle, *pStatus);
+
+    return 0;               /**< success */
 }
 
 /**
-* @brief This function erases a sector of the sram
-* @param[in] *pHandle points to mcp794xx handle structure
-* @param[in] start_addr is the first register address erase
-* @param[in] end_addr is the last register address erase
-* @return status code
-*          - 0 success
-*          - 1 failed to write
-*          - 2 pHandle is NULL
-*          - 3 pHandle is not initialized
-*          - 4 invalid address
-* @note data from the start to the end address will be erased
-*/
-uint8_t mcp794xx_sram_erase_selector(mcp794xx_handle_t *const pHandle, uint8_t start_addr, uint8_t end_addr)
+ * @brief     This function set the eeprom write cycle timeout
+ * @param[in] pHandle points to mcp794xx handle structure
+ * @param[in] u16Timeout_ms is the longest time to poll for the end of a write cycle (ms)
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 timeout is 0
+ * @note      The default is MCP794XX_EEPROM_WRITE_TIMEOUT_MS, the datasheet write cycle is 5 ms max.
+ */
+uint8_t mcp794xx_eeprom_set_write_timeout(mcp794xx_handle_t *const pHandle, uint16_t u16Timeout_ms)
 {
-	int index;
-	uint8_t dummy_dada = 0x00;
-
     if(pHandle == NULL)
         return 2;     /**< return failed error */
     if(pHandle->inited != 1)
         return 3;      /**< return failed error */
 
-    if(start_addr > SRAM_LAST_ADDRESS || start_addr < SRAM_FIRST_ADDRESS)
+    if(u16Timeout_ms == 0)
     {
-    	a_mcp794xx_print_error_msg(pHandle, "erase sram sector, invalid address (0x20 - 0x57)");
-    	return 4;
-    }if(end_addr > SRAM_LAST_ADDRESS || end_addr < SRAM_FIRST_ADDRESS){
-    	a_mcp794xx_print_error_msg(pHandle, "erase sram sector, invalid address (0x20 - 0x57)");
-    	return 4;
+        a_mcp794xx_print_error_msg(pHandle, "set eeprom write timeout, timeout can not be 0");
+        return 4;
     }
 
-    for(index = start_addr; index <= end_addr; index++)
-    {
-		err = sram_mcp794xx_i2c_write(pHandle, index, (uint8_t *)&dummy_dada, 1);
-		if(err)
-		{
-		   a_mcp794xx_print_error_msg(pHandle, "erase sram sector");
-		   return 1;
-		}
-    }
+    pHandle->eeprom_timeout_ms = u16Timeout_ms;
 
-	return 0;   /**< success */
+    return 0;              /**< success */
 }
 
 /**
-* @brief This function wipes the entire sram memory
-* @param[in] *pHandle points to mcp794xx handle structure
-* @return status code
-*          - 0 success
-*          - 1 failed to write
-*          - 2 pHandle is NULL
-*          - 3 pHandle is not initialized
-* @note none
-*/
-uint8_t mcp794xx_wipe_sram(mcp794xx_handle_t *const pHandle)
+ * @brief      This function get the eeprom write cycle timeout
+ * @param[in]  pHandle points to mcp794xx handle structure
+ * @param[out] pTimeout_ms point to the write cycle timeout (ms)
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t mcp794xx_eeprom_get_write_timeout(mcp794xx_handle_t *const pHandle, uint16_t *pTimeout_ms)
+{
+    if(pHandle == NULL)
+        return 2;     /**< return failed error */
+    if(pHandle->inited != 1)
+        return 3;      /**< return failed error */
+
+    *pTimeout_ms = pHandle->eeprom_timeout_ms;
+
+    return 0;              /**< success */
+}
+
+/**
+ * @brief     This function enables/disables the eeprom RAM mirror
+ * @param[in] pHandle points to mcp794xx handle structure
+ * @param[in] status is the enable boolean status
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      - When enabled, eeprom reads are served from RAM. Each page is read from the chip the first
+ *              time it is needed and every driver write updates the mirror.
+ *            - The mirror starts empty on enable; disabling bypasses it and drops the content.
+ */
+uint8_t mcp794xx_set_eeprom_mirror_enable_status(mcp794xx_handle_t *const pHandle, mcp794xx_bool_t status)
 {
-    uint8_t temp_buffer[SRAM_MEMORY_SIZE];
+    if(pHandle == NULL)
+        return 2;     /**< return failed error */
+    if(pHandle->inited != 1)
+        return 3;      /**< return failed error */
 
-    memset(temp_buffer, 0x00, sizeof(temp_buffer));
+    pHandle->eeprom_mirror.valid = 0;
+    pHandle->eeprom_mirror.enable = (status == MCP794XX_BOOL_FALSE) ? 0 : 1;
 
+    return 0;              /**< success */
+}
+
+/**
+ * @brief      This function get the eeprom RAM mirror enable status
+ * @param[in]  pHandle points to mcp794xx handle structure
+ * @param[out] pStatus point to the boolean status
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t mcp794xx_get_eeprom_mirror_enable_status(mcp794xx_handle_t *const pHandle, mcp794xx_bool_t *pStatus)
+{
     if(pHandle == NULL)
         return 2;     /**< return failed error */
     if(pHandle->inited != 1)
         return 3;      /**< return failed error */
 
-    err = sram_mcp794xx_i2c_write(pHandle, SRAM_FIRST_ADDRESS, (uint8_t *)temp_buffer, SRAM_MEMORY_SIZE);
-	if(err)
-	{
-	   a_mcp794xx_print_error_msg(pHandle, "wipe sram");
-	   return 1;
-	}
+    *pStatus = (mcp794xx_bool_t)pHandle->eeprom_mirror.enable;
 
-	return 0;    /**< success */
+    return 0;              /**< success */
 }
 
 /**
- * @brief     This function write n byte to eeprom
+ * @brief     This function invalidates the eeprom RAM mirror content
  * @param[in] pHandle points to mcp794xx handle structure
- * @param[in] addr is the eeprom address to write to
- * @param[in] *buf points to data buffer to be written
- * @param[in] length is the data buffer length
  * @return    status code
  *            - 0 success
- *            - 1 write failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
- *            - 4 invalid address
- *            - 5 attempt to write a protected block array
- *            - 6 data length is larger than page size
- * @note      the eeprom has a 5ms write cycle time.
+ * @note      call it when the eeprom may have been written behind the driver (other bus master, reset)
  */
-uint8_t mcp794xx_eeprom_write_byte(mcp794xx_handle_t *const pHandle, uint8_t u8Addr, uint8_t *pBuf, uint8_t length)
+uint8_t mcp794xx_eeprom_mirror_invalidate(mcp794xx_handle_t *const pHandle)
 {
     if(pHandle == NULL)
         return 2;     /**< return failed error */
     if(pHandle->inited != 1)
         return 3;      /**< return failed error */
 
-    if(u8Addr < EEPROM_LOWEST_ADDRESS || u8Addr > EEPROM_HIGHEST_ADDRESS){
-    	a_mcp794xx_print_error_msg(pHandle, "to write eeprom, invalid address");
-    	return 4;
-    }if((u8Addr + length) > EEPROM_MEMORY_SIZE)
-    {
-    	a_mcp794xx_print_error_msg(pHandle, "to write eeprom, address out of range");
-    	return 4;
-    }
-
-    err = mcp794xx_eeprom_check_bp_before_write(pHandle, u8Addr);   /**< check to make sure that the address to write is not protected */
-    if(err != MCP794XX_DRV_OK)
-    {
-    	a_mcp794xx_print_error_msg(pHandle, "write eeprom, attempt to write a block protected region");
-    	return 5;
-    }
-
-    err = eeprom_mcp794xx_i2c_write(pHandle, u8Addr, (uint8_t *)pBuf, length);
-    if(err)
-    {
-    	a_mcp794xx_print_error_msg(pHandle, "write eeprom");
-        return 1;           /**< failed error */
-    }
+    pHandle->eeprom_mirror.valid = 0;
 
     return 0;              /**< success */
 }
 
 /**
- * @brief     This function read n byte to eeprom
- * @param[in] pHandle points to mcp794xx handle structure
- * @param[in] addr is the eeprom address to read
- * @param[out] *buf points to data buffer read
- * @param[in] length is the data buffer length
- * @return    status code
- *            - 0 success
- *            - 1 read failed
- *            - 2 handle is NULL
- *            - 3 handle is not initialized
- *            - 4 invalid address
- *            - 5 invalid device variant
- * @note      none
- */
-uint8_t mcp794xx_eeprom_read_byte(mcp794xx_handle_t *const pHandle, uint8_t u8Addr, uint8_t *pBuf, uint8_t length)
+* @brief This function mounts the sram write-ahead journal and replays it into the eeprom
+* @param[in] *pHandle points to mcp794xx handle structure
+* @param[in] start_addr is the first sram address of the journal
+* @param[in] end_addr is the last sram address of the journal
+* @return status code
+*          - 0 success
+*          - 1 failed to read or write
+*          - 2 pHandle is NULL
+*          - 3 pHandle is not initialized
+*          - 4 invalid range
+*          - 5 replay failed (the journal is kept)
+* @note Call once at power-up. The range is read in one burst, a range without a journal is formatted,
+*       updates journaled before a reset are flushed to the eeprom.
+*/
+uint8_t mcp794xx_journal_mount(mcp794xx_handle_t *const pHandle, uint8_t start_addr, uint8_t end_addr)
 {
+    mcp794xx_journal_t *pJournal;
+    uint8_t u8Length;
+    uint8_t *pEntry;
 
     if(pHandle == NULL)
         return 2;     /**< return failed error */
     if(pHandle->inited != 1)
         return 3;      /**< return failed error */
 
-    if(u8Addr < EEPROM_LOWEST_ADDRESS || u8Addr > EEPROM_HIGHEST_ADDRESS){
-    	a_mcp794xx_print_error_msg(pHandle, "to read eeprom, invalid address");
-    	return 4;
-    }if((u8Addr + length) > EEPROM_MEMORY_SIZE)
+    if((start_addr < SRAM_FIRST_ADDRESS) || (end_addr > SRAM_LAST_ADDRESS) || (end_addr < start_addr + 4))
     {
-    	a_mcp794xx_print_error_msg(pHandle, "to read eeprom, address out of range");
+    	a_mcp794xx_print_error_msg(pHandle, "mount journal, invalid range");
     	return 4;
     }
 
-    if(pHandle->device_variant == MCP79400_VARIANT || pHandle->device_variant == MCP7940M_VARIANT || pHandle->device_variant == MCP7940N_VARIANT || pHandle->device_variant == MCP79410_VARIANT){
- 	   a_mcp794xx_print_error_msg(pHandle, "invalid device variant, the device does have a eeprom built-in");
- 	   return 5;
-    }
+    pJournal = &pHandle->journal;
+    pJournal->mounted = 0;
+    pJournal->base = start_addr;
+    pJournal->capacity = ((end_addr - start_addr) - 1) / 3;
+    pJournal->count = 0;
+    u8Length = (end_addr - start_addr) + 1;
 
-    err = eeprom_mcp794xx_i2c_read(pHandle, u8Addr, (uint8_t *)pBuf, length);
+    err = rtc_mcp794xx_i2c_read(pHandle, start_addr, &pHandle->sram_staging[1], u8Length);
     if(err)
     {
-    	a_mcp794xx_print_error_msg(pHandle, "read eeprom");
-        return 1;           /**< failed error */
+       a_mcp794xx_print_error_msg(pHandle, "mount journal, read");
+       return 1;
     }
 
-    return 0;              /**< success */
+    if((pHandle->sram_staging[1] != MCP794XX_JOURNAL_MAGIC) || (pHandle->sram_staging[2] == 0))
+    {
+        memset(&pHandle->sram_staging[1], 0x00, u8Length);                          /**< no journal yet */
+        pHandle->sram_staging[1] = MCP794XX_JOURNAL_MAGIC;
+        pHandle->sram_staging[2] = 1;
+        err = a_mcp794xx_sram_burst(pHandle, start_addr, u8Length);
+        if(err)
+        {
+           a_mcp794xx_print_error_msg(pHandle, "mount journal, format");
+           return 1;
+        }
+    }
+
+    pJournal->gen = pHandle->sram_staging[2];
+    pEntry = &pHandle->sram_staging[3];
+    while((pJournal->count < pJournal->capacity) && (pEntry[2] == pJournal->gen) && (pEntry[0] <= EEPROM_HIGHEST_ADDRESS))
+    {
+        pJournal->addr[pJournal->count] = pEntry[0];
+        pJournal->value[pJournal->count] = pEntry[1];
+        pJournal->count++;
+        pEntry += 3;
+    }
+    pJournal->mounted = 1;
+
+    if(pJournal->count != 0)
+    {
+        err = mcp794xx_journal_flush(pHandle);
+        if(err)
+        {
+           a_mcp794xx_print_error_msg(pHandle, "mount journal, replay");
+           return 5;
+        }
+    }
+
+	return 0;   /**< success */
 }
 
 /**
- * @brief     This function writes data larger than a byte > 255 (equivalent to eeprom.put on Arduino)
- * @param[in] pHandle points to mcp794xx handle structure
- * @param[in] addr is the eeprom address to start writing
- * @param[in] *buf points to data buffer write
- * @param[in] u8Length is the buffer size
- * @return    status code
- *            - 0 success
- *            - 1 write failed
- *            - 2 handle is NULL
- *            - 3 handle is not initialized
- *            - 4 invalid address (failed to validate address)
- *            - 5 attempt to write a protected block array
- *            - 6 data length is larger than page can contain
- * @note      none
- */
-
-uint8_t mcp794xx_eeprom_put_byte(mcp794xx_handle_t *const pHandle, uint8_t u8Addr, uint32_t *pBuf, uint8_t u8Length)
+* @brief This function journals one eeprom byte update in sram
+* @param[in] *pHandle points to mcp794xx handle structure
+* @param[in] u8Addr is the eeprom address
+* @param[in] u8Value is the new value
+* @return status code
+*          - 0 success
+*          - 1 failed to write
+*          - 2 pHandle is NULL
+*          - 3 pHandle is not initialized
+*          - 4 invalid address
+*          - 5 journal not mounted
+*          - 6 address is block protected or the variant has no eeprom
+*          - 7 journal full and the flush failed
+* @note One burst write, no eeprom write cycle. A journaled address is updated in place,
+*       a full journal is flushed first.
+*/
+uint8_t mcp794xx_journal_write(mcp794xx_handle_t *const pHandle, uint8_t u8Addr, uint8_t u8Value)
 {
-	uint8_t *pTemp_buffer; /**< Temporarily buffer */
-    uint32_t dataOut;
+    mcp794xx_journal_t *pJournal;
     uint8_t index;
 
     if(pHandle == NULL)
@@ -3382,310 +7568,524 @@ uint8_t mcp794xx_eeprom_put_byte(mcp794xx_handle_t *const pHandle, uint8_t u8Add
     if(pHandle->inited != 1)
         return 3;      /**< return failed error */
 
-    pTemp_buffer = (uint8_t*)calloc(u8Length, sizeof(uint8_t));
-	if(pTemp_buffer == NULL)
-		pHandle->debug_print("failed to allocate dynamic memory\n\r");
-
-    memcpy(pTemp_buffer, pBuf, u8Length);
+    pJournal = &pHandle->journal;
+    if(u8Addr > EEPROM_HIGHEST_ADDRESS)
+    {
+    	a_mcp794xx_print_error_msg(pHandle, "journal write, invalid address");
+    	return 4;
+    }
+    if(pJournal->mounted != 1)
+    {
+    	a_mcp794xx_print_error_msg(pHandle, "journal write, journal not mounted");
+    	return 5;
+    }
+    if(mcp794xx_eeprom_check_bp_before_write(pHandle, u8Addr) != MCP794XX_DRV_OK)
+    {
+    	a_mcp794xx_print_error_msg(pHandle, "journal write, attempt to write a block protected region");
+    	return 6;
+    }
 
-    err = mcp794xx_eeprom_validate_page_boundary(pHandle, u8Addr, u8Length);
-    if(err != MCP794XX_DRV_OK){
-    	return err;
+    for(index = 0; index < pJournal->count; index++)
+    {
+        if(pJournal->addr[index] == u8Addr)
+        {
+            pHandle->sram_staging[1] = u8Value;                                    /**< entry already valid, rewrite its value only */
+            err = a_mcp794xx_sram_burst(pHandle, pJournal->base + 2 + (index * 3) + 1, 1);
+            if(err)
+            {
+               a_mcp794xx_print_error_msg(pHandle, "journal write");
+               return 1;
+            }
+            pJournal->value[index] = u8Value;
+            return 0;
+        }
     }
 
-    /**< Reverse array data to big Indian*/
-	for (index = 0; index < (uint8_t)u8Length / 2; index++)
-	{
-		dataOut = pTemp_buffer[index];
-		pTemp_buffer[index] = pTemp_buffer[u8Length - index - 1];
-		pTemp_buffer[u8Length - index - 1] = dataOut;
-	}
+    if(pJournal->count == pJournal->capacity)
+    {
+        err = mcp794xx_journal_flush(pHandle);
+        if(err)
+        {
+           a_mcp794xx_print_error_msg(pHandle, "journal write, journal full");
+           return 7;
+        }
+    }
 
-	err = mcp794xx_eeprom_write_byte(pHandle, u8Addr, (uint8_t *)pTemp_buffer, u8Length);
-	if (err)
-	{
-		a_mcp794xx_print_error_msg(pHandle, "put bytes");
-		return 1; /**< failed to write */
-	}
-	free(pTemp_buffer);
+    pHandle->sram_staging[1] = u8Addr;
+    pHandle->sram_staging[2] = u8Value;
+    pHandle->sram_staging[3] = pJournal->gen;                                      /**< generation written last commits the entry */
+    err = a_mcp794xx_sram_burst(pHandle, pJournal->base + 2 + (pJournal->count * 3), 3);
+    if(err)
+    {
+       a_mcp794xx_print_error_msg(pHandle, "journal write");
+       return 1;
+    }
+    pJournal->addr[pJournal->count] = u8Addr;
+    pJournal->value[pJournal->count] = u8Value;
+    pJournal->count++;
 
-    return 0;              /**< success */
+	return 0;   /**< success */
 }
 
 /**
- * @brief     This function reads data larger than a byte > 255 (equivalent to eeprom.get on Arduino)
- * @param[in] pHandle points to mcp794xx handle structure
- * @param[in] addr is the eeprom address to start writing
- * @param[out] *buf points to data buffer read
- * @param[in] u8Length is the buffer size
- * @return    status code
- *            - 0 success
- *            - 1 read failed
- *            - 2 handle is NULL
- *            - 3 handle is not initialized
- *            - 4 invalid address (failed to validate address)
- * @note      none
- */
-
-uint8_t mcp794xx_eeprom_get_byte(mcp794xx_handle_t *const pHandle, uint8_t u8Addr, uint32_t *pBuf, uint8_t u8Length)
+* @brief This function writes the journaled updates to the eeprom and empties the journal
+* @param[in] *pHandle points to mcp794xx handle structure
+* @return status code
+*          - 0 success
+*          - 1 failed to read or write
+*          - 2 pHandle is NULL
+*          - 3 pHandle is not initialized
+*          - 5 journal not mounted
+* @note The touched range is read once and only the changed bytes are written, one write cycle per touched
+*       page. The journal is emptied by advancing its generation byte only after the eeprom is written, a reset
+*       during the flush replays it at the next mount. When the generation wraps the entries are zeroed before
+*       the generation byte is written.
+*/
+uint8_t mcp794xx_journal_flush(mcp794xx_handle_t *const pHandle)
 {
-    uint8_t index, dataOut;
-    uint8_t *temp_buffer;
+    mcp794xx_journal_t *pJournal;
+    uint8_t currentBuf[EEPROM_MEMORY_SIZE];
+    uint8_t tempBuf[EEPROM_MEMORY_SIZE];
+    uint8_t u8Low = EEPROM_HIGHEST_ADDRESS;
+    uint8_t u8High = 0;
+    uint8_t u8Gen;
+    uint8_t index;
 
     if(pHandle == NULL)
         return 2;     /**< return failed error */
     if(pHandle->inited != 1)
         return 3;      /**< return failed error */
 
-	temp_buffer = (uint8_t*)calloc(u8Length, sizeof(uint8_t));
-
-    err = mcp794xx_eeprom_validate_page_boundary(pHandle, u8Addr, u8Length);
-    if(err != MCP794XX_DRV_OK){
-    	return err;
+    pJournal = &pHandle->journal;
+    if(pJournal->mounted != 1)
+    {
+    	a_mcp794xx_print_error_msg(pHandle, "journal flush, journal not mounted");
+    	return 5;
     }
-
-    err = (mcp794xx_eeprom_read_byte(pHandle, u8Addr, (uint8_t*) temp_buffer, u8Length));
-    if (err != MCP794XX_DRV_OK)
+    if(pJournal->count == 0)
     {
-    	a_mcp794xx_print_error_msg(pHandle, "get bytes");
-        return 1; /**< return error code */
+        return 0;   /**< nothing to flush */
     }
 
-    /**< Reverse array data to Big Indian*/
-    for (index = 0; index < (uint8_t)u8Length / 2; index++)
+    for(index = 0; index < pJournal->count; index++)
     {
-        dataOut = temp_buffer[index];
-        temp_buffer[index] = temp_buffer[u8Length - index - 1];
-        temp_buffer[u8Length - index - 1] = dataOut;
+        if(pJournal->addr[index] < u8Low)
+            u8Low = pJournal->addr[index];
+        if(pJournal->addr[index] > u8High)
+            u8High = pJournal->addr[index];
     }
 
-    memcpy(eeprom.buffer, temp_buffer, u8Length);
+    err = mcp794xx_eeprom_read_byte(pHandle, u8Low, (uint8_t *)currentBuf, (u8High - u8Low) + 1);
+    if(err)
+    {
+       a_mcp794xx_print_error_msg(pHandle, "journal flush, read");
+       return 1;
+    }
+    memcpy(tempBuf, currentBuf, (u8High - u8Low) + 1);
+    for(index = 0; index < pJournal->count; index++)
+    {
+        tempBuf[pJournal->addr[index] - u8Low] = pJournal->value[index];
+    }
+    err = a_mcp794xx_eeprom_write_diff(pHandle, u8Low, (uint8_t *)currentBuf, (uint8_t *)tempBuf, (u8High - u8Low) + 1, NULL);
+    if(err)
+    {
+       a_mcp794xx_print_error_msg(pHandle, "journal flush, write");
+       return 1;
+    }
 
-    *pBuf = (uint32_t)eeprom.data;
+    u8Gen = (pJournal->gen == 0xFF) ? 1 : (pJournal->gen + 1);
+    if(u8Gen == 1)
+    {
+        memset(&pHandle->sram_staging[1], 0x00, pJournal->capacity * 3);           /**< stale entries could carry the reused generation */
+        err = a_mcp794xx_sram_burst(pHandle, pJournal->base + 2, pJournal->capacity * 3);
+        if(err)
+        {
+           a_mcp794xx_print_error_msg(pHandle, "journal flush, clear entries");
+           return 1;
+        }
+    }
+    pHandle->sram_staging[1] = u8Gen;                                                  /**< header last, in its own transfer */
+    err = a_mcp794xx_sram_burst(pHandle, pJournal->base + 1, 1);
+    if(err)
+    {
+       a_mcp794xx_print_error_msg(pHandle, "journal flush, commit");
+       return 1;
+    }
+    pJournal->gen = u8Gen;
+    pJournal->count = 0;
 
-    return 0;              /**< success */
+	return 0;   /**< success */
 }
 
 /**
- * @brief This function write a byte to the EEPROM.
- * @param[in] pHandle points to mcp794xx handle structure
- * @param[in] u8Address is the address to write
- * @param[in] *pBuffer point to data write
- * @param[in] u8Length is the data size
- * @return status code
- *            - 0 success
- *            - 1 read failed
- *            - 2 handle is NULL
- *            - 3 handle is not initialized
- *            - 4 invalid address (failed to validate address)
- * @note    The value is written only if differs from the one already saved at the same address.
- */
-uint8_t mcp794xx_eeprom_update(mcp794xx_handle_t *const pHandle, uint8_t u8Address, uint8_t *pBuffer, uint8_t u8Length)
+* @brief This function reads one eeprom byte through the journal
+* @param[in] *pHandle points to mcp794xx handle structure
+* @param[in] u8Addr is the eeprom address
+* @param[out] *pValue points to the value read
+* @return status code
+*          - 0 success
+*          - 1 failed to read
+*          - 2 pHandle is NULL
+*          - 3 pHandle is not initialized
+*          - 4 invalid address
+*          - 5 journal not mounted
+* @note a journaled value not yet flushed is returned without a bus transfer
+*/
+uint8_t mcp794xx_journal_read(mcp794xx_handle_t *const pHandle, uint8_t u8Addr, uint8_t *pValue)
 {
-    uint8_t tempBuf[u8Length];
+    mcp794xx_journal_t *pJournal;
     uint8_t index;
 
     if(pHandle == NULL)
-        return 2;     					/**< return failed error */
+        return 2;     /**< return failed error */
     if(pHandle->inited != 1)
-        return 3;     					/**< return failed error */
-
-    memset(tempBuf, 0x00, u8Length);   	/* clear memory */
+        return 3;      /**< return failed error */
 
-    err = mcp794xx_eeprom_read_byte(pHandle, u8Address, (uint8_t *)tempBuf, u8Length);
-    if(err != MCP794XX_DRV_OK){
-    	a_mcp794xx_print_error_msg(pHandle, "update eeprom, read failed");
-    	return err;
+    pJournal = &pHandle->journal;
+    if(u8Addr > EEPROM_HIGHEST_ADDRESS)
+    {
+    	a_mcp794xx_print_error_msg(pHandle, "journal read, invalid address");
+    	return 4;
+    }
+    if(pJournal->mounted != 1)
+    {
+    	a_mcp794xx_print_error_msg(pHandle, "journal read, journal not mounted");
+    	return 5;
     }
 
-    for(index = 0; index < u8Length; index++)
+    for(index = 0; index < pJournal->count; index++)
     {
-        if(tempBuf[index] != pBuffer[index])
+        if(pJournal->addr[index] == u8Addr)
         {
-            err = mcp794xx_eeprom_write_byte(pHandle, (u8Address + index), (uint8_t*)&pBuffer[index], 1);
-            if(err != MCP794XX_DRV_OK){
-            	a_mcp794xx_print_error_msg(pHandle, "update eeprom, write failed");
-            	return err;   /**< failed error code*/
-            }
+            *pValue = pJournal->value[index];
+            return 0;
         }
+    }
 
+    err = mcp794xx_eeprom_read_byte(pHandle, u8Addr, pValue, 1);
+    if(err)
+    {
+       a_mcp794xx_print_error_msg(pHandle, "journal read");
+       return 1;
     }
 
-	return 0;    /**< success */
+	return 0;   /**< success */
 }
 
 /**
- * @brief     This function erase eeprom page
- * @param[in] pHandle points to mcp794xx handle structure
- * @param[in] u8Page_number is the eeprom page number to erase
- * @return    status code
- *            - 0 success
- *            - 1 read failed
- *            - 2 handle is NULL
- *            - 3 handle is not initialized
- *            - 4 invalid page (out of boundary)
- * @note      Page erase instruction will erase all bits (FFh) within a the given page.
- */
-uint8_t mcp794xx_eeprom_erase_page(mcp794xx_handle_t *const pHandle, uint8_t u8Page_number)
+* @brief This function computes the crc-8 (polynomial 0x07) of a buffer
+* @param[in] *pBuf points to the data
+* @param[in] u8Length is the data length
+* @return crc
+* @note initial value 0xFF, an all-zero page does not pass
+*/
+uint8_t a_mcp794xx_crc8(const uint8_t *pBuf, uint8_t u8Length)
 {
-	uint8_t page_start_addr;
-	uint8_t dummy_byte_arr[EEPROM_PAGE_SIZE];
+    uint8_t u8Crc = 0xFF;
+    uint8_t u8Bit;
 
-    if(pHandle == NULL)
-        return 2;     /**< return failed error */
-    if(pHandle->inited != 1)
-        return 3;      /**< return failed error */
+    while(u8Length--)
+    {
+        u8Crc ^= *pBuf++;
+        for(u8Bit = 0; u8Bit < 8; u8Bit++)
+        {
+            u8Crc = (u8Crc & 0x80) ? (uint8_t)((u8Crc << 1) ^ 0x07) : (uint8_t)(u8Crc << 1);
+        }
+    }
+    return u8Crc;
+}
 
-    memset((uint8_t *)dummy_byte_arr, 0xff, sizeof(dummy_byte_arr));
+/**
+* @brief This function writes a key-value record to the next free eeprom page
+* @param[in] *pHandle points to mcp794xx handle structure
+* @param[in] u8Key is the key
+* @param[in] u16Value is the value
+* @return status code
+*          - 0 success
+*          - 1 failed to write
+*          - 6 no free page
+* @note pages holding a live record, including the old record of this key, are skipped
+*/
+uint8_t a_mcp794xx_kv_append(mcp794xx_handle_t *const pHandle, uint8_t u8Key, uint16_t u16Value)
+{
+    mcp794xx_kv_t *pKv = &pHandle->kv;
+    uint8_t record[EEPROM_PAGE_SIZE];
+    uint32_t u32Seq = pKv->seq + 1;
+    uint8_t u8Slot = pKv->head;
+    uint8_t index;
 
-    err = mcp794xxx_eeprom_validate_page(pHandle, u8Page_number, (uint8_t *)&page_start_addr);
-    if(err)
+    for(index = 0; index < pKv->pages; index++)
     {
-    	a_mcp794xx_print_error_msg(pHandle, "to erase page, invalid page number");
-    	return err;
+        if(!(pKv->live & (1U << u8Slot)))
+        {
+            break;
+        }
+        u8Slot = (u8Slot + 1) % pKv->pages;
+    }
+    if(index == pKv->pages)
+    {
+        return 6;
     }
 
-    err = mcp794xx_eeprom_write_byte(pHandle, page_start_addr, (uint8_t *)dummy_byte_arr, EEPROM_PAGE_SIZE);
-    if(err)
+    record[0] = u8Key;
+    record[1] = (uint8_t)u32Seq;
+    record[2] = (uint8_t)(u32Seq >> 8);
+    record[3] = (uint8_t)(u32Seq >> 16);
+    record[4] = (uint8_t)(u32Seq >> 24);
+    record[5] = (uint8_t)u16Value;
+    record[6] = (uint8_t)(u16Value >> 8);
+    record[7] = a_mcp794xx_crc8(record, EEPROM_PAGE_SIZE - 1);
+    if(mcp794xx_eeprom_write_byte(pHandle, u8Slot * EEPROM_PAGE_SIZE, (uint8_t *)record, EEPROM_PAGE_SIZE) != MCP794XX_DRV_OK)
     {
-    	a_mcp794xx_print_error_msg(pHandle, "to erase page");
-    	return err;
+        return 1;
     }
 
-    return 0;              /**< success */
+    if(pKv->slot[u8Key] != MCP794XX_KV_NO_SLOT)
+    {
+        pKv->live &= ~(1U << pKv->slot[u8Key]);                           /**< old copy is free now */
+    }
+    pKv->live |= (1U << u8Slot);
+    pKv->slot[u8Key] = u8Slot;
+    pKv->key_seq[u8Key] = u32Seq;
+    pKv->value[u8Key] = u16Value;
+    pKv->seq = u32Seq;
+    pKv->head = (u8Slot + 1) % pKv->pages;
+
+    return 0;
 }
 
 /**
- * @brief     This function erase a sector stored data
- * @param[in] pHandle points to mcp794xx handle structure
- * @param[in] pSector_addr is the eeprom sector address (start address and end address) to erase
- * @return    status code
- *            - 0 success
- *            - 1 erase failed
- *            - 2 handle is NULL
- *            - 3 handle is not initialized
- *            - 4 invalid address
- * @note      sector erase instruction will erase all bits (FFh) within a given sector
- */
-uint8_t mcp794xx_eeprom_erase_sector(mcp794xx_handle_t *const pHandle, uint8_t *pSector_addr)
+* @brief This function mounts the eeprom key-value store
+* @param[in] *pHandle points to mcp794xx handle structure
+* @return status code
+*          - 0 success
+*          - 1 failed to read
+*          - 2 pHandle is NULL
+*          - 3 pHandle is not initialized
+*          - 4 invalid device variant
+*          - 6 the unprotected eeprom holds MCP794XX_KV_MAX_KEYS pages or less
+* @note The array is read in one burst. A spare page is needed so that a key can be rewritten while every
+*       key is stored, the mount fails when the block protected area leaves no spare page. Every page holds one record (key, 32-bit sequence, 16-bit value, crc-8),
+*       the newest valid record of each key is indexed in RAM. Pages with a bad crc are treated as free.
+*/
+uint8_t mcp794xx_kv_mount(mcp794xx_handle_t *const pHandle)
 {
-	uint8_t index;
-	uint8_t dummy_data = 0xff;
+    mcp794xx_kv_t *pKv;
+    uint8_t tempBuf[EEPROM_MEMORY_SIZE];
+    uint8_t *pRecord;
+    uint32_t u32Seq;
+    uint8_t u8Newest = 0;
+    uint8_t u8Key;
+    uint8_t index;
 
     if(pHandle == NULL)
         return 2;     /**< return failed error */
     if(pHandle->inited != 1)
         return 3;      /**< return failed error */
 
-    for(index = pSector_addr[0]; index < pSector_addr[1]; index++){
-        err = mcp794xx_eeprom_write_byte(pHandle, index, (uint8_t *)&dummy_data, 1);
-        if(err)
+    pKv = &pHandle->kv;
+    memset(pKv, 0, sizeof(mcp794xx_kv_t));
+    memset(pKv->slot, MCP794XX_KV_NO_SLOT, sizeof(pKv->slot));
+
+    err = mcp794xx_eeprom_check_bp_before_write(pHandle, 0);            /**< caches the block protect bound */
+    if(err == 4)
+    {
+    	a_mcp794xx_print_error_msg(pHandle, "mount kv store, invalid device variant");
+    	return 4;
+    }
+    pKv->pages = pHandle->eeprom_bp_bound / EEPROM_PAGE_SIZE;
+    if(pKv->pages <= MCP794XX_KV_MAX_KEYS)
+    {
+    	a_mcp794xx_print_error_msg(pHandle, "mount kv store, too few unprotected eeprom pages");
+    	return 6;
+    }
+
+    err = mcp794xx_eeprom_read_byte(pHandle, 0x00, (uint8_t *)tempBuf, EEPROM_MEMORY_SIZE);
+    if(err)
+    {
+       a_mcp794xx_print_error_msg(pHandle, "mount kv store, read");
+       return 1;
+    }
+
+    for(index = 0; index < pKv->pages; index++)
+    {
+        pRecord = &tempBuf[index * EEPROM_PAGE_SIZE];
+        u8Key = pRecord[0];
+        if((u8Key >= MCP794XX_KV_MAX_KEYS) || (a_mcp794xx_crc8(pRecord, EEPROM_PAGE_SIZE - 1) != pRecord[EEPROM_PAGE_SIZE - 1]))
         {
-        	a_mcp794xx_print_error_msg(pHandle, "erase eeprom sector");
-            return 1;           /**< failed error */
+            continue;                                                    /**< free, torn or erased page */
+        }
+        u32Seq = ((uint32_t)pRecord[1]) | ((uint32_t)pRecord[2] << 8) | ((uint32_t)pRecord[3] << 16) | ((uint32_t)pRecord[4] << 24);
+        if((pKv->slot[u8Key] != MCP794XX_KV_NO_SLOT) && (u32Seq < pKv->key_seq[u8Key]))
+        {
+            continue;                                                    /**< superseded copy */
+        }
+        if(pKv->slot[u8Key] != MCP794XX_KV_NO_SLOT)
+        {
+            pKv->live &= ~(1U << pKv->slot[u8Key]);
+        }
+        pKv->slot[u8Key] = index;
+        pKv->key_seq[u8Key] = u32Seq;
+        pKv->value[u8Key] = (uint16_t)pRecord[5] | ((uint16_t)pRecord[6] << 8);
+        pKv->live |= (1U << index);
+        if(u32Seq >= pKv->seq)
+        {
+            pKv->seq = u32Seq;
+            u8Newest = index;
         }
     }
+    pKv->head = (pKv->live == 0) ? 0 : ((u8Newest + 1) % pKv->pages);
+    pKv->mounted = 1;
 
-    return 0;              /**< success */
+	return 0;   /**< success */
 }
 
 /**
- * @brief     This function erase chip stored data
- * @param[in] pHandle points to mcp794xx handle structure
- * @return    status code
- *            - 0 success
- *            - 1 erase failed
- *            - 2 handle is NULL
- *            - 3 handle is not initialized
- * @note      chip erase instruction will erase all bits (FFh) in the array.
- */
-uint8_t mcp794xx_eeprom_erase_chip(mcp794xx_handle_t *const pHandle)
+* @brief This function stores a value in the eeprom key-value store
+* @param[in] *pHandle points to mcp794xx handle structure
+* @param[in] u8Key is the key (0 - MCP794XX_KV_MAX_KEYS-1)
+* @param[in] u16Value is the value
+* @return status code
+*          - 0 success
+*          - 1 failed to write
+*          - 2 pHandle is NULL
+*          - 3 pHandle is not initialized
+*          - 4 invalid key
+*          - 5 store not mounted
+*          - 6 no free page
+* @note One page write, the record goes to the next free page after the previous write so wear rotates over
+*       the array. The old record stays valid until the new one is written. An unchanged value is not written.
+*/
+uint8_t mcp794xx_kv_put(mcp794xx_handle_t *const pHandle, uint8_t u8Key, uint16_t u16Value)
 {
-	uint8_t index;
-	uint8_t dummy_data_arr[EEPROM_PAGE_SIZE];
-
     if(pHandle == NULL)
         return 2;     /**< return failed error */
     if(pHandle->inited != 1)
         return 3;      /**< return failed error */
 
-    memset((uint8_t *)dummy_data_arr, 0xff, sizeof(dummy_data_arr));          /**< fill the entire array with a value of 0xff */
+    if(u8Key >= MCP794XX_KV_MAX_KEYS)
+    {
+    	a_mcp794xx_print_error_msg(pHandle, "kv put, invalid key");
+    	return 4;
+    }
+    if(pHandle->kv.mounted != 1)
+    {
+    	a_mcp794xx_print_error_msg(pHandle, "kv put, store not mounted");
+    	return 5;
+    }
+    if((pHandle->kv.slot[u8Key] != MCP794XX_KV_NO_SLOT) && (pHandle->kv.value[u8Key] == u16Value))
+    {
+        return 0;   /**< already stored */
+    }
 
-    for(index = EEPROM_LOWEST_ADDRESS; index < EEPROM_MEMORY_SIZE; (index += EEPROM_PAGE_SIZE))
+    err = a_mcp794xx_kv_append(pHandle, u8Key, u16Value);
+    if(err == 6)
     {
-        err = mcp794xx_eeprom_write_byte(pHandle, index, (uint8_t *)dummy_data_arr, EEPROM_PAGE_SIZE);
-        if(err)
-        {
-        	a_mcp794xx_print_error_msg(pHandle, "wipe eeprom");
-            return 1;           /**< failed error */
-        }
+    	a_mcp794xx_print_error_msg(pHandle, "kv put, no free page");
+    }else if(err)
+    {
+    	a_mcp794xx_print_error_msg(pHandle, "kv put, write");
     }
 
-    return 0;              /**< success */
+	return err;
 }
 
-
 /**
- * @brief     This function set write enable latch status
- * @param[in] pHandle points to mcp794xx handle structure
- * @param[in] status is the value to write
- * @return    status code
- *            - 0 success
- *            - 1 set bp failed
- *            - 2 handle is NULL
- *            - 3 handle is not initialized
- * @note      none
- */
-uint8_t mcp794xx_eeprom_set_bp_status(mcp794xx_handle_t *const pHandle, mcp794xx_eeprom_block_protect_stat_t status)
+* @brief This function reads a value from the eeprom key-value store
+* @param[in] *pHandle points to mcp794xx handle structure
+* @param[in] u8Key is the key (0 - MCP794XX_KV_MAX_KEYS-1)
+* @param[out] *pValue points to the value read
+* @return status code
+*          - 0 success
+*          - 2 pHandle is NULL
+*          - 3 pHandle is not initialized
+*          - 4 invalid key
+*          - 5 store not mounted
+*          - 6 key not found
+* @note served from the RAM index, no bus transfer
+*/
+uint8_t mcp794xx_kv_get(mcp794xx_handle_t *const pHandle, uint8_t u8Key, uint16_t *pValue)
 {
-    uint8_t block_protect_status = 0;
-
     if(pHandle == NULL)
         return 2;     /**< return failed error */
     if(pHandle->inited != 1)
         return 3;      /**< return failed error */
 
-    block_protect_status |=  (status << 2);
-    err = eeprom_mcp794xx_i2c_write(pHandle, EEPROM_BLOCK_PROTECT_REG, (uint8_t *)&block_protect_status, 1);
-    if(err)
+    if(u8Key >= MCP794XX_KV_MAX_KEYS)
     {
-        a_mcp794xx_print_error_msg(pHandle, "write eeprom block protect  reg");
-        return 1;           /**< failed error */
+    	a_mcp794xx_print_error_msg(pHandle, "kv get, invalid key");
+    	return 4;
+    }
+    if(pHandle->kv.mounted != 1)
+    {
+    	a_mcp794xx_print_error_msg(pHandle, "kv get, store not mounted");
+    	return 5;
+    }
+    if(pHandle->kv.slot[u8Key] == MCP794XX_KV_NO_SLOT)
+    {
+        return 6;   /**< not stored */
     }
+    *pValue = pHandle->kv.value[u8Key];
 
-    return 0;              /**< success */
+	return 0;   /**< success */
 }
 
 /**
- * @brief     This function get write enable latch status
- * @param[in] pHandle points to mcp794xx handle structure
- * @param[out] *pStatus is the value to write
- * @return    status code
- *            - 0 success
- *            - 1 get bp failed
- *            - 2 handle is NULL
- *            - 3 handle is not initialized
- * @note      none
- */
-uint8_t mcp794xx_eeprom_get_bp_status(mcp794xx_handle_t *const pHandle, mcp794xx_eeprom_block_protect_stat_t *pStatus)
+* @brief This function compacts the eeprom key-value store
+* @param[in] *pHandle points to mcp794xx handle structure
+* @return status code
+*          - 0 success
+*          - 1 failed to write
+*          - 2 pHandle is NULL
+*          - 3 pHandle is not initialized
+*          - 5 store not mounted
+* @note Every live record is rewritten, oldest first, at the write position. Records of keys that never change
+*       move on and stop pinning their pages, the free pages become one run. Costs one page write per key.
+*/
+uint8_t mcp794xx_kv_compact(mcp794xx_handle_t *const pHandle)
 {
-	uint8_t block_protect_status = 0;
+    mcp794xx_kv_t *pKv;
+    uint8_t keys[MCP794XX_KV_MAX_KEYS];
+    uint8_t u8Count = 0;
+    uint8_t u8Slot;
+    uint8_t index;
+    uint8_t u8Key;
 
     if(pHandle == NULL)
         return 2;     /**< return failed error */
     if(pHandle->inited != 1)
         return 3;      /**< return failed error */
 
-    err = eeprom_mcp794xx_i2c_read(pHandle, EEPROM_BLOCK_PROTECT_REG, (uint8_t *)&block_protect_status, 1);
-    if(err)
+    pKv = &pHandle->kv;
+    if(pKv->mounted != 1)
     {
-    	a_mcp794xx_print_error_msg(pHandle, "read eeprom block protect reg");
-        return 1;           /**< failed error */
+    	a_mcp794xx_print_error_msg(pHandle, "kv compact, store not mounted");
+    	return 5;
     }
 
-    *pStatus = (mcp794xx_eeprom_block_protect_stat_t)(block_protect_status & EEPROM_BLOCK_PROTECT_MASK) >> 2;
+    for(index = 0; index < pKv->pages; index++)                          /**< live keys, oldest page first */
+    {
+        u8Slot = (pKv->head + index) % pKv->pages;
+        for(u8Key = 0; u8Key < MCP794XX_KV_MAX_KEYS; u8Key++)
+        {
+            if(pKv->slot[u8Key] == u8Slot)
+            {
+                keys[u8Count++] = u8Key;
+            }
+        }
+    }
 
-    return 0;               /**< success */
+    for(index = 0; index < u8Count; index++)
+    {
+        err = a_mcp794xx_kv_append(pHandle, keys[index], pKv->value[keys[index]]);
+        if(err)
+        {
+           a_mcp794xx_print_error_msg(pHandle, "kv compact, write");
+           return 1;
+        }
+    }
+
+	return 0;   /**< success */
 }
 
 /**
@@ -3698,64 +8098,35 @@ uint8_t mcp794xx_eeprom_get_bp_status(mcp794xx_handle_t *const pHandle, mcp794xx
  *          - 2 handle is NULL
  *          - 3 handle is not initialized
  *          - 4 invalid device variant
- * @note    none
+ * @note    The block protect status is read once and cached as the first protected address,
+ *          mcp794xx_eeprom_set_bp_status and mcp794xx_eeprom_get_bp_status refresh it.
  */
 uint8_t mcp794xx_eeprom_check_bp_before_write(mcp794xx_handle_t *const pHandle, uint8_t u8Address)
 {
-	uint8_t status;
+	mcp794xx_eeprom_block_protect_stat_t status;
 
     if(pHandle == NULL)
         return 2;     /**< return failed error */
     if(pHandle->inited != 1)
         return 3;      /**< return failed error */
 
-   err = mcp794xx_eeprom_get_bp_status(pHandle, (uint8_t *)&status);
-   if(err != MCP794XX_DRV_OK){
-	   a_mcp794xx_print_error_msg(pHandle, "to verify memory block protect status");
-	   return err;
-   }
-
    if(pHandle->device_variant == MCP79400_VARIANT || pHandle->device_variant == MCP7940M_VARIANT || pHandle->device_variant == MCP7940N_VARIANT || pHandle->device_variant == MCP79410_VARIANT){
 	   a_mcp794xx_print_error_msg(pHandle, "invalid device variant, the device does have a eeprom built-in");
 	   return 4;
    }
 
-   switch(status)
+   if(pHandle->eeprom_bp_valid != 1)
    {
-		case MCP794XX_EEPROM_BP00:
-		{
-		   return 0;
-		   break;
-		}
-
-		case MCP794XX_EEPROM_BP01:
-		{
-			if (u8Address >= (uint8_t )(EEPROM_MEMORY_SIZE * 0.75))
-			{
-				return 1;
-			}else{
-				return 0;
-			}
-
-			break;
-		}
-
-		case MCP794XX_EEPROM_BP10:
-		{
-			if (u8Address >= (uint8_t )(EEPROM_MEMORY_SIZE * 0.5))
-			{
-				return 1;
-			}else{
-				return 0;
-			}
-			break;
-		}
+	   err = mcp794xx_eeprom_get_bp_status(pHandle, &status);      /**< first write only, then cached */
+	   if(err != MCP794XX_DRV_OK){
+		   a_mcp794xx_print_error_msg(pHandle, "to verify memory block protect status");
+		   return err;
+	   }
+   }
 
-		case MCP794XX_EEPROM_BP11:
-		{
-			return 1;
-			break;
-		}
+   if(u8Address >= pHandle->eeprom_bp_bound)
+   {
+	   return 1;      /**< protected */
    }
 
     return 0;              /**< success */
@@ -3885,7 +8256,7 @@ uint8_t mcp794xx_set_reg(mcp794xx_handle_t *const pHandle, uint8_t u8Reg, uint8_
         return 3;      /**< return failed error */
 
 
-    err = rtc_mcp794xx_i2c_write(pHandle, u8Reg, (uint8_t *)buf);
+    err = rtc_mcp794xx_i2c_write(pHandle, u8Reg, (uint8_t *)buf, (uint8_t)u8Len);
     if(err)
     {
         a_mcp794xx_print_error_msg(pHandle, "write register");
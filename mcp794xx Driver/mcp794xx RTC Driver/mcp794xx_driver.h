@@ -139,9 +139,39 @@
 
 #define MCP794XX_TIME_BUFFER_SIZE    7                                              /**< Time buffer size */
 #define MCP794XX_PWRFAIL_BUFFER_LENGTH 4                                            /**< power fail register buffer */
+#define MCP794XX_OSC_STATUS_TIMEOUT_MS 1000                                         /**< OSCRUN polling timeout (ms), polls without get_tick_ms and delay_ms */
+#define MCP794XX_EEPROM_WRITE_TIMEOUT_MS 10                                         /**< default eeprom write cycle (ACK) polling timeout (ms) */
+#define MCP794XX_BURST_MAX_GAP       3                                              /**< clean registers rewritten to join two bursts rather than start a new transfer */
+#define MCP794XX_OSC_START_DELAY_MS  10                                             /**< wait after starting a stopped oscillator (ms) */
+#define MCP794XX_SUBSEC_SYNC_MAX_POLLS 100000UL                                     /**< seconds register reads before the sub-second calibration gives up */
+#define MCP794XX_SUBSEC_MAX_RETRY    4                                              /**< time snapshots tried for a sub-second time stamp */
+#define MCP794XX_SRAM_LOG_MAGIC      0x4C                                           /**< first header byte of a formatted sram event log */
+#define MCP794XX_JOURNAL_MAGIC       0x4A                                           /**< first header byte of a formatted sram journal */
+#define MCP794XX_JOURNAL_MAX_ENTRIES ((SRAM_MEMORY_SIZE - 2) / 3)                   /**< journal entries the whole sram holds (address, value, generation) */
+#define MCP794XX_KV_MAX_KEYS         8                                              /**< key-value store keys, at most one less than the eeprom pages */
+#define MCP794XX_KV_NO_SLOT          0xFF                                           /**< key-value index entry of a key not stored */
+#define MCP794XX_SCHED_MAX_ALARMS    16                                             /**< software alarms the scheduler holds */
+#define MCP794XX_SCHED_FREE          0xFF                                           /**< scheduler position of a free software alarm id */
+#define MCP794XX_IRQ_ALARM0_FLAG     0x01                                           /**< ALARM0 serviced by mcp794xx_irq_service */
+#define MCP794XX_IRQ_ALARM1_FLAG     0x02                                           /**< ALARM1 serviced by mcp794xx_irq_service */
+#define MCP794XX_EVENT_QUEUE_SIZE    8                                              /**< alarm events queued between two mcp794xx_process_events calls (power of 2) */
+#define MCP794XX_CRON_ALL_MINUTE     0x0FFFFFFFFFFFFFFFULL                          /**< cron minutes 0 - 59 */
+#define MCP794XX_CRON_ALL_HOUR       0x00FFFFFFUL                                   /**< cron hours 0 - 23 */
+#define MCP794XX_CRON_ALL_DOM        0xFFFFFFFEUL                                   /**< cron days of month 1 - 31 */
+#define MCP794XX_CRON_ALL_MONTH      0x1FFE                                         /**< cron months 1 - 12 */
+#define MCP794XX_CRON_ALL_DOW        0x7F                                           /**< cron days of week 0 - 6 (Sunday 0) */
+#define MCP794XX_CRON_NONE           0xFF                                           /**< no cron field value left */
+#define MCP794XX_CRON_MAX_STEPS      1000                                           /**< field moves tried by mcp794xx_cron_next before giving up */
+#define MCP794XX_SHADOW_SIZE         0x20                                           /**< shadowed RTCC register block size (0x00 - 0x1F) */
+#define MCP794XX_SHADOW_CACHED_REGS  ((1UL << MCP794XX_RTC_WKDAY_REG) | (1UL << MCP794XX_CONTROL_REG) | \
+                                      (1UL << MCP794XX_OSC_TRIM_REG) | (1UL << MCP794XX_ALM0_WKDAY_REG) | \
+                                      (1UL << MCP794XX_ALM1_WKDAY_REG))             /**< configuration registers held in the shadow */
 
 #define USE_COMPILE_TIME_DATE                                                       /**< enables the use of compile time and date */
 #define SECONDS_FROM_Y1970_TO_Y2000					 946684800UL
+#define MCP794XX_CENTURY_BASE_DEFAULT 2000                                          /**< RTCYEAR 00..99 maps to 2000..2099 by default */
+#define MCP794XX_EPOCH64_MIN         (-62167219200LL)                               /**< 64-bit epoch of 0000-01-01 00:00:00 */
+#define MCP794XX_EPOCH64_MAX         253402300799LL                                 /**< 64-bit epoch of 9999-12-31 23:59:59 */
 
 /** EEPROM Definitions **/
 #define EEPROM_BLOCK_PROTECT_REG   0xff												/**< eeprom block register register */
@@ -172,6 +202,11 @@ static const uint8_t days_in_month [12]= {31,28,31,30,31,30,31,31,30,31,30,31};
 */
 typedef uint8_t (*mcp794xx_irq_callback_t)(mcp794xx_alarm_t);
 
+/**
+* @brief mcp794xx software alarm callback definition
+*/
+typedef void (*mcp794xx_sched_callback_t)(uint8_t u8Id);
+
 /**
 * @brief execution status enumeration
 */
@@ -400,6 +435,16 @@ typedef enum{
     MCP794XX_CNTDWN_HOURS   = 0x02,                                       /**< count down hours */
 }mcp794xx_countdwon_time_unit_t;
 
+/**
+* @brief mcp794xx hardware alarm owner enumeration
+*/
+typedef enum{
+    MCP794XX_ALARM_OWNER_NONE     = 0x00,                                 /**< alarm free */
+    MCP794XX_ALARM_OWNER_SCHED    = 0x01,                                 /**< software alarm scheduler */
+    MCP794XX_ALARM_OWNER_PERIODIC = 0x02,                                 /**< periodic timer */
+    MCP794XX_ALARM_OWNER_CRON     = 0x03,                                 /**< cron alarm */
+}mcp794xx_alarm_owner_t;
+
 /**
 * @brief mcp794xx eeprom data read enumeration
 */
@@ -443,6 +488,190 @@ typedef struct mcp794xx_info_s
     float driver_version;                                               /**< driver version */
 } mcp794xx_info_t;
 
+/**
+ * @brief mcp794xx shadow register structure definition
+ */
+typedef struct mcp794xx_shadow_s
+{
+    uint8_t reg[MCP794XX_SHADOW_SIZE];                                  /**< RAM copy of the RTCC register block */
+    uint32_t valid;                                                     /**< one bit per register, set when reg[] matches the chip */
+    uint32_t dirty;                                                     /**< one bit per register, set when reg[] is not yet written to the chip */
+    uint8_t enable;                                                     /**< shadow enable status */
+    uint8_t txn;                                                        /**< configuration transaction in progress */
+    uint8_t txn_prev_enable;                                            /**< shadow enable status before the transaction */
+} mcp794xx_shadow_t;
+
+/**
+ * @brief mcp794xx eeprom mirror structure definition
+ */
+typedef struct mcp794xx_eeprom_mirror_s
+{
+    uint8_t data[EEPROM_MEMORY_SIZE];                                   /**< RAM copy of the eeprom array */
+    uint16_t valid;                                                     /**< one bit per page, set when data[] matches the chip */
+    uint8_t enable;                                                     /**< mirror enable status */
+} mcp794xx_eeprom_mirror_t;
+
+/**
+ * @brief mcp794xx sram event log structure definition
+ */
+typedef struct mcp794xx_sram_log_s
+{
+    uint8_t base;                                                       /**< first sram address of the log (header) */
+    uint8_t end;                                                        /**< last sram address of the log */
+    uint8_t record_size;                                                /**< payload bytes per record */
+    uint8_t slots;                                                      /**< number of records the log holds */
+    uint8_t head;                                                       /**< next slot written */
+    uint8_t seq;                                                        /**< stamp of the newest record, 0 when empty */
+    uint8_t count;                                                      /**< records held */
+    uint8_t mounted;                                                    /**< log geometry and head are valid */
+} mcp794xx_sram_log_t;
+
+/**
+ * @brief mcp794xx sram write-ahead journal structure definition
+ */
+typedef struct mcp794xx_journal_s
+{
+    uint8_t addr[MCP794XX_JOURNAL_MAX_ENTRIES];                         /**< journaled eeprom addresses */
+    uint8_t value[MCP794XX_JOURNAL_MAX_ENTRIES];                        /**< journaled values */
+    uint8_t base;                                                       /**< first sram address of the journal (header) */
+    uint8_t capacity;                                                   /**< entries the journal range holds */
+    uint8_t count;                                                      /**< entries not yet flushed */
+    uint8_t gen;                                                        /**< generation marking the live entries */
+    uint8_t mounted;                                                    /**< journal geometry and entries are valid */
+} mcp794xx_journal_t;
+
+/**
+ * @brief mcp794xx eeprom key-value store structure definition
+ */
+typedef struct mcp794xx_kv_s
+{
+    uint32_t key_seq[MCP794XX_KV_MAX_KEYS];                             /**< sequence number of the live record of each key */
+    uint16_t value[MCP794XX_KV_MAX_KEYS];                               /**< value of each key */
+    uint8_t slot[MCP794XX_KV_MAX_KEYS];                                 /**< page of the live record, MCP794XX_KV_NO_SLOT if not stored */
+    uint32_t seq;                                                       /**< newest sequence number written */
+    uint16_t live;                                                      /**< one bit per page holding a live record */
+    uint8_t pages;                                                      /**< pages below the block protected area */
+    uint8_t head;                                                       /**< page the next record is tried at */
+    uint8_t mounted;                                                    /**< index is valid */
+} mcp794xx_kv_t;
+
+/**
+ * @brief mcp794xx software alarm scheduler structure definition
+ */
+typedef struct mcp794xx_sched_s
+{
+    uint32_t deadline[MCP794XX_SCHED_MAX_ALARMS];                       /**< deadline of each software alarm id (unix epoch) */
+    mcp794xx_sched_callback_t callback[MCP794XX_SCHED_MAX_ALARMS];      /**< callback of each software alarm id */
+    uint8_t heap[MCP794XX_SCHED_MAX_ALARMS];                            /**< min-heap of pending ids, earliest deadline first */
+    uint8_t pos[MCP794XX_SCHED_MAX_ALARMS];                             /**< heap index of each id, MCP794XX_SCHED_FREE if not pending */
+    uint32_t armed_deadline;                                            /**< deadline programmed in the hardware alarm */
+    uint8_t count;                                                      /**< pending software alarms */
+    uint8_t alarm;                                                      /**< hardware alarm owned by the scheduler */
+    uint8_t armed;                                                      /**< hardware alarm enabled */
+    uint8_t running;                                                    /**< due alarms are being called */
+    uint8_t started;                                                    /**< scheduler started */
+} mcp794xx_sched_t;
+
+/**
+ * @brief mcp794xx periodic timer structure definition
+ */
+typedef struct mcp794xx_periodic_s
+{
+    uint32_t period;                                                    /**< period (seconds) */
+    uint32_t deadline;                                                  /**< deadline programmed in the alarm (unix epoch) */
+    uint8_t hour_bits;                                                  /**< alarm hour register format bit kept on re-arm */
+    uint8_t alarm;                                                      /**< hardware alarm used */
+    uint8_t started;                                                    /**< timer running */
+} mcp794xx_periodic_t;
+
+/**
+ * @brief mcp794xx alarm event queue structure definition (single producer, single consumer)
+ */
+typedef struct mcp794xx_event_queue_s
+{
+    volatile uint32_t tick[MCP794XX_EVENT_QUEUE_SIZE];                  /**< event time stamps (get_tick_ms) */
+    volatile uint8_t head;                                              /**< free running write index, written by the interrupt only */
+    volatile uint8_t tail;                                              /**< free running read index, written by mcp794xx_process_events only */
+    volatile uint8_t dropped;                                           /**< events dropped on a full queue */
+} mcp794xx_event_queue_t;
+
+/**
+ * @brief mcp794xx compiled cron rule structure definition
+ */
+typedef struct mcp794xx_cron_s
+{
+    uint64_t minute;                                                    /**< allowed minutes, one bit per value */
+    uint32_t hour;                                                      /**< allowed hours */
+    uint32_t dom;                                                       /**< allowed days of month */
+    uint16_t month;                                                     /**< allowed months */
+    uint8_t dow;                                                        /**< allowed days of week, bit 0 Sunday */
+    uint8_t dom_star;                                                   /**< day of month covers 1 - 31 */
+    uint8_t dow_star;                                                   /**< day of week covers every day */
+    uint8_t mask;                                                       /**< hardware alarm mask (mcp794xx_alarm_mask_t) */
+    uint8_t hardware;                                                   /**< 1 when the mask alone expresses the rule */
+} mcp794xx_cron_t;
+
+/**
+ * @brief mcp794xx cron alarm structure definition
+ */
+typedef struct mcp794xx_cron_alarm_s
+{
+    mcp794xx_cron_t rule;                                               /**< rule in use */
+    uint32_t deadline;                                                  /**< match programmed in the alarm (unix epoch), full mask rules */
+    uint8_t alarm;                                                      /**< hardware alarm used */
+    uint8_t started;                                                    /**< cron alarm running */
+} mcp794xx_cron_alarm_t;
+
+/**
+ * @brief mcp794xx init profile structure definition
+ */
+typedef struct mcp794xx_init_profile_s
+{
+    mcp794xx_bool_t alarm0_enable;                                      /**< alarm 0 enable status */
+    mcp794xx_bool_t alarm1_enable;                                      /**< alarm 1 enable status */
+    mcp794xx_bool_t clr_alarm_flags;                                    /**< clear ALM0IF and ALM1IF */
+    mcp794xx_mfp_logic_level_t mfp_logic_level;                         /**< MFP general purpose output level */
+    mcp794xx_bool_t sqr_wave_enable;                                    /**< square wave output enable status */
+    mcp94xx_sqr_wave_freq_t sqr_wave_freq;                              /**< square wave output frequency */
+    mcp794xx_bool_t coarse_trim_enable;                                 /**< coarse trim mode enable status */
+    mcp794xx_osc_status_t ext_osc_enable;                               /**< external oscillator input enable status */
+    mcp794xx_bool_t trim_update;                                        /**< write OSCTRIM, else it is left as found */
+    mcp794xx_trim_sign_t trim_sign;                                     /**< digital trim sign */
+    mcp794xx_trim_val_t trim_value;                                     /**< digital trim value (0 - 127) */
+    mcp794xx_bool_t ext_batt_update;                                    /**< write VBATEN, else it is left as found */
+    mcp794xx_bool_t ext_batt_enable;                                    /**< external battery backup enable status */
+    uint8_t control_reg;                                                /**< compiled CONTROL register value */
+    uint8_t trim_reg;                                                   /**< compiled OSCTRIM register value */
+    uint8_t validated;                                                  /**< set by mcp794xx_init_profile_validate */
+} mcp794xx_init_profile_t;
+
+/**
+* @brief mcp794xx host interpolated clock structure
+*/
+typedef struct mcp794xx_clock_s
+{
+    volatile int64_t anchor_sec;                                        /**< epoch seconds of the anchor */
+    volatile uint32_t anchor_tick;                                      /**< MCU tick at the anchor */
+    volatile uint16_t anchor_frac_ms;                                   /**< sub-second part of the anchor (0 - 999) */
+    volatile uint8_t phase_locked;                                      /**< anchor phase known from the 1 Hz edge */
+    volatile uint8_t valid;                                             /**< clock is anchored */
+    volatile uint8_t seq;                                               /**< update sequence, odd while the anchor is written */
+    volatile int32_t last_correction_ms;                                /**< prediction minus RTC at the last re-anchor */
+    uint32_t resync_interval_ms;                                        /**< bus re-anchor interval, 0 none */
+    uint32_t drift_ppm;                                                 /**< combined RTC and tick tolerance */
+} mcp794xx_clock_t;
+
+/**
+* @brief mcp794xx sub-second edge counter structure
+*/
+typedef struct mcp794xx_subsec_s
+{
+    uint32_t boundary_count;                                            /**< edge count at a second boundary */
+    uint32_t freq_hz;                                                   /**< square wave frequency */
+    uint32_t window;                                                    /**< calibration uncertainty in edges, the boundary is at most this late */
+    uint8_t valid;                                                      /**< counter is calibrated */
+} mcp794xx_subsec_t;
+
 /**
 * @brief mcp794xx handle enumeration
 */
@@ -452,9 +681,13 @@ typedef struct mcp794xx_handle_s
     uint8_t (*i2c_deinit)(void);                                                                /**< point to a i2c deinit function address */
     uint8_t (*i2c_read)(uint8_t u8Addr, uint8_t *pBuf,  uint8_t u8Length);                      /**< point to a i2c read function address */
     uint8_t (*i2c_write)(uint8_t u8Addr, uint8_t *pBuf,  uint8_t u8Length);                     /**< point to a i2c write function address */
+    uint8_t (*i2c_write_read)(uint8_t u8Addr, uint8_t *pWrite_buf, uint8_t u8Write_length,
+                              uint8_t *pRead_buf, uint8_t u8Read_length);                       /**< point to a i2c write then read (repeated start) function address, optional */
     void (*delay_ms)(uint32_t u32Ms);                                                           /**< point to a delay_ms function address */
     void(*debug_print)(char *fmt, ...);                                                         /**< point to a debug_print function address */
     void (*receive_callback)(uint8_t u8Flag);                                                   /**< point to a receive callback function address */
+    uint32_t (*get_tick_ms)(void);                                                              /**< point to a monotonic ms tick function address, optional */
+    uint32_t (*get_edge_count)(void);                                                           /**< point to a MFP square wave edge counter function address, optional */
     uint8_t rtc_address;                                                                        /**< rtc device address */
     uint8_t eeprom_address;                                                                     /**< eeprom device address */
     uint8_t device_variant;                                                                     /**< Device variant */
@@ -462,6 +695,23 @@ typedef struct mcp794xx_handle_s
     int buffer_size;                                                                            /**< debug function buffer size */
     mcp794xx_info_t info;
     mcp794xx_time_t time_param;
+    mcp794xx_shadow_t shadow;                                                                   /**< configuration register shadow */
+    uint16_t century_base;                                                                      /**< first year of the RTCYEAR century window */
+    mcp794xx_clock_t clock;                                                                     /**< host interpolated clock */
+    mcp794xx_subsec_t subsec;                                                                   /**< sub-second edge counter */
+    uint16_t eeprom_timeout_ms;                                                                 /**< eeprom write cycle polling timeout */
+    mcp794xx_eeprom_mirror_t eeprom_mirror;                                                     /**< eeprom RAM mirror */
+    uint8_t eeprom_bp_bound;                                                                    /**< first block protected eeprom address */
+    uint8_t eeprom_bp_valid;                                                                    /**< eeprom_bp_bound matches the chip */
+    mcp794xx_sram_log_t sram_log;                                                               /**< sram event log */
+    uint8_t sram_staging[SRAM_MEMORY_SIZE + 1];                                                 /**< sram burst staging buffer, address byte then data */
+    mcp794xx_journal_t journal;                                                                 /**< sram write-ahead eeprom journal */
+    mcp794xx_kv_t kv;                                                                           /**< eeprom key-value store */
+    mcp794xx_sched_t sched;                                                                     /**< software alarm scheduler */
+    mcp794xx_periodic_t periodic;                                                               /**< self re-arming periodic timer */
+    mcp794xx_event_queue_t events;                                                              /**< alarm interrupt event queue */
+    mcp794xx_cron_alarm_t cron;                                                                 /**< cron recurring alarm */
+    uint8_t alarm_owner[2];                                                                     /**< feature owning each hardware alarm (mcp794xx_alarm_owner_t) */
 } mcp794xx_handle_t;
 
 
@@ -519,6 +769,14 @@ typedef struct mcp794xx_handle_s
  */
 #define DRIVER_MCP794XX_LINK_I2C_READ(pHandle, FUC)              (pHandle)->i2c_read = FUC
 
+/**
+ * @brief     link i2c_write_read function
+ * @param[in] pHandle points to mcp794xx pHandle structure
+ * @param[in] FUC points to a i2c_write_read function address
+ * @note      optional, the driver falls back to i2c_write then i2c_read when it is not linked
+ */
+#define DRIVER_MCP794XX_LINK_I2C_WRITE_READ(pHandle, FUC)        (pHandle)->i2c_write_read = FUC
+
 /**
  * @brief     link delay_ms function
  * @param[in] pHandle points to mcp794xx pHandle structure
@@ -543,6 +801,22 @@ typedef struct mcp794xx_handle_s
  */
 #define DRIVER_MCP794XX_LINK_RECEIVE_CALLBACK(pHandle, FUC)     (pHandle)->receive_callback = FUC
 
+/**
+ * @brief     link get_tick_ms function
+ * @param[in] pHandle points to mcp794xx pHandle structure
+ * @param[in] FUC points to a get_tick_ms function address
+ * @note      needed by the host interpolated clock only
+ */
+#define DRIVER_MCP794XX_LINK_GET_TICK_MS(pHandle, FUC)          (pHandle)->get_tick_ms = FUC
+
+/**
+ * @brief     link get_edge_count function
+ * @param[in] pHandle points to mcp794xx pHandle structure
+ * @param[in] FUC points to a get_edge_count function address
+ * @note      needed by the sub-second time stamps only
+ */
+#define DRIVER_MCP794XX_LINK_GET_EDGE_COUNT(pHandle, FUC)       (pHandle)->get_edge_count = FUC
+
 /**
  * @}
  */
@@ -617,6 +891,21 @@ uint8_t mcp794xx_deinit(mcp794xx_handle_t *const pHandle);
  */
 uint8_t mcp794xx_irq_pHandler(mcp794xx_handle_t *const pHandle, mcp794xx_alarm_t alarm);
 
+/**
+ * @brief      This function services the alarm interrupt without knowing which alarm fired
+ * @param[in]  pHandle points to mcp794xx pHandle structure
+ * @param[out] pServiced point to the alarms serviced (MCP794XX_IRQ_ALARM0_FLAG | MCP794XX_IRQ_ALARM1_FLAG), can be NULL
+ * @return  status code
+ *            - 0 success
+ *            - 1 failed to read or clear the alarm flags
+ *            - 2 pHandle is NULL
+ *            - 3 pHandle is not initialized
+ * @note      ALM0WKDAY to ALM1WKDAY are read in one burst. The flags set are cleared by writing back the week day
+ *            register of the alarm that fired, or the whole range in one burst when both fired, then
+ *            receive_callback is called for each alarm serviced. At most two bus transactions.
+ */
+uint8_t mcp794xx_irq_service(mcp794xx_handle_t *const pHandle, uint8_t *pServiced);
+
 /**
  * @brief     This function set the address pin
  * @param[in] pHandle points to a mcp794xx pHandle structure
@@ -691,10 +980,32 @@ uint8_t mcp794xx_get_debug_print_buffer_size(mcp794xx_handle_t *const pHandle, m
  *            - 2 handle or time is NULL
  *            - 3 handle is not initialized
  *            - 4 time is invalid
- * @note      none
+ * @note      The time keeping registers are read once and written back with one burst.
  */
 uint8_t mcp794xx_set_time_and_date(mcp794xx_handle_t *const pHandle, mcp794xx_time_t *pTime);
 
+/**
+ * @brief      This function set the time and date with the oscillator stopped
+ * @param[in]  pHandle points to a mcp794xx handle structure
+ * @param[in]  pTime point to the date and time structure object
+ * @param[out] pError_ms point to the wall-time error introduced (ms), can be NULL
+ * @return     status code
+ *             - 0 success
+ *             - 1 set time failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 time is invalid
+ *             - 5 oscillator stop/start timeout
+ * @note       ST is cleared and OSCRUN is polled low, the 7 time registers are then burst
+ *             written with ST set and the function returns once OSCRUN is high again.
+ *             No carry can occur while the registers are written. The reported error is the
+ *             time elapsed between the call and the oscillator restart: measured with get_tick_ms
+ *             (plus one tick) when linked, otherwise an estimate accounting 1 ms per bus transfer
+ *             and per delay (100 kHz bus or faster), not a bound.
+ *             ST is set again on every failure once it has been cleared.
+ */
+uint8_t mcp794xx_set_time_and_date_atomic(mcp794xx_handle_t *const pHandle, mcp794xx_time_t *pTime, uint32_t *pError_ms);
+
 /**
  * @brief      This function get the current time and date
  * @param[in]  pHandle points to a mcp794xx handle structure
@@ -708,6 +1019,20 @@ uint8_t mcp794xx_set_time_and_date(mcp794xx_handle_t *const pHandle, mcp794xx_ti
  */
 uint8_t mcp794xx_get_time_and_date(mcp794xx_handle_t *const pHandle, mcp794xx_time_t *pTime);
 
+/**
+ * @brief      This function get a rollover-safe snapshot of the current time and date
+ * @param[in]  pHandle points to a mcp794xx handle structure
+ * @param[out] pTime points to a time structure object
+ * @return     status code
+ *             - 0 success
+ *             - 1 get time failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       The 7 registers are read with one write-then-read transfer when i2c_write_read is
+ *             linked. A second read is only done when the seconds read 59, the result is always coherent.
+ */
+uint8_t mcp794xx_get_time_snapshot(mcp794xx_handle_t *const pHandle, mcp794xx_time_t *pTime);
+
 /**
  * @brief This function set the time format 12hr or 24hr
  * @param[in] pHandle points to a mcp794xx handle structure
@@ -815,12 +1140,30 @@ uint8_t mcp794xx_get_pwr_fail_status(mcp794xx_handle_t *const pHandle, mcp794xx_
  *          - 1 failed
             - 2 handle null
  *          - 3 handle is not initialized
+ *          - 4 invalid power failure mode
  * @note    - The PWRFAIL bit must be cleared to log new timestamp data.
             - Reading or writing the external battery back up bit will clear the pwr fail time stamp.
             - Time stamp should be read at start up before reading or setting current time and date.
+            - The year is not set, see mcp794xx_get_pwr_fail_time_stamp_with_year.
  */
 uint8_t mcp794xx_get_pwr_fail_time_stamp(mcp794xx_handle_t *const pHandle, mcp794xx_pwr_fail_type_t powerMode, mcp794xx_time_t *pTime);
 
+/**
+ * @brief This function get the power fail time stamp with its year
+ * @param[in] pHandle points to a mcp794xx handle structure
+ * @param[in] powerMode is the power fail mode (power-up/power-down)
+ * @param[out] pTime point to the time structure object
+ * @return status code
+ *          - 0 success
+ *          - 1 failed
+ *          - 2 handle null
+ *          - 3 handle is not initialized
+ *          - 4 invalid power failure mode
+ * @note    The time stamp is read with mcp794xx_get_pwr_fail_time_stamp, the current time is then read
+ *          and the year is inferred with mcp794xx_infer_pwr_fail_year.
+ */
+uint8_t mcp794xx_get_pwr_fail_time_stamp_with_year(mcp794xx_handle_t *const pHandle, mcp794xx_pwr_fail_type_t powerMode, mcp794xx_time_t *pTime);
+
 /**
  * @brief This function set the am/pm and time format for pwr up/down time stamp
  * @param[in] pHandle points to a mcp794xx handle structure
@@ -829,6 +1172,8 @@ uint8_t mcp794xx_get_pwr_fail_time_stamp(mcp794xx_handle_t *const pHandle, mcp79
  *          - 1 failed
             - 2 handle null
  *          - 3 handle is not initialized
+ *          - 4 not supported by the variant
+ * @note    Both hour registers are updated with one burst write of 0x19 - 0x1D.
  */
 uint8_t mcp794xx_set_pwr_fail_time_param(mcp794xx_handle_t *const pHandle);
 
@@ -854,6 +1199,7 @@ uint8_t mcp794xx_get_leap_year_status(mcp794xx_handle_t *const pHandle, mcp794xx
 *          - 1 failed
            - 2 handle null
 *          - 3 handle is not initialized
+*          - 4 invalid alarm
 */
 uint8_t mcp794xx_set_alarm_enable_status(mcp794xx_handle_t *const pHandle, mcp794xx_alarm_t alarm, mcp794xx_bool_t status);
 
@@ -867,6 +1213,7 @@ uint8_t mcp794xx_set_alarm_enable_status(mcp794xx_handle_t *const pHandle, mcp79
  *          - 1 failed
             - 2 handle null
  *          - 3 handle is not initialized
+ *          - 4 invalid alarm
  */
 uint8_t mcp794xx_get_alarm_enable_status(mcp794xx_handle_t *const pHandle, mcp794xx_alarm_t alarm, mcp794xx_bool_t *pStatus);
 
@@ -910,7 +1257,8 @@ uint8_t mcp794xx_get_alarm_interrupt_output_polarity(mcp794xx_handle_t *const pH
  *          - 1 failed
             - 2 handle null
  *          - 3 handle is not initialized
- *          - 4 invalid alarm
+ *          - 4 invalid alarm or alarm time
+ * @note    The alarm registers are updated with one burst write.
  */
 uint8_t mcp794xx_set_alarm_time_date(mcp794xx_handle_t *const pHandle, mcp794xx_alarm_t alarm, mcp794xx_time_t *pTime);
 
@@ -1196,186 +1544,898 @@ uint8_t mcp794xx_set_osc_start_bit(mcp794xx_handle_t *const pHandle, mcp794xx_bo
 uint8_t mcp794xx_get_osc_start_bit(mcp794xx_handle_t *const pHandle, mcp794xx_bool_t *pStatus);
 
 /**
- * @brief     This function read the current time in epoch/unix format
+ * @brief     This function enables/disables the configuration register shadow
  * @param[in] *pHandle points to mcp794xx pHandle structure
- * @param[in] pTime point to the current time in human readable format
- * @param[out] pEpoch_time point to the epoch time converted
+ * @param[in] status is the enable boolean status
  * @return  status code
  *            - 0 success
- *            - 1 failed to get S/N
+ *            - 1 failed to write pending registers
  *            - 2 pHandle is NULL
  *            - 3 pHandle is not initialized
- * @note      This function will fail to execute from January 19, 2038
+ *            - 4 configuration transaction in progress
+ * @note      - When enabled, CONTROL, OSCTRIM, the VBATEN bit of RTCWKDAY and the ALMxWKDAY configuration bits
+ *              are kept in RAM. Setters skip the read of a read-modify-write and getters of static fields are
+ *              served from RAM once the register was seen on the bus.
+ *            - Disabling writes any pending register, then drops the shadow content.
  */
-uint8_t mcp794xx_read_epoch_unix_time_stamp(mcp794xx_handle_t *const pHandle, mcp794xx_time_t *pTime, uint32_t *pEpoch_time);
+uint8_t mcp794xx_set_shadow_enable_status(mcp794xx_handle_t *const pHandle, mcp794xx_bool_t status);
 
+/**
+ * @brief     This function get the configuration register shadow enable status
+ * @param[in] *pHandle points to mcp794xx pHandle structure
+ * @param[out] pStatus point to the boolean status
+ * @return  status code
+ *            - 0 success
+ *            - 2 pHandle is NULL
+ *            - 3 pHandle is not initialized
+ * @note      none
+ */
+uint8_t mcp794xx_get_shadow_enable_status(mcp794xx_handle_t *const pHandle, mcp794xx_bool_t *pStatus);
 
 /**
- * @brief  This function convert epoch time to human readable time
- * @param[in]  pHandle points to a mcp794xx handle structure
- * @param[in] epoch_unix_time point to the epoch time converted
- * @param[out] pTime point to time output in human readable time
+ * @brief     This function synchronizes the shadow with the chip
+ * @param[in] *pHandle points to mcp794xx pHandle structure
  * @return  status code
  *            - 0 success
- *            - 1 failed to get
+ *            - 1 failed
  *            - 2 pHandle is NULL
  *            - 3 pHandle is not initialized
- * @note      This function will fail to execute from January 19, 2038
+ *            - 4 shadow is disabled
+ * @note      Pending registers are written first, then RTCWKDAY..ALM1WKDAY are reloaded with one burst read.
+ *            Call it after the registers were changed behind the driver (another bus master, power loss).
  */
-uint8_t mcp794xx_convert_epoch_unix_time_stamp(mcp794xx_handle_t *const pHandle, uint32_t u32Epoch_time, mcp794xx_time_t *pTime_out);
+uint8_t mcp794xx_shadow_sync(mcp794xx_handle_t *const pHandle);
 
 /**
- * @brief      This function reads the compile time and date of the application
- * @param[in]  pHandle points to a mcp794xx handle structure
- * @param[in]  Compile_time_date compile time and date string variable (__TIMESTAMP__)
- * @param[out] pTime points to a time structure object
- * @return     status code
- *             - 0 success
- *             - 1 failed
- *             - 2 handle or time is NULL
- *             - 3 handle is not initialized
- * @note       this function returns time in 24Hr format
+ * @brief     This function invalidates the shadow content
+ * @param[in] *pHandle points to mcp794xx pHandle structure
+ * @return  status code
+ *            - 0 success
+ *            - 2 pHandle is NULL
+ *            - 3 pHandle is not initialized
+ * @note      Pending registers are discarded, the next access of each register goes to the bus.
  */
-uint8_t mcp794xx_get_compile_time_date(mcp794xx_handle_t *const pHandle, char *pCompile_time, char *pCompile_date,  mcp794xx_time_t *pTime);
+uint8_t mcp794xx_shadow_invalidate(mcp794xx_handle_t *const pHandle);
 
 /**
- * @brief     This function enables/disables countdown interrupt
+ * @brief     This function starts a configuration transaction
  * @param[in] *pHandle points to mcp794xx pHandle structure
- * @param[in] status is the enable boolean status to be set
  * @return  status code
  *            - 0 success
- *            - 1 failed
+ *            - 1 failed to load the shadow
  *            - 2 pHandle is NULL
  *            - 3 pHandle is not initialized
- * @note      This function use ALARM1 and overwrite existing data within register
+ *            - 4 transaction already in progress
+ * @note      - The shadow is enabled for the transaction and loaded with one burst read when needed.
+ *            - Until mcp794xx_txn_commit, the CONTROL, OSCTRIM and ALMxWKDAY setters only change the shadow.
+ *              Getters return the pending values.
+ *            - Setters needing volatile bits (RTCWKDAY) and registers outside the shadow are still written at once.
  */
-uint8_t mcp794xx_set_countdown_interrupt_enable_status(mcp794xx_handle_t *const pHandle, mcp794xx_bool_t status);
+uint8_t mcp794xx_txn_begin(mcp794xx_handle_t *const pHandle);
 
 /**
- * @brief     This function set countdown time interrupt to fire every xx time set
+ * @brief     This function commits a configuration transaction
  * @param[in] *pHandle points to mcp794xx pHandle structure
- * @param[in] pTime point to current time and date structure object
- * @param[in] u16Time_value is the time value to start counting down from
- * @param[in] time_unit is the time unit to countdown at (seconds/minutes/hours)
  * @return  status code
  *            - 0 success
- *            - 1 failed
+ *            - 1 failed to write, the transaction stays open
  *            - 2 pHandle is NULL
  *            - 3 pHandle is not initialized
- *            - 4 invalid time unit
- *            - 5 invalid time value
- *
- * @note      - This function use ALARM1 and overwrite existing data within register
- *            - time must be reloaded after interrupt has occurred
- *			  - ALARM0 must not not used if countdown time is enabled
- *            - "mcp794xx_set_countdown_interrupt_enable_status"  must be called before using this function
- *            - Time and date must be set prior to calling this function
- *            - day of the week must be accurate when setting time
+ *            - 4 no transaction in progress
+ * @note      Each run of consecutive changed registers is written with one burst
+ *            (CONTROL and OSCTRIM share one burst). The shadow enable status is then restored.
  */
-uint8_t mcp794xx_set_countdown_interrupt_time(mcp794xx_handle_t *const pHandle, uint16_t u16Time_value, mcp794xx_countdwon_time_unit_t time_unit);
+uint8_t mcp794xx_txn_commit(mcp794xx_handle_t *const pHandle);
 
 /**
- * @brief     This function get the device unique identifier
+ * @brief     This function drops a configuration transaction
  * @param[in] *pHandle points to mcp794xx pHandle structure
- * @param[out] pUID point to the device Unique ID
  * @return  status code
  *            - 0 success
- *            - 1 failed to get S/N
  *            - 2 pHandle is NULL
  *            - 3 pHandle is not initialized
- * @note      none
+ *            - 4 no transaction in progress
+ * @note      Pending changes are discarded and the shadow is invalidated.
  */
-uint8_t mcp794xx_uid_read(mcp794xx_handle_t *const pHandle, uint8_t *pUID);
+uint8_t mcp794xx_txn_abort(mcp794xx_handle_t *const pHandle);
 
 /**
-* @brief This function write data bytes to sram
-* @param[in] *pHandle points to mcp794xx handle structure
-* @param[in] addr is the register address to write to
-* @param[in] *pBuffer point to data to write
-* @param[in] length is the number of bytes the write
-* @return status code
-*          - 0 success
-*          - 1 failed to write
-*          - 2 pHandle is NULL
-*          - 3 pHandle is not initialized
-*          - 4 invalid address
-* @note none
-*/
-uint8_t mcp794xx_sram_write_byte(mcp794xx_handle_t *const pHandle, uint8_t addr, uint8_t *pBuffer, size_t length);
+ * @brief     This function validates an init profile and compiles its register values
+ * @param[in] *pHandle points to mcp794xx pHandle structure
+ * @param[in,out] pProfile point to the init profile
+ * @return  status code
+ *            - 0 success
+ *            - 2 pHandle is NULL
+ *            - 3 pHandle is not initialized
+ *            - 4 invalid profile field
+ * @note      Call it once, the profile can then be applied on every boot.
+ */
+uint8_t mcp794xx_init_profile_validate(mcp794xx_handle_t *const pHandle, mcp794xx_init_profile_t *pProfile);
 
 /**
-* @brief This function reads data bytes from sram
-* @param[in] *pHandle points to mcp794xx handle structure
-* @param[in] addr is the register address to write to
-* @param[out] *pBuffer point to data to read
-* @param[in] length is the number of bytes the read
-* @return status code
-*          - 0 success
-*          - 1 failed to read
-*          - 2 pHandle is NULL
-*          - 3 pHandle is not initialized
-*          - 4 invalid address
-* @note none
-*/
-uint8_t mcp794xx_sram_read_byte(mcp794xx_handle_t *const pHandle, uint8_t addr, uint8_t *pBuffer, size_t length);
+ * @brief     This function applies a validated init profile and starts the oscillator
+ * @param[in] *pHandle points to mcp794xx pHandle structure
+ * @param[in] pProfile point to the validated init profile
+ * @param[out] pWarm_boot point to the warm boot status, true when the oscillator was already running
+ * @return  status code
+ *            - 0 success
+ *            - 1 failed
+ *            - 2 pHandle is NULL
+ *            - 3 pHandle is not initialized
+ *            - 4 profile is not validated
+ * @note      - RTCSEC..ALM1WKDAY are read with one burst. Nothing is written on a warm boot where
+ *              the registers already match the profile.
+ *            - Otherwise only the differing registers are written, joined into as few bursts as possible.
+ *              CONTROL and OSCTRIM are always written together.
+ *            - On a cold boot the function waits MCP794XX_OSC_START_DELAY_MS after starting the oscillator.
+ */
+uint8_t mcp794xx_init_profile_apply(mcp794xx_handle_t *const pHandle, mcp794xx_init_profile_t *pProfile, mcp794xx_bool_t *pWarm_boot);
 
 /**
-* @brief This function erases a sector of the sram
-* @param[in] *pHandle points to mcp794xx handle structure
-* @param[in] start_addr is the first register address erase
-* @param[in] end_addr is the last register address erase
-* @return status code
-*          - 0 success
-*          - 1 failed to write
-*          - 2 pHandle is NULL
-*          - 3 pHandle is not initialized
-*          - 4 invalid address
-* @note data from the start to the end address will be erased
-*/
-uint8_t mcp794xx_sram_erase_selector(mcp794xx_handle_t *const pHandle, uint8_t start_addr, uint8_t end_addr);
+ * @brief     This function converts a proleptic Gregorian date to days since 1970-01-01
+ * @param[in] s32Year is the year (negative years are allowed)
+ * @param[in] u8Month is the month (1 - 12)
+ * @param[in] u8Day is the day of the month (1 - 31)
+ * @return    number of days since 1970-01-01, negative before
+ * @note      Closed form (no loop), handle free and reentrant. Valid for any year of the int32_t day range.
+ */
+int32_t mcp794xx_days_from_civil(int32_t s32Year, uint8_t u8Month, uint8_t u8Day);
 
 /**
-* @brief This function wipes the entire sram memory
-* @param[in] *pHandle points to mcp794xx handle structure
-* @return status code
-*          - 0 success
-*          - 1 failed to write
-*          - 2 pHandle is NULL
-*          - 3 pHandle is not initialized
-* @note none
-*/
-uint8_t mcp794xx_wipe_sram(mcp794xx_handle_t *const pHandle);
+ * @brief      This function converts days since 1970-01-01 to a proleptic Gregorian date
+ * @param[in]  s32Days is the number of days since 1970-01-01, negative before
+ * @param[out] pYear point to the year
+ * @param[out] pMonth point to the month (1 - 12)
+ * @param[out] pDay point to the day of the month (1 - 31)
+ * @return     none
+ * @note       Closed form (no loop), handle free and reentrant.
+ */
+void mcp794xx_civil_from_days(int32_t s32Days, int32_t *pYear, uint8_t *pMonth, uint8_t *pDay);
 
 /**
- * @brief     This function write n byte to eeprom
- * @param[in] pHandle points to mcp794xx handle structure
- * @param[in] addr is the eeprom address to write to
- * @param[in] *buf points to data buffer to be written
- * @param[in] length is the data buffer length
- * @return    status code
- *            - 0 success
- *            - 1 write failed
- *            - 2 handle is NULL
- *            - 3 handle is not initialized
- *            - 4 invalid address
- *            - 5 attempt to write a protected block array
- *            - 6 data length is larger than page size
- * @note      the eeprom has a 5ms write cycle time.
+ * @brief     This function returns the week day of a day count
+ * @param[in] s32Days is the number of days since 1970-01-01, negative before
+ * @return    week day (MCP794XX_WKDAY_SUNDAY - MCP794XX_WKDAY_SATURDAY)
+ * @note      handle free and reentrant
  */
-uint8_t mcp794xx_eeprom_write_byte(mcp794xx_handle_t *const pHandle, uint8_t u8Addr, uint8_t *pBuf, uint8_t length);
+mcp794xx_week_days_list_t mcp794xx_weekday_from_days(int32_t s32Days);
 
 /**
- * @brief     This function read n byte to eeprom
- * @param[in] pHandle points to mcp794xx handle structure
- * @param[in] addr is the eeprom address to read
- * @param[out] *buf points to data buffer read
- * @param[in] length is the data buffer length
- * @return    status code
+ * @brief     This function set the century window of the 2-digit RTCYEAR register
+ * @param[in] *pHandle points to mcp794xx pHandle structure
+ * @param[in] u16Base_year is the first year of the window
+ * @return  status code
  *            - 0 success
- *            - 1 read failed
- *            - 2 handle is NULL
- *            - 3 handle is not initialized
- *            - 4 invalid address
+ *            - 2 pHandle is NULL
+ *            - 3 pHandle is not initialized
+ *            - 4 base year out of range (1970 - 9900) or window holding a non-leap century year
+ * @note      - RTCYEAR 00..99 maps to u16Base_year..u16Base_year + 99, e.g. a base of 2301 reads 24 as 2324.
+ *              The default base is MCP794XX_CENTURY_BASE_DEFAULT.
+ *            - The chip takes every RTCYEAR multiple of 4 as a leap year. The window must not hold a century
+ *              year that is not a leap year (2100, 2200, 2300...), e.g. 1970 - 2000 or 2301 - 2400 are valid.
+ */
+uint8_t mcp794xx_set_century_base(mcp794xx_handle_t *const pHandle, uint16_t u16Base_year);
+
+/**
+ * @brief     This function get the century window of the 2-digit RTCYEAR register
+ * @param[in] *pHandle points to mcp794xx pHandle structure
+ * @param[out] pBase_year point to the first year of the window
+ * @return  status code
+ *            - 0 success
+ *            - 2 pHandle is NULL
+ *            - 3 pHandle is not initialized
+ * @note      none
+ */
+uint8_t mcp794xx_get_century_base(mcp794xx_handle_t *const pHandle, uint16_t *pBase_year);
+
+/**
+ * @brief         This function infers the year of a power-fail time stamp
+ * @param[in]     pNow point to the current time and date
+ * @param[in,out] pStamp point to the power-fail time stamp (minute to month)
+ * @return        none
+ * @note          - The time stamp has no year. It is given the year of its latest occurrence not after pNow,
+ *                  so a stamp later in the year than pNow belongs to the previous year.
+ *                - A 29 February stamp goes back to the latest leap year. The week day is then recomputed.
+ *                - Both times must use the same hour format, handle free and reentrant.
+ */
+void mcp794xx_infer_pwr_fail_year(mcp794xx_time_t *pNow, mcp794xx_time_t *pStamp);
+
+/**
+ * @brief     This function read the current time in epoch/unix format
+ * @param[in] *pHandle points to mcp794xx pHandle structure
+ * @param[in] pTime point to the current time in human readable format
+ * @param[out] pEpoch_time point to the epoch time converted
+ * @return  status code
+ *            - 0 success
+ *            - 1 failed to get S/N
+ *            - 2 pHandle is NULL
+ *            - 3 pHandle is not initialized
+ *            - 4 time out of the uint32_t epoch range (1970-01-01 - 2106-02-07 06:28:15)
+ * @note      24hr time is expected, the date is converted with mcp794xx_days_from_civil
+ */
+uint8_t mcp794xx_read_epoch_unix_time_stamp(mcp794xx_handle_t *const pHandle, mcp794xx_time_t *pTime, uint32_t *pEpoch_time);
+
+
+/**
+ * @brief  This function convert epoch time to human readable time
+ * @param[in]  pHandle points to a mcp794xx handle structure
+ * @param[in] epoch_unix_time point to the epoch time converted
+ * @param[out] pTime point to time output in human readable time
+ * @return  status code
+ *            - 0 success
+ *            - 1 failed to get
+ *            - 2 pHandle is NULL
+ *            - 3 pHandle is not initialized
+ * @note      The date is converted with mcp794xx_civil_from_days, valid up to 2106-02-07 06:28:15
+ */
+uint8_t mcp794xx_convert_epoch_unix_time_stamp(mcp794xx_handle_t *const pHandle, uint32_t u32Epoch_time, mcp794xx_time_t *pTime_out);
+
+/**
+ * @brief     This function converts a time and date to a 64-bit epoch/unix time
+ * @param[in] *pHandle points to mcp794xx pHandle structure
+ * @param[in] pTime point to the time and date, 4-digit year (0 - 9999)
+ * @param[out] pEpoch_time point to the epoch time converted
+ * @return  status code
+ *            - 0 success
+ *            - 2 pHandle is NULL
+ *            - 3 pHandle is not initialized
+ *            - 4 year out of range
+ * @note      24hr time is expected. No 64-bit division is used.
+ */
+uint8_t mcp794xx_read_epoch64_time_stamp(mcp794xx_handle_t *const pHandle, mcp794xx_time_t *pTime, int64_t *pEpoch_time);
+
+/**
+ * @brief      This function converts a 64-bit epoch/unix time to human readable time
+ * @param[in]  *pHandle points to mcp794xx pHandle structure
+ * @param[in]  s64Epoch_time is the epoch time to convert
+ * @param[out] pTime_out point to time output in human readable time, local_time_zone is applied
+ * @return  status code
+ *            - 0 success
+ *            - 2 pHandle is NULL
+ *            - 3 pHandle is not initialized
+ *            - 4 time out of range (MCP794XX_EPOCH64_MIN - MCP794XX_EPOCH64_MAX)
+ * @note      The seconds are shifted by 7 (86400 = 128 * 675), only 32-bit divisions are left.
+ */
+uint8_t mcp794xx_convert_epoch64_time_stamp(mcp794xx_handle_t *const pHandle, int64_t s64Epoch_time, mcp794xx_time_t *pTime_out);
+
+/**
+ * @brief     This function configures the host interpolated clock
+ * @param[in] *pHandle points to mcp794xx pHandle structure
+ * @param[in] u32Resync_interval_ms is the bus re-anchor interval in ms, 0 to re-anchor only on request or on the 1 Hz edge
+ * @param[in] u32Drift_ppm is the combined RTC and MCU tick tolerance in ppm, used for the drift bound
+ * @return  status code
+ *            - 0 success
+ *            - 2 pHandle is NULL
+ *            - 3 pHandle is not initialized
+ *            - 4 get_tick_ms is not linked
+ * @note      The anchor is dropped, call mcp794xx_clock_anchor before mcp794xx_clock_now.
+ */
+uint8_t mcp794xx_set_clock_config(mcp794xx_handle_t *const pHandle, uint32_t u32Resync_interval_ms, uint32_t u32Drift_ppm);
+
+/**
+ * @brief     This function re-anchors the host interpolated clock to the RTC
+ * @param[in] *pHandle points to mcp794xx pHandle structure
+ * @return  status code
+ *            - 0 success
+ *            - 1 failed to read the time
+ *            - 2 pHandle is NULL
+ *            - 3 pHandle is not initialized
+ *            - 4 get_tick_ms is not linked
+ * @note      One time snapshot is read. The RTC only gives the second, so an existing anchor is kept
+ *            when its prediction falls inside that second (the sub-second phase found on the 1 Hz edge
+ *            survives), otherwise it is clamped into it and last_correction_ms records the step.
+ */
+uint8_t mcp794xx_clock_anchor(mcp794xx_handle_t *const pHandle);
+
+/**
+ * @brief     This function re-anchors the host interpolated clock on the 1 Hz MFP edge
+ * @param[in] *pHandle points to mcp794xx pHandle structure
+ * @return  status code
+ *            - 0 success
+ *            - 2 pHandle is NULL
+ *            - 3 pHandle is not initialized
+ *            - 4 clock is not anchored
+ *            - 5 edge skipped, it interrupted a clock update
+ * @note      - No bus access, call it from the MFP interrupt on the edge where the seconds increment.
+ *            - The prediction is rounded to the nearest second, so the host drift between edges must stay below 500 ms.
+ */
+uint8_t mcp794xx_clock_on_second_edge(mcp794xx_handle_t *const pHandle);
+
+/**
+ * @brief      This function get the interpolated epoch time without a bus access
+ * @param[in]  *pHandle points to mcp794xx pHandle structure
+ * @param[out] pEpoch_ms point to the epoch time in ms
+ * @return  status code
+ *            - 0 success
+ *            - 1 failed to re-anchor
+ *            - 2 pHandle is NULL
+ *            - 3 pHandle is not initialized
+ *            - 4 clock is not anchored
+ * @note      - The time is the anchor plus the ticks elapsed since, the local time zone is not applied.
+ *            - When the resync interval has elapsed the clock is re-anchored first (one bus read).
+ *            - The tick is 32-bit, re-anchor at least every 49 days.
+ */
+uint8_t mcp794xx_clock_now(mcp794xx_handle_t *const pHandle, int64_t *pEpoch_ms);
+
+/**
+ * @brief      This function get the error bound of the interpolated clock
+ * @param[in]  *pHandle points to mcp794xx pHandle structure
+ * @param[out] pBound_ms point to the worst case error of mcp794xx_clock_now in ms
+ * @return  status code
+ *            - 0 success
+ *            - 2 pHandle is NULL
+ *            - 3 pHandle is not initialized
+ *            - 4 clock is not anchored
+ * @note      The bound is the anchor phase uncertainty (999 ms until a 1 Hz edge was seen, else 0),
+ *            plus drift_ppm over the ticks elapsed since the anchor, plus one tick.
+ *            last_correction_ms in the clock structure holds the step measured at the last re-anchor.
+ */
+uint8_t mcp794xx_clock_get_drift_bound(mcp794xx_handle_t *const pHandle, uint32_t *pBound_ms);
+
+/**
+ * @brief     This function aligns the square wave edge counter to the 1 Hz boundary
+ * @param[in] *pHandle points to mcp794xx pHandle structure
+ * @return  status code
+ *            - 0 success
+ *            - 1 failed to read the chip
+ *            - 2 pHandle is NULL
+ *            - 3 pHandle is not initialized
+ *            - 4 get_edge_count not linked, or MFP is not a 4.096, 8.192 or 32.768 kHz square wave
+ *            - 5 no second boundary seen within MCP794XX_SUBSEC_SYNC_MAX_POLLS reads, or a read lasts
+ *                longer than a quarter of a second in edges
+ * @note      - The seconds register is polled until it changes (up to one second of bus traffic), once.
+ *              Every later boundary is a whole number of periods away since the square wave and the
+ *              seconds share the crystal, so no further polling is needed.
+ *            - The 32.768 kHz output bypasses the digital trim: calibrate again after a trim change or
+ *              periodically when a trim is set.
+ */
+uint8_t mcp794xx_subsec_calibrate(mcp794xx_handle_t *const pHandle);
+
+/**
+ * @brief      This function get the time elapsed since the last second boundary
+ * @param[in]  *pHandle points to mcp794xx pHandle structure
+ * @param[out] pMicros point to the sub-second time in us (0 - 999999)
+ * @return  status code
+ *            - 0 success
+ *            - 2 pHandle is NULL
+ *            - 3 pHandle is not initialized
+ *            - 4 not calibrated
+ * @note      No bus access, interrupt safe: orders events within one second.
+ */
+uint8_t mcp794xx_subsec_get_phase(mcp794xx_handle_t *const pHandle, uint32_t *pMicros);
+
+/**
+ * @brief      This function get the time and date with a sub-second part
+ * @param[in]  *pHandle points to mcp794xx pHandle structure
+ * @param[out] pTime points to a time structure object
+ * @param[out] pMicros point to the sub-second time in us (0 - 999999)
+ * @return  status code
+ *            - 0 success
+ *            - 1 failed to read the time
+ *            - 2 pHandle is NULL
+ *            - 3 pHandle is not initialized
+ *            - 4 not calibrated
+ *            - 5 no consistent read in MCP794XX_SUBSEC_MAX_RETRY tries
+ * @note      The edge count is sampled around the time snapshot. When the read ends close to a second boundary
+ *            the seconds could belong to either side, the snapshot is then read again (a few reads at most).
+ *            The result is the time at the end of the read, the resolution is one square wave period (30.5 us
+ *            at 32.768 kHz) and the phase may lag by up to the calibration window.
+ */
+uint8_t mcp794xx_subsec_get_time(mcp794xx_handle_t *const pHandle, mcp794xx_time_t *pTime, uint32_t *pMicros);
+
+/**
+ * @brief      This function reads the compile time and date of the application
+ * @param[in]  pHandle points to a mcp794xx handle structure
+ * @param[in]  Compile_time_date compile time and date string variable (__TIMESTAMP__)
+ * @param[out] pTime points to a time structure object
+ * @return     status code
+ *             - 0 success
+ *             - 1 failed
+ *             - 2 handle or time is NULL
+ *             - 3 handle is not initialized
+ * @note       this function returns time in 24Hr format
+ */
+uint8_t mcp794xx_get_compile_time_date(mcp794xx_handle_t *const pHandle, char *pCompile_time, char *pCompile_date,  mcp794xx_time_t *pTime);
+
+/**
+ * @brief     This function enables/disables countdown interrupt
+ * @param[in] *pHandle points to mcp794xx pHandle structure
+ * @param[in] status is the enable boolean status to be set
+ * @return  status code
+ *            - 0 success
+ *            - 1 failed
+ *            - 2 pHandle is NULL
+ *            - 3 pHandle is not initialized
+ * @note      This function use ALARM1 and overwrite existing data within register
+ */
+uint8_t mcp794xx_set_countdown_interrupt_enable_status(mcp794xx_handle_t *const pHandle, mcp794xx_bool_t status);
+
+/**
+ * @brief     This function set countdown time interrupt to fire every xx time set
+ * @param[in] *pHandle points to mcp794xx pHandle structure
+ * @param[in] pTime point to current time and date structure object
+ * @param[in] u16Time_value is the time value to start counting down from
+ * @param[in] time_unit is the time unit to countdown at (seconds/minutes/hours)
+ * @return  status code
+ *            - 0 success
+ *            - 1 failed
+ *            - 2 pHandle is NULL
+ *            - 3 pHandle is not initialized
+ *            - 4 invalid time unit
+ *            - 5 invalid time value
+ *
+ * @note      - This function use ALARM1 and overwrite existing data within register
+ *            - time must be reloaded after interrupt has occurred
+ *			  - ALARM0 must not not used if countdown time is enabled
+ *            - "mcp794xx_set_countdown_interrupt_enable_status"  must be called before using this function
+ *            - Time and date must be set prior to calling this function
+ *            - day of the week must be accurate when setting time
+ */
+uint8_t mcp794xx_set_countdown_interrupt_time(mcp794xx_handle_t *const pHandle, uint16_t u16Time_value, mcp794xx_countdwon_time_unit_t time_unit);
+
+/**
+ * @brief     This function starts the software alarm scheduler
+ * @param[in] *pHandle points to mcp794xx pHandle structure
+ * @param[in] alarm is the hardware alarm the scheduler owns (ALARM0/ALARM1)
+ * @return  status code
+ *            - 0 success
+ *            - 1 failed
+ *            - 2 pHandle is NULL
+ *            - 3 pHandle is not initialized
+ *            - 4 invalid alarm
+ *            - 5 alarm owned by the periodic timer or the cron alarm
+ * @note      Pending software alarms are dropped and the hardware alarm is disabled until one is added.
+ *            Restarting on the other hardware alarm disables the one used before.
+ */
+uint8_t mcp794xx_sched_start(mcp794xx_handle_t *const pHandle, mcp794xx_alarm_t alarm);
+
+/**
+ * @brief     This function adds a software alarm to the scheduler
+ * @param[in] *pHandle points to mcp794xx pHandle structure
+ * @param[in] u32Epoch_time is the deadline (unix epoch, RTC time)
+ * @param[in] callback is the function called once the deadline is reached
+ * @param[out] *pId points to the software alarm id, used to cancel it
+ * @return  status code
+ *            - 0 success
+ *            - 1 failed to program the hardware alarm
+ *            - 2 pHandle is NULL
+ *            - 3 pHandle is not initialized
+ *            - 4 callback is NULL
+ *            - 5 scheduler not started
+ *            - 6 no free software alarm
+ * @note      O(log n). The hardware alarm is reprogrammed only when the new deadline is the earliest,
+ *            a deadline already passed runs its callback before returning.
+ */
+uint8_t mcp794xx_sched_add(mcp794xx_handle_t *const pHandle, uint32_t u32Epoch_time, mcp794xx_sched_callback_t callback, uint8_t *pId);
+
+/**
+ * @brief     This function cancels a pending software alarm
+ * @param[in] *pHandle points to mcp794xx pHandle structure
+ * @param[in] u8Id is the software alarm id
+ * @return  status code
+ *            - 0 success
+ *            - 1 failed to program the hardware alarm
+ *            - 2 pHandle is NULL
+ *            - 3 pHandle is not initialized
+ *            - 4 invalid id or alarm not pending
+ *            - 5 scheduler not started
+ * @note      O(log n), the hardware alarm is reprogrammed only when the earliest alarm is cancelled
+ */
+uint8_t mcp794xx_sched_cancel(mcp794xx_handle_t *const pHandle, uint8_t u8Id);
+
+/**
+ * @brief     This function services the scheduler after its hardware alarm fired
+ * @param[in] *pHandle points to mcp794xx pHandle structure
+ * @return  status code
+ *            - 0 success
+ *            - 1 failed
+ *            - 2 pHandle is NULL
+ *            - 3 pHandle is not initialized
+ *            - 5 scheduler not started
+ * @note      Call from thread context once the MFP interrupt of the scheduler alarm is seen. The alarm flag is
+ *            cleared, every due software alarm is called, earliest first, and the next deadline is programmed.
+ */
+uint8_t mcp794xx_sched_service(mcp794xx_handle_t *const pHandle);
+
+/**
+ * @brief     This function stops the software alarm scheduler
+ * @param[in] *pHandle points to mcp794xx pHandle structure
+ * @return  status code
+ *            - 0 success
+ *            - 1 failed
+ *            - 2 pHandle is NULL
+ *            - 3 pHandle is not initialized
+ * @note      Pending software alarms are dropped, the hardware alarm is disabled and released.
+ */
+uint8_t mcp794xx_sched_stop(mcp794xx_handle_t *const pHandle);
+
+/**
+ * @brief     This function starts a self re-arming periodic timer on a hardware alarm
+ * @param[in] *pHandle points to mcp794xx pHandle structure
+ * @param[in] alarm is the hardware alarm used (ALARM0/ALARM1)
+ * @param[in] u32Period is the period (seconds, 1 second to several years)
+ * @return  status code
+ *            - 0 success
+ *            - 1 failed
+ *            - 2 pHandle is NULL
+ *            - 3 pHandle is not initialized
+ *            - 4 invalid alarm
+ *            - 5 invalid period
+ *            - 6 alarm owned by the scheduler or the cron alarm
+ * @note      The first deadline is one period from now.
+ *            mcp794xx_periodic_timer_service re-arms the timer after each interrupt.
+ *            Restarting on the other hardware alarm disables the one used before.
+ */
+uint8_t mcp794xx_periodic_timer_start(mcp794xx_handle_t *const pHandle, mcp794xx_alarm_t alarm, uint32_t u32Period);
+
+/**
+ * @brief     This function re-arms the periodic timer after its interrupt
+ * @param[in] *pHandle points to mcp794xx pHandle structure
+ * @return  status code
+ *            - 0 success
+ *            - 1 failed
+ *            - 2 pHandle is NULL
+ *            - 3 pHandle is not initialized
+ *            - 4 periodic timer not started
+ * @note      - One burst write of the alarm registers, which also clears the alarm flag. The next deadline is the
+ *              previous one plus the period, so service latency does not accumulate.
+ *            - Periods missed while the service was late are skipped, a past deadline would only match again
+ *              a year later. The time comes from the interpolated clock when anchored (mcp794xx_clock_anchor),
+ *              otherwise it is read once.
+ *            - The time is read back after the write. A deadline passed before the write landed (e.g. a 1 second
+ *              period) is skipped and the next one is written.
+ *            - The polarity is taken from ALMxWKDAY at each re-arm, mcp794xx_set_alarm_interrupt_output_polarity
+ *              may be called while the timer runs.
+ */
+uint8_t mcp794xx_periodic_timer_service(mcp794xx_handle_t *const pHandle);
+
+/**
+ * @brief     This function stops the periodic timer
+ * @param[in] *pHandle points to mcp794xx pHandle structure
+ * @return  status code
+ *            - 0 success
+ *            - 1 failed
+ *            - 2 pHandle is NULL
+ *            - 3 pHandle is not initialized
+ * @note      the hardware alarm is disabled
+ */
+uint8_t mcp794xx_periodic_timer_stop(mcp794xx_handle_t *const pHandle);
+
+/**
+ * @brief      This function compiles a cron expression
+ * @param[in]  pHandle points to mcp794xx pHandle structure
+ * @param[in]  pExpr point to the expression "minute hour day-of-month month day-of-week"
+ * @param[out] pCron point to the compiled rule
+ * @return  status code
+ *            - 0 success
+ *            - 2 pHandle is NULL
+ *            - 3 pHandle is not initialized
+ *            - 4 invalid expression
+ * @note      - Fields accept *, n, a-b, lists (a,b) and steps (x/s), day of week 0 - 7 with 0 and 7 Sunday.
+ *              When both day fields are restricted a day matching either one matches.
+ *            - The cheapest hardware alarm mask whose own matches are exactly the rule is picked:
+ *              "* * * * *" seconds, "m * * * *" minutes, "0 h * * *" hours, "0 0 * * d" week day, "0 0 d * *" date.
+ *              Any other rule uses the full mask, re-programmed with the next match after each interrupt.
+ */
+uint8_t mcp794xx_cron_compile(mcp794xx_handle_t *const pHandle, const char *pExpr, mcp794xx_cron_t *pCron);
+
+/**
+ * @brief      This function returns the first time a cron rule matches after a given time
+ * @param[in]  pHandle points to mcp794xx pHandle structure
+ * @param[in]  pCron point to the compiled rule
+ * @param[in]  u32From_epoch is the time searched from (unix epoch)
+ * @param[out] pNext_epoch point to the next match (unix epoch, second 0)
+ * @return  status code
+ *            - 0 success
+ *            - 2 pHandle is NULL
+ *            - 3 pHandle is not initialized
+ *            - 4 no match (e.g. 30th of February) or beyond the uint32_t epoch range
+ * @note      Each field jumps straight to its next allowed value with a bit scan, a lower field restarts at its
+ *            first allowed value when a higher one moves.
+ */
+uint8_t mcp794xx_cron_next(mcp794xx_handle_t *const pHandle, const mcp794xx_cron_t *pCron, uint32_t u32From_epoch, uint32_t *pNext_epoch);
+
+/**
+ * @brief     This function starts a recurring alarm from a compiled cron rule
+ * @param[in] pHandle points to mcp794xx pHandle structure
+ * @param[in] alarm is the hardware alarm used (ALARM0/ALARM1)
+ * @param[in] pCron point to the compiled rule
+ * @return  status code
+ *            - 0 success
+ *            - 1 failed
+ *            - 2 pHandle is NULL
+ *            - 3 pHandle is not initialized
+ *            - 4 invalid alarm
+ *            - 5 the rule never matches
+ *            - 6 alarm owned by the scheduler or the periodic timer
+ * @note      A rule the hardware mask expresses alone is written once and needs no re-arm. Other rules program the
+ *            next match, mcp794xx_cron_service or mcp794xx_process_events programs the following one.
+ *            Restarting on the other hardware alarm disables the one used before.
+ */
+uint8_t mcp794xx_cron_start(mcp794xx_handle_t *const pHandle, mcp794xx_alarm_t alarm, const mcp794xx_cron_t *pCron);
+
+/**
+ * @brief     This function services the cron alarm after its interrupt
+ * @param[in] pHandle points to mcp794xx pHandle structure
+ * @return  status code
+ *            - 0 success
+ *            - 1 failed
+ *            - 2 pHandle is NULL
+ *            - 3 pHandle is not initialized
+ *            - 4 cron alarm not started
+ * @note      A hardware mask rule only has its flag cleared. Other rules program the first match after both the one
+ *            that fired and the current time in one read-modify-write of the alarm registers, which also clears the
+ *            flag. The time comes from the interpolated clock when anchored (mcp794xx_clock_anchor), otherwise it
+ *            is read once. The time is read back after the write, a match passed before the write landed (service
+ *            at hh:mm:59) is skipped and the next one is written.
+ */
+uint8_t mcp794xx_cron_service(mcp794xx_handle_t *const pHandle);
+
+/**
+ * @brief     This function stops the cron alarm
+ * @param[in] pHandle points to mcp794xx pHandle structure
+ * @return  status code
+ *            - 0 success
+ *            - 1 failed
+ *            - 2 pHandle is NULL
+ *            - 3 pHandle is not initialized
+ * @note      the hardware alarm is disabled
+ */
+uint8_t mcp794xx_cron_stop(mcp794xx_handle_t *const pHandle);
+
+/**
+ * @brief     This function queues an alarm interrupt event, for use in the MFP interrupt service routine
+ * @param[in] pHandle points to mcp794xx pHandle structure
+ * @return  status code
+ *            - 0 success
+ *            - 2 pHandle is NULL
+ *            - 3 pHandle is not initialized
+ *            - 4 queue full, the event is dropped
+ * @note      - No bus access and no blocking call, mcp794xx_process_events does the i2c work later.
+ *            - Single producer: call from one interrupt only. The event is time stamped with get_tick_ms when linked.
+ *            - A dropped event loses nothing as long as one is queued, the flags are read when the queue is drained.
+ */
+uint8_t mcp794xx_irq_post(mcp794xx_handle_t *const pHandle);
+
+/**
+ * @brief      This function drains the alarm event queue and does the deferred i2c work
+ * @param[in]  pHandle points to mcp794xx pHandle structure
+ * @param[out] pServiced point to the alarms serviced (MCP794XX_IRQ_ALARM0_FLAG | MCP794XX_IRQ_ALARM1_FLAG), can be NULL
+ * @param[out] pTick point to the time stamp of the oldest event drained, can be NULL
+ * @return  status code
+ *            - 0 success, nothing queued or events serviced
+ *            - 1 failed to service the alarms
+ *            - 2 pHandle is NULL
+ *            - 3 pHandle is not initialized
+ * @note      - Call from thread context (main loop or task). Single consumer.
+ *            - Any number of queued events is serviced with one mcp794xx_irq_service call, then the scheduler
+ *              (mcp794xx_sched_start), the periodic timer (mcp794xx_periodic_timer_start) and the cron alarm
+ *              (mcp794xx_cron_start) owning a serviced alarm are re-armed.
+ */
+uint8_t mcp794xx_process_events(mcp794xx_handle_t *const pHandle, uint8_t *pServiced, uint32_t *pTick);
+
+/**
+ * @brief     This function get the device unique identifier
+ * @param[in] *pHandle points to mcp794xx pHandle structure
+ * @param[out] pUID point to the device Unique ID
+ * @return  status code
+ *            - 0 success
+ *            - 1 failed to get S/N
+ *            - 2 pHandle is NULL
+ *            - 3 pHandle is not initialized
+ * @note      none
+ */
+uint8_t mcp794xx_uid_read(mcp794xx_handle_t *const pHandle, uint8_t *pUID);
+
+/**
+* @brief This function write data bytes to sram
+* @param[in] *pHandle points to mcp794xx handle structure
+* @param[in] addr is the register address to write to
+* @param[in] *pBuffer point to data to write
+* @param[in] length is the number of bytes the write
+* @return status code
+*          - 0 success
+*          - 1 failed to write
+*          - 2 pHandle is NULL
+*          - 3 pHandle is not initialized
+*          - 4 invalid address
+* @note none
+*/
+uint8_t mcp794xx_sram_write_byte(mcp794xx_handle_t *const pHandle, uint8_t addr, uint8_t *pBuffer, size_t length);
+
+/**
+* @brief This function reads data bytes from sram
+* @param[in] *pHandle points to mcp794xx handle structure
+* @param[in] addr is the register address to write to
+* @param[out] *pBuffer point to data to read
+* @param[in] length is the number of bytes the read
+* @return status code
+*          - 0 success
+*          - 1 failed to read
+*          - 2 pHandle is NULL
+*          - 3 pHandle is not initialized
+*          - 4 invalid address
+* @note none
+*/
+uint8_t mcp794xx_sram_read_byte(mcp794xx_handle_t *const pHandle, uint8_t addr, uint8_t *pBuffer, size_t length);
+
+/**
+* @brief This function fills a range of the sram with a pattern
+* @param[in] *pHandle points to mcp794xx handle structure
+* @param[in] start_addr is the first register address to fill
+* @param[in] end_addr is the last register address to fill
+* @param[in] u8Pattern is the byte written
+* @return status code
+*          - 0 success
+*          - 1 failed to write
+*          - 2 pHandle is NULL
+*          - 3 pHandle is not initialized
+*          - 4 invalid address
+* @note one burst write from the handle staging buffer
+*/
+uint8_t mcp794xx_sram_fill(mcp794xx_handle_t *const pHandle, uint8_t start_addr, uint8_t end_addr, uint8_t u8Pattern);
+
+/**
+* @brief This function erases a sector of the sram
+* @param[in] *pHandle points to mcp794xx handle structure
+* @param[in] start_addr is the first register address erase
+* @param[in] end_addr is the last register address erase
+* @return status code
+*          - 0 success
+*          - 1 failed to write
+*          - 2 pHandle is NULL
+*          - 3 pHandle is not initialized
+*          - 4 invalid address
+* @note data from the start to the end address will be erased, in one burst write
+*/
+uint8_t mcp794xx_sram_erase_selector(mcp794xx_handle_t *const pHandle, uint8_t start_addr, uint8_t end_addr);
+
+/**
+* @brief This function wipes the entire sram memory
+* @param[in] *pHandle points to mcp794xx handle structure
+* @return status code
+*          - 0 success
+*          - 1 failed to write
+*          - 2 pHandle is NULL
+*          - 3 pHandle is not initialized
+* @note one burst write
+*/
+uint8_t mcp794xx_wipe_sram(mcp794xx_handle_t *const pHandle);
+
+/**
+* @brief This function copies a block of sram to another sram address
+* @param[in] *pHandle points to mcp794xx handle structure
+* @param[in] dst_addr is the destination address
+* @param[in] src_addr is the source address
+* @param[in] length is the number of bytes to copy
+* @return status code
+*          - 0 success
+*          - 1 failed to read or write
+*          - 2 pHandle is NULL
+*          - 3 pHandle is not initialized
+*          - 4 invalid address
+*          - 5 address out of range
+* @note The block is read in one burst then written in one burst, overlapping ranges are moved correctly.
+*/
+uint8_t mcp794xx_sram_copy(mcp794xx_handle_t *const pHandle, uint8_t dst_addr, uint8_t src_addr, uint8_t length);
+
+/**
+* @brief This function formats an sram range as an empty event log
+* @param[in] *pHandle points to mcp794xx handle structure
+* @param[in] start_addr is the first sram address of the log
+* @param[in] end_addr is the last sram address of the log
+* @param[in] record_size is the payload size of one record (bytes)
+* @return status code
+*          - 0 success
+*          - 1 failed to read or write
+*          - 2 pHandle is NULL
+*          - 3 pHandle is not initialized
+*          - 4 invalid range or record size (at least two records must fit)
+* @note the range holds a 2 byte header then slots of record_size + 1 bytes, the whole range is written in one burst
+*/
+uint8_t mcp794xx_sram_log_format(mcp794xx_handle_t *const pHandle, uint8_t start_addr, uint8_t end_addr, uint8_t record_size);
+
+/**
+* @brief This function mounts an event log kept in sram
+* @param[in] *pHandle points to mcp794xx handle structure
+* @param[in] start_addr is the first sram address of the log
+* @param[in] end_addr is the last sram address of the log
+* @param[in] record_size is the payload size of one record (bytes)
+* @return status code
+*          - 0 success
+*          - 1 failed to read or write
+*          - 2 pHandle is NULL
+*          - 3 pHandle is not initialized
+*          - 4 invalid range or record size
+*          - 6 no log with this record size found, format it first
+* @note one burst read, the head is recovered from the record sequence stamps
+*/
+uint8_t mcp794xx_sram_log_mount(mcp794xx_handle_t *const pHandle, uint8_t start_addr, uint8_t end_addr, uint8_t record_size);
+
+/**
+* @brief This function appends one record to the sram event log
+* @param[in] *pHandle points to mcp794xx handle structure
+* @param[in] *pRecord points to record_size bytes to log
+* @return status code
+*          - 0 success
+*          - 1 failed to read or write
+*          - 2 pHandle is NULL
+*          - 3 pHandle is not initialized
+*          - 5 log not mounted
+* @note one burst write, the payload then its stamp. Once the log is full the oldest record is overwritten
+*       and its stamp is cleared first by a one byte write, so a reset during the burst leaves an empty slot.
+*/
+uint8_t mcp794xx_sram_log_append(mcp794xx_handle_t *const pHandle, const uint8_t *pRecord);
+
+/**
+* @brief This function reads every record of the sram event log
+* @param[in] *pHandle points to mcp794xx handle structure
+* @param[out] *pBuffer points to a buffer of at least slots * record_size bytes
+* @param[out] *pCount points to the number of records copied
+* @return status code
+*          - 0 success
+*          - 1 failed to read or write
+*          - 2 pHandle is NULL
+*          - 3 pHandle is not initialized
+*          - 5 log not mounted
+*          - 6 log header lost
+* @note one burst read, records are copied oldest first, the log is left unchanged
+*/
+uint8_t mcp794xx_sram_log_drain(mcp794xx_handle_t *const pHandle, uint8_t *pBuffer, uint8_t *pCount);
+
+/**
+ * @brief     This function write n byte to eeprom
+ * @param[in] pHandle points to mcp794xx handle structure
+ * @param[in] addr is the eeprom address to write to
+ * @param[in] *buf points to data buffer to be written
+ * @param[in] length is the data buffer length
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 invalid address
+ *            - 5 attempt to write a protected block array
+ *            - 6 data length is larger than page size
+ *            - 7 write cycle did not complete within the timeout
+ * @note      The eeprom has a 5ms write cycle time, the function returns once it completed (ACK polling).
+ */
+uint8_t mcp794xx_eeprom_write_byte(mcp794xx_handle_t *const pHandle, uint8_t u8Addr, uint8_t *pBuf, uint8_t length);
+
+/**
+ * @brief     This function writes a buffer of any length at any eeprom address
+ * @param[in] pHandle points to mcp794xx handle structure
+ * @param[in] u8Addr is the eeprom address to start writing
+ * @param[in] *pBuf points to data buffer to be written
+ * @param[in] u16Length is the data buffer length (1 - EEPROM_MEMORY_SIZE)
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 invalid address or length
+ *            - 5 attempt to write a protected block array
+ *            - 6 invalid device variant
+ *            - 7 write cycle did not complete within the timeout
+ * @note      The buffer is split on the 8-byte page boundaries, one bus write per page. The eeprom is idle on
+ *            entry, a refused first page is a bus failure. The next pages are retried while the eeprom is busy
+ *            with the previous one, so the write itself is the ACK poll.
+ *            The function returns once the last write cycle completed.
+ */
+uint8_t mcp794xx_eeprom_write(mcp794xx_handle_t *const pHandle, uint8_t u8Addr, uint8_t *pBuf, uint16_t u16Length);
+
+/**
+ * @brief     This function read n byte to eeprom
+ * @param[in] pHandle points to mcp794xx handle structure
+ * @param[in] addr is the eeprom address to read
+ * @param[out] *buf points to data buffer read
+ * @param[in] length is the data buffer length
+ * @return    status code
+ *            - 0 success
+ *            - 1 read failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 invalid address
  *            - 5 invalid device variant
  * @note      none
  */
@@ -1415,6 +2475,26 @@ uint8_t mcp794xx_eeprom_put_byte(mcp794xx_handle_t *const pHandle, uint8_t u8Add
  */
 uint8_t mcp794xx_eeprom_get_byte(mcp794xx_handle_t *const pHandle, uint8_t u8Addr, uint32_t *pBuf, uint8_t u8Length);
 
+/**
+ * @brief      This function writes only the eeprom bytes that differ, one write cycle per touched page
+ * @param[in]  pHandle points to mcp794xx handle structure
+ * @param[in]  u8Address is the address to write
+ * @param[in]  *pBuffer point to data write
+ * @param[in]  u8Length is the data size
+ * @param[out] pCycles_saved point to the write cycles saved against one write per changed byte, can be NULL
+ * @return status code
+ *            - 0 success
+ *            - 1 read or write failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 invalid address (failed to validate address)
+ *            - 5 attempt to write a protected block array
+ *            - 7 write cycle did not complete within the timeout
+ * @note    The range is read once. In every page the span from the first to the last changed byte is
+ *          written in one transfer, untouched pages are skipped. Fewer cycles also means less wear.
+ */
+uint8_t mcp794xx_eeprom_update_diff(mcp794xx_handle_t *const pHandle, uint8_t u8Address, uint8_t *pBuffer, uint8_t u8Length, uint8_t *pCycles_saved);
+
 /**
  * @brief This function write a byte to the EEPROM.
  * @param[in] pHandle points to mcp794xx handle structure
@@ -1423,11 +2503,14 @@ uint8_t mcp794xx_eeprom_get_byte(mcp794xx_handle_t *const pHandle, uint8_t u8Add
  * @param[in] u8Length is the data size
  * @return status code
  *            - 0 success
- *            - 1 read failed
+ *            - 1 read or write failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
  *            - 4 invalid address (failed to validate address)
- * @note    The value is written only if differs from the one already saved at the same address.
+ *            - 5 attempt to write a protected block array
+ *            - 7 write cycle did not complete within the timeout
+ * @note    The value is written only if differs from the one already saved at the same address,
+ *          one write cycle per touched page (see mcp794xx_eeprom_update_diff).
  */
 uint8_t mcp794xx_eeprom_update(mcp794xx_handle_t *const pHandle, uint8_t u8Address, uint8_t *pBuffer, uint8_t u8Length);
 
@@ -1480,7 +2563,8 @@ uint8_t mcp794xx_eeprom_erase_chip(mcp794xx_handle_t *const pHandle);
  *            - 1 set bp failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
- * @note      none
+ *            - 4 write cycle did not complete within the timeout
+ * @note      the STATUS register is an eeprom cell, the function returns once its write cycle completed.
  */
 uint8_t mcp794xx_eeprom_set_bp_status(mcp794xx_handle_t *const pHandle, mcp794xx_eeprom_block_protect_stat_t status);
 
@@ -1497,6 +2581,200 @@ uint8_t mcp794xx_eeprom_set_bp_status(mcp794xx_handle_t *const pHandle, mcp794xx
  */
 uint8_t mcp794xx_eeprom_get_bp_status(mcp794xx_handle_t *const pHandle, mcp794xx_eeprom_block_protect_stat_t *pStatus);
 
+/**
+ * @brief     This function set the eeprom write cycle timeout
+ * @param[in] pHandle points to mcp794xx handle structure
+ * @param[in] u16Timeout_ms is the longest time to poll for the end of a write cycle (ms)
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 timeout is 0
+ * @note      The default is MCP794XX_EEPROM_WRITE_TIMEOUT_MS, the datasheet write cycle is 5 ms max.
+ */
+uint8_t mcp794xx_eeprom_set_write_timeout(mcp794xx_handle_t *const pHandle, uint16_t u16Timeout_ms);
+
+/**
+ * @brief      This function get the eeprom write cycle timeout
+ * @param[in]  pHandle points to mcp794xx handle structure
+ * @param[out] pTimeout_ms point to the write cycle timeout (ms)
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t mcp794xx_eeprom_get_write_timeout(mcp794xx_handle_t *const pHandle, uint16_t *pTimeout_ms);
+
+/**
+ * @brief     This function enables/disables the eeprom RAM mirror
+ * @param[in] pHandle points to mcp794xx handle structure
+ * @param[in] status is the enable boolean status
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      - When enabled, eeprom reads are served from RAM. Each page is read from the chip the first
+ *              time it is needed and every driver write updates the mirror.
+ *            - The mirror starts empty on enable; disabling bypasses it and drops the content.
+ */
+uint8_t mcp794xx_set_eeprom_mirror_enable_status(mcp794xx_handle_t *const pHandle, mcp794xx_bool_t status);
+
+/**
+ * @brief      This function get the eeprom RAM mirror enable status
+ * @param[in]  pHandle points to mcp794xx handle structure
+ * @param[out] pStatus point to the boolean status
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t mcp794xx_get_eeprom_mirror_enable_status(mcp794xx_handle_t *const pHandle, mcp794xx_bool_t *pStatus);
+
+/**
+ * @brief     This function invalidates the eeprom RAM mirror content
+ * @param[in] pHandle points to mcp794xx handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      call it when the eeprom may have been written behind the driver (other bus master, reset)
+ */
+uint8_t mcp794xx_eeprom_mirror_invalidate(mcp794xx_handle_t *const pHandle);
+
+/**
+* @brief This function mounts the sram write-ahead journal and replays it into the eeprom
+* @param[in] *pHandle points to mcp794xx handle structure
+* @param[in] start_addr is the first sram address of the journal
+* @param[in] end_addr is the last sram address of the journal
+* @return status code
+*          - 0 success
+*          - 1 failed to read or write
+*          - 2 pHandle is NULL
+*          - 3 pHandle is not initialized
+*          - 4 invalid range
+*          - 5 replay failed (the journal is kept)
+* @note Call once at power-up. The range is read in one burst, a range without a journal is formatted,
+*       updates journaled before a reset are flushed to the eeprom.
+*/
+uint8_t mcp794xx_journal_mount(mcp794xx_handle_t *const pHandle, uint8_t start_addr, uint8_t end_addr);
+
+/**
+* @brief This function journals one eeprom byte update in sram
+* @param[in] *pHandle points to mcp794xx handle structure
+* @param[in] u8Addr is the eeprom address
+* @param[in] u8Value is the new value
+* @return status code
+*          - 0 success
+*          - 1 failed to write
+*          - 2 pHandle is NULL
+*          - 3 pHandle is not initialized
+*          - 4 invalid address
+*          - 5 journal not mounted
+*          - 6 address is block protected or the variant has no eeprom
+*          - 7 journal full and the flush failed
+* @note One burst write, no eeprom write cycle. A journaled address is updated in place,
+*       a full journal is flushed first.
+*/
+uint8_t mcp794xx_journal_write(mcp794xx_handle_t *const pHandle, uint8_t u8Addr, uint8_t u8Value);
+
+/**
+* @brief This function writes the journaled updates to the eeprom and empties the journal
+* @param[in] *pHandle points to mcp794xx handle structure
+* @return status code
+*          - 0 success
+*          - 1 failed to read or write
+*          - 2 pHandle is NULL
+*          - 3 pHandle is not initialized
+*          - 5 journal not mounted
+* @note The touched range is read once and only the changed bytes are written, one write cycle per touched
+*       page. The journal is emptied by advancing its generation byte only after the eeprom is written, a reset
+*       during the flush replays it at the next mount. When the generation wraps the entries are zeroed before
+*       the generation byte is written.
+*/
+uint8_t mcp794xx_journal_flush(mcp794xx_handle_t *const pHandle);
+
+/**
+* @brief This function reads one eeprom byte through the journal
+* @param[in] *pHandle points to mcp794xx handle structure
+* @param[in] u8Addr is the eeprom address
+* @param[out] *pValue points to the value read
+* @return status code
+*          - 0 success
+*          - 1 failed to read
+*          - 2 pHandle is NULL
+*          - 3 pHandle is not initialized
+*          - 4 invalid address
+*          - 5 journal not mounted
+* @note a journaled value not yet flushed is returned without a bus transfer
+*/
+uint8_t mcp794xx_journal_read(mcp794xx_handle_t *const pHandle, uint8_t u8Addr, uint8_t *pValue);
+
+/**
+* @brief This function mounts the eeprom key-value store
+* @param[in] *pHandle points to mcp794xx handle structure
+* @return status code
+*          - 0 success
+*          - 1 failed to read
+*          - 2 pHandle is NULL
+*          - 3 pHandle is not initialized
+*          - 4 invalid device variant
+*          - 6 the unprotected eeprom holds MCP794XX_KV_MAX_KEYS pages or less
+* @note The array is read in one burst. A spare page is needed so that a key can be rewritten while every
+*       key is stored, the mount fails when the block protected area leaves no spare page. Every page holds one record (key, 32-bit sequence, 16-bit value, crc-8),
+*       the newest valid record of each key is indexed in RAM. Pages with a bad crc are treated as free.
+*/
+uint8_t mcp794xx_kv_mount(mcp794xx_handle_t *const pHandle);
+
+/**
+* @brief This function stores a value in the eeprom key-value store
+* @param[in] *pHandle points to mcp794xx handle structure
+* @param[in] u8Key is the key (0 - MCP794XX_KV_MAX_KEYS-1)
+* @param[in] u16Value is the value
+* @return status code
+*          - 0 success
+*          - 1 failed to write
+*          - 2 pHandle is NULL
+*          - 3 pHandle is not initialized
+*          - 4 invalid key
+*          - 5 store not mounted
+*          - 6 no free page
+* @note One page write, the record goes to the next free page after the previous write so wear rotates over
+*       the array. The old record stays valid until the new one is written. An unchanged value is not written.
+*/
+uint8_t mcp794xx_kv_put(mcp794xx_handle_t *const pHandle, uint8_t u8Key, uint16_t u16Value);
+
+/**
+* @brief This function reads a value from the eeprom key-value store
+* @param[in] *pHandle points to mcp794xx handle structure
+* @param[in] u8Key is the key (0 - MCP794XX_KV_MAX_KEYS-1)
+* @param[out] *pValue points to the value read
+* @return status code
+*          - 0 success
+*          - 2 pHandle is NULL
+*          - 3 pHandle is not initialized
+*          - 4 invalid key
+*          - 5 store not mounted
+*          - 6 key not found
+* @note served from the RAM index, no bus transfer
+*/
+uint8_t mcp794xx_kv_get(mcp794xx_handle_t *const pHandle, uint8_t u8Key, uint16_t *pValue);
+
+/**
+* @brief This function compacts the eeprom key-value store
+* @param[in] *pHandle points to mcp794xx handle structure
+* @return status code
+*          - 0 success
+*          - 1 failed to write
+*          - 2 pHandle is NULL
+*          - 3 pHandle is not initialized
+*          - 5 store not mounted
+* @note Every live record is rewritten, oldest first, at the write position. Records of keys that never change
+*       move on and stop pinning their pages, the free pages become one run. Costs one page write per key.
+*/
+uint8_t mcp794xx_kv_compact(mcp794xx_handle_t *const pHandle);
+
 /**
  * @brief This function runs basic checks before writing
  * @param[in] pHandle points to mcp794xx handle structure
@@ -1507,7 +2785,8 @@ uint8_t mcp794xx_eeprom_get_bp_status(mcp794xx_handle_t *const pHandle, mcp794xx
  *          - 2 handle is NULL
  *          - 3 handle is not initialized
  *          - 4 invalid device variant
- * @note    none
+ * @note    The block protect status is read once and cached as the first protected address,
+ *          mcp794xx_eeprom_set_bp_status and mcp794xx_eeprom_get_bp_status refresh it.
  */
 uint8_t mcp794xx_eeprom_check_bp_before_write(mcp794xx_handle_t *const pHandle, uint8_t u8Address);
 
@@ -37,7 +37,7 @@
  * @return status code
  *          - 0 success
  *          - 1 initialize failed
- * @note    none
+ * @note    the registers are written only when they differ from the default profile (warm boot)
  */
 
 uint8_t mcp794xx_basic_initialize(mcp794xx_variant_t variant);
@@ -51,6 +51,15 @@ uint8_t mcp794xx_basic_initialize(mcp794xx_variant_t variant);
  */
 uint8_t mcp794xx_basic_irq_handler(mcp794xx_alarm_t alarm);
 
+ /**
+ * @brief basic implementation of the interrupt service that finds the alarm that fired
+ * @param[out] pServiced point to the alarms serviced (MCP794XX_IRQ_ALARM0_FLAG | MCP794XX_IRQ_ALARM1_FLAG)
+ * @return status code
+ *          - 0 success
+ *          - 1 fail to read or clear the alarm flags
+ */
+uint8_t mcp794xx_basic_irq_service(uint8_t *pServiced);
+
 /**
  * @brief interrupt request callback function
  * @param[in] alarm is the alarm number to service the callback for
@@ -82,6 +91,18 @@ uint8_t mcp794xx_basic_get_variant(mcp794xx_variant_t *pVariant);
  */
 uint8_t mcp794xx_basic_set_time_date(mcp794xx_time_t *pTime);
 
+/**
+ * @brief basic example set time and date with the oscillator stopped
+ * @param[in] *time point to a time structure
+ * @param[out] *pError_ms point to the worst-case time error introduced (ms)
+ * @return status code
+ *          - 0 success
+ *          - 1 set time failed
+ *          - 5 oscillator stop/start timeout
+ * @note    am_pm is don't care when 24hr time format is used
+ */
+uint8_t mcp794xx_basic_set_time_date_atomic(mcp794xx_time_t *pTime, uint32_t *pError_ms);
+
 /**
  * @brief basic example get current time and date
  * @param[out] *time point to the time structure
@@ -92,6 +113,16 @@ uint8_t mcp794xx_basic_set_time_date(mcp794xx_time_t *pTime);
  */
 uint8_t mcp794xx_basic_get_current_time_date(mcp794xx_time_t *pTime);
 
+/**
+ * @brief basic example get a rollover-safe snapshot of the current time and date
+ * @param[out] *time point to the time structure
+ * @return status code
+ *          - 0 success
+ *          - 1 failed to get time
+ * @note    one bus transfer in the common case when i2c_write_read is linked
+ */
+uint8_t mcp794xx_basic_get_time_snapshot(mcp794xx_time_t *pTime);
+
 /**
  * @brief get time format 12hr or 24hr
  * @param[in] *format point to the hour format to set
@@ -292,6 +323,140 @@ uint8_t mcp794xx_basic_disable_countdown_interrupt(void);
  */
 uint8_t mcp794xx_basic_set_countdown_time(uint16_t u16Time_value, mcp794xx_countdwon_time_unit_t time_unit);
 
+/**
+ * @brief     This function is a basic implementation to start the software alarm scheduler
+ * @param[in] alarm is the hardware alarm the scheduler owns (ALARM0/ALARM1)
+ * @return  status code
+ *            - 0 success
+ *            - 1 failed
+ *            - 4 invalid alarm
+ *            - 5 alarm owned by another feature
+ * @note      none
+ */
+uint8_t mcp794xx_basic_sched_start(mcp794xx_alarm_t alarm);
+
+/**
+ * @brief     This function is a basic implementation to add a software alarm
+ * @param[in] u32Epoch_time is the deadline (unix epoch, RTC time)
+ * @param[in] callback is the function called once the deadline is reached
+ * @param[out] *pId points to the software alarm id
+ * @return  status code
+ *            - 0 success
+ *            - 1 failed
+ *            - 4 callback is NULL
+ *            - 5 scheduler not started
+ *            - 6 no free software alarm
+ * @note      none
+ */
+uint8_t mcp794xx_basic_sched_add(uint32_t u32Epoch_time, mcp794xx_sched_callback_t callback, uint8_t *pId);
+
+/**
+ * @brief     This function is a basic implementation to cancel a software alarm
+ * @param[in] u8Id is the software alarm id
+ * @return  status code
+ *            - 0 success
+ *            - 1 failed
+ *            - 4 alarm not pending
+ *            - 5 scheduler not started
+ * @note      none
+ */
+uint8_t mcp794xx_basic_sched_cancel(uint8_t u8Id);
+
+/**
+ * @brief     This function is a basic implementation to service the scheduler after its alarm fired
+ * @return  status code
+ *            - 0 success
+ *            - 1 failed
+ *            - 5 scheduler not started
+ * @note      call from thread context, not from the interrupt callback
+ */
+uint8_t mcp794xx_basic_sched_service(void);
+
+/**
+ * @brief     This function is a basic implementation to stop the scheduler
+ * @return  status code
+ *            - 0 success
+ *            - 1 failed
+ * @note      pending software alarms are dropped
+ */
+uint8_t mcp794xx_basic_sched_stop(void);
+
+/**
+ * @brief     This function is a basic implementation to start a periodic timer
+ * @param[in] alarm is the hardware alarm used (ALARM0/ALARM1)
+ * @param[in] u32Period is the period (seconds)
+ * @return  status code
+ *            - 0 success
+ *            - 1 failed
+ *            - 4 invalid alarm
+ *            - 5 invalid period
+ *            - 6 alarm owned by another feature
+ * @note      none
+ */
+uint8_t mcp794xx_basic_periodic_timer_start(mcp794xx_alarm_t alarm, uint32_t u32Period);
+
+/**
+ * @brief     This function is a basic implementation to re-arm the periodic timer after its interrupt
+ * @return  status code
+ *            - 0 success
+ *            - 1 failed
+ *            - 4 periodic timer not started
+ * @note      call from thread context, not from the interrupt callback
+ */
+uint8_t mcp794xx_basic_periodic_timer_service(void);
+
+/**
+ * @brief     This function is a basic implementation to stop the periodic timer
+ * @return  status code
+ *            - 0 success
+ *            - 1 failed
+ * @note      none
+ */
+uint8_t mcp794xx_basic_periodic_timer_stop(void);
+
+/**
+ * @brief     This function is a basic implementation to queue an alarm interrupt event
+ * @return  status code
+ *            - 0 success
+ *            - 4 queue full, the event is dropped
+ * @note      call from the MFP pin interrupt service routine, no bus access
+ */
+uint8_t mcp794xx_basic_irq_post(void);
+
+/**
+ * @brief      This function is a basic implementation to process the queued alarm events
+ * @param[out] pServiced point to the alarms serviced (MCP794XX_IRQ_ALARM0_FLAG | MCP794XX_IRQ_ALARM1_FLAG)
+ * @return  status code
+ *            - 0 success
+ *            - 1 failed to service the alarms
+ * @note      call from the main loop or a task
+ */
+uint8_t mcp794xx_basic_process_events(uint8_t *pServiced);
+
+/**
+ * @brief     This function is a basic implementation to start a recurring alarm from a cron expression
+ * @param[in] alarm is the hardware alarm used (ALARM0/ALARM1)
+ * @param[in] pExpr point to the expression "minute hour day-of-month month day-of-week"
+ * @return  status code
+ *            - 0 success
+ *            - 1 failed
+ *            - 4 invalid alarm or expression
+ *            - 5 the rule never matches
+ *            - 6 alarm owned by another feature
+ * @note      e.g. "30 6 * * 1-5" every weekday at 06:30, "0-59/15 * * * *" every 15 minutes
+ */
+uint8_t mcp794xx_basic_cron_start(mcp794xx_alarm_t alarm, const char *pExpr);
+
+/**
+ * @brief     This function is a basic implementation to service the cron alarm after its interrupt
+ * @return  status code
+ *            - 0 success
+ *            - 1 failed
+ *            - 4 cron alarm not started
+ * @note      call from thread context, not needed when mcp794xx_basic_process_events is used
+ */
+uint8_t mcp794xx_basic_cron_service(void);
+
 /**
  * @brief This function is a basic implementation to get the countdown interrupt flag
  * @param[out] pFlag point to the interrupt flag read
@@ -382,6 +547,39 @@ uint8_t mcp794xx_basic_disable_coarse_trim(void);
  */
 uint8_t mcp794xx_basic_set_coarse_trim_value(mcp794xx_trim_sign_t sign, mcp794xx_trim_val_t value);
 
+/**
+ * @brief This function is a basic implementation to enable the configuration register shadow
+ * @return status code
+ *          - 0 success
+ *          - 1 failed
+            - 2 handle null
+ *          - 3 handle is not initialized
+ * @note setters of CONTROL, OSCTRIM and ALMxWKDAY fields skip the register read once the shadow is loaded
+ */
+uint8_t mcp794xx_basic_enable_shadow(void);
+
+/**
+ * @brief This function is a basic implementation to disable the configuration register shadow
+ * @return status code
+ *          - 0 success
+ *          - 1 failed
+            - 2 handle null
+ *          - 3 handle is not initialized
+ */
+uint8_t mcp794xx_basic_disable_shadow(void);
+
+/**
+ * @brief This function is a basic implementation to reload the shadow from the chip
+ * @return status code
+ *          - 0 success
+ *          - 1 failed
+            - 2 handle null
+ *          - 3 handle is not initialized
+ *          - 4 shadow is disabled
+ * @note call it when the registers may have been changed behind the driver
+ */
+uint8_t mcp794xx_basic_shadow_sync(void);
+
 /**
  * @brief     This function is a basic implementation to read the current time in epoch/Unix format
  * @param[in] pTime point to the current time in human readable format
@@ -391,7 +589,7 @@ uint8_t mcp794xx_basic_set_coarse_trim_value(mcp794xx_trim_sign_t sign, mcp794xx
  *            - 1 failed
  *            - 2 pHandle is NULL
  *            - 3 pHandle is not initialized
- * @note      This function will fail to execute from January 19, 2038
+ * @note      uint32_t epoch time, valid up to 2106-02-07 06:28:15
  */
 uint8_t mcp794xx_basic_convert_time_to_epoch_unix_time(mcp794xx_time_t *pTime, uint32_t *pEpoch_time);
 
@@ -404,7 +602,7 @@ uint8_t mcp794xx_basic_convert_time_to_epoch_unix_time(mcp794xx_time_t *pTime, u
  *            - 1 failed to get
  *            - 2 pHandle is NULL
  *            - 3 pHandle is not initialized
- * @note      This function will fail to execute from January 19, 2038
+ * @note      uint32_t epoch time, valid up to 2106-02-07 06:28:15
  */
 uint8_t mcp794xx_basic_convert_epoch_to_human_time_format_gmt(uint32_t epoch_unix_time, mcp794xx_time_t *pTime);
 
@@ -418,10 +616,115 @@ uint8_t mcp794xx_basic_convert_epoch_to_human_time_format_gmt(uint32_t epoch_uni
  *            - 1 failed to get
  *            - 2 pHandle is NULL
  *            - 3 pHandle is not initialized
- * @note      This function will fail to execute from January 19, 2038
+ * @note      uint32_t epoch time, valid up to 2106-02-07 06:28:15
  */
 uint8_t mcp794xx_basic_convert_epoch_to_human_time_format_local(uint32_t epoch_unix_time, int time_zone, mcp794xx_time_t *pTime);
 
+/**
+ * @brief     This function is a basic implementation to convert a time and date to a 64-bit epoch time
+ * @param[in] pTime point to the time and date in human readable format, 4-digit year
+ * @param[out] pEpoch_time point to the epoch time converted
+ * @return  status code
+ *            - 0 success
+ *            - 2 pHandle is NULL
+ *            - 3 pHandle is not initialized
+ *            - 4 year out of range
+ * @note      int64_t epoch time, valid for years 0 - 9999
+ */
+uint8_t mcp794xx_basic_convert_time_to_epoch64_time(mcp794xx_time_t *pTime, int64_t *pEpoch_time);
+
+/**
+ * @brief  This function is a basic implementation to convert a 64-bit epoch time to GMT human readable time
+ * @param[in] s64Epoch_time is the epoch time to convert
+ * @param[out] pTime point to time output in human readable format
+ * @return  status code
+ *            - 0 success
+ *            - 2 pHandle is NULL
+ *            - 3 pHandle is not initialized
+ *            - 4 time out of range
+ * @note      int64_t epoch time, valid for years 0 - 9999
+ */
+uint8_t mcp794xx_basic_convert_epoch64_to_human_time_format_gmt(int64_t s64Epoch_time, mcp794xx_time_t *pTime);
+
+/**
+ * @brief  This function is a basic implementation to set the century window of the RTCYEAR register
+ * @param[in] u16Base_year is the first year of the window
+ * @return  status code
+ *            - 0 success
+ *            - 2 pHandle is NULL
+ *            - 3 pHandle is not initialized
+ *            - 4 base year out of range (1970 - 9900) or window holding a non-leap century year
+ * @note      RTCYEAR 00..99 reads as u16Base_year..u16Base_year + 99, e.g. 1970 - 2000 or 2301 - 2400
+ */
+uint8_t mcp794xx_basic_set_century_base(uint16_t u16Base_year);
+
+/**
+ * @brief  This function is a basic implementation to start the host interpolated clock
+ * @param[in] u32Resync_interval_ms is the bus re-anchor interval in ms, 0 none
+ * @param[in] u32Drift_ppm is the combined RTC and MCU tick tolerance in ppm
+ * @return  status code
+ *            - 0 success
+ *            - 1 failed to read the time
+ *            - 2 pHandle is NULL
+ *            - 3 pHandle is not initialized
+ *            - 4 get_tick_ms is not linked
+ * @note      call mcp794xx_basic_clock_second_edge from the 1 Hz MFP interrupt to lock the sub-second phase
+ */
+uint8_t mcp794xx_basic_clock_start(uint32_t u32Resync_interval_ms, uint32_t u32Drift_ppm);
+
+/**
+ * @brief  This function is a basic implementation to read the host interpolated clock
+ * @param[out] pEpoch_ms point to the epoch time in ms
+ * @return  status code
+ *            - 0 success
+ *            - 1 failed to re-anchor
+ *            - 2 pHandle is NULL
+ *            - 3 pHandle is not initialized
+ *            - 4 clock is not anchored
+ * @note      no bus access except once per resync interval
+ */
+uint8_t mcp794xx_basic_clock_now_ms(int64_t *pEpoch_ms);
+
+/**
+ * @brief  This function is a basic implementation to re-anchor the host clock on the 1 Hz MFP edge
+ * @return  status code
+ *            - 0 success
+ *            - 2 pHandle is NULL
+ *            - 3 pHandle is not initialized
+ *            - 4 clock is not anchored
+ *            - 5 edge skipped
+ * @note      interrupt safe, no bus access
+ */
+uint8_t mcp794xx_basic_clock_second_edge(void);
+
+/**
+ * @brief  This function is a basic implementation to start the sub-second time stamps
+ * @param[in] freq is the square wave frequency counted (4.096, 8.192 or 32.768 kHz)
+ * @return  status code
+ *            - 0 success
+ *            - 1 failed
+ *            - 2 pHandle is NULL
+ *            - 3 pHandle is not initialized
+ *            - 4 get_edge_count not linked or invalid frequency
+ *            - 5 no second boundary seen
+ * @note      enables the square wave output on MFP, then polls for one second boundary
+ */
+uint8_t mcp794xx_basic_subsec_start(mcp94xx_sqr_wave_freq_t freq);
+
+/**
+ * @brief  This function is a basic implementation to read the time with a sub-second part
+ * @param[out] pTime point to the current time in human readable format
+ * @param[out] pMicros point to the sub-second time in us
+ * @return  status code
+ *            - 0 success
+ *            - 1 failed
+ *            - 2 pHandle is NULL
+ *            - 3 pHandle is not initialized
+ *            - 4 not calibrated
+ * @note      none
+ */
+uint8_t mcp794xx_basic_subsec_get_time(mcp794xx_time_t *pTime, uint32_t *pMicros);
+
 /**
  * @brief This function is a basic implementation to read the compile time and date of the application
  * @param[out] pTime points to a time structure object
@@ -490,6 +793,195 @@ uint8_t mcp794xx_basic_sram_erase_selector(uint8_t start_addr, uint8_t end_addr)
 */
 uint8_t mcp794xx_basic_sram_wipe(void);
 
+/**
+* @brief This function is a basic implementation to fill a range of the sram with a pattern
+* @param[in] start_addr is the first register address to fill
+* @param[in] end_addr is the last register address to fill
+* @param[in] u8Pattern is the byte written
+* @return status code
+*          - 0 success
+*          - 1 failed to write
+*          - 2 pHandle is NULL
+*          - 3 pHandle is not initialized
+*          - 4 invalid address
+* @note one burst write
+*/
+uint8_t mcp794xx_basic_sram_fill(uint8_t start_addr, uint8_t end_addr, uint8_t u8Pattern);
+
+/**
+* @brief This function is a basic implementation to copy a block of sram to another sram address
+* @param[in] dst_addr is the destination address
+* @param[in] src_addr is the source address
+* @param[in] length is the number of bytes to copy
+* @return status code
+*          - 0 success
+*          - 1 failed to read or write
+*          - 2 pHandle is NULL
+*          - 3 pHandle is not initialized
+*          - 4 invalid address
+*          - 5 address out of range
+* @note overlapping ranges are moved correctly
+*/
+uint8_t mcp794xx_basic_sram_copy(uint8_t dst_addr, uint8_t src_addr, uint8_t length);
+
+/**
+* @brief This function is a basic implementation to start the sram event log
+* @param[in] start_addr is the first sram address of the log
+* @param[in] end_addr is the last sram address of the log
+* @param[in] record_size is the payload size of one record (bytes)
+* @return status code
+*          - 0 success
+*          - 1 failed to read or write
+*          - 2 pHandle is NULL
+*          - 3 pHandle is not initialized
+*          - 4 invalid range or record size
+* @note the log kept across resets is mounted, otherwise the range is formatted
+*/
+uint8_t mcp794xx_basic_sram_log_start(uint8_t start_addr, uint8_t end_addr, uint8_t record_size);
+
+/**
+* @brief This function is a basic implementation to log one record to sram
+* @param[in] *pRecord points to record_size bytes to log
+* @return status code
+*          - 0 success
+*          - 1 failed to write
+*          - 2 pHandle is NULL
+*          - 3 pHandle is not initialized
+*          - 5 log not started
+* @note none
+*/
+uint8_t mcp794xx_basic_sram_log_append(const uint8_t *pRecord);
+
+/**
+* @brief This function is a basic implementation to read the sram event log
+* @param[out] *pBuffer points to a buffer of at least slots * record_size bytes
+* @param[out] *pCount points to the number of records copied
+* @return status code
+*          - 0 success
+*          - 1 failed to read
+*          - 2 pHandle is NULL
+*          - 3 pHandle is not initialized
+*          - 5 log not started
+*          - 6 log header lost
+* @note records are copied oldest first
+*/
+uint8_t mcp794xx_basic_sram_log_drain(uint8_t *pBuffer, uint8_t *pCount);
+
+/**
+* @brief This function is a basic implementation to mount the sram journal and replay it into the eeprom
+* @param[in] start_addr is the first sram address of the journal
+* @param[in] end_addr is the last sram address of the journal
+* @return status code
+*          - 0 success
+*          - 1 failed to read or write
+*          - 2 pHandle is NULL
+*          - 3 pHandle is not initialized
+*          - 4 invalid range
+*          - 5 replay failed
+* @note call once at power-up
+*/
+uint8_t mcp794xx_basic_journal_start(uint8_t start_addr, uint8_t end_addr);
+
+/**
+* @brief This function is a basic implementation to journal one eeprom byte update
+* @param[in] u8Addr is the eeprom address
+* @param[in] u8Value is the new value
+* @return status code
+*          - 0 success
+*          - 1 failed to read or write
+*          - 2 pHandle is NULL
+*          - 3 pHandle is not initialized
+*          - 4 invalid address
+*          - 5 journal not started
+*          - 6 address is block protected
+*          - 7 journal full and the flush failed
+* @note none
+*/
+uint8_t mcp794xx_basic_journal_write(uint8_t u8Addr, uint8_t u8Value);
+
+/**
+* @brief This function is a basic implementation to flush the journal to the eeprom
+* @return status code
+*          - 0 success
+*          - 1 failed to read or write
+*          - 2 pHandle is NULL
+*          - 3 pHandle is not initialized
+*          - 5 journal not started
+* @note none
+*/
+uint8_t mcp794xx_basic_journal_flush(void);
+
+/**
+* @brief This function is a basic implementation to read one eeprom byte through the journal
+* @param[in] u8Addr is the eeprom address
+* @param[out] *pValue points to the value read
+* @return status code
+*          - 0 success
+*          - 1 failed to read or write
+*          - 2 pHandle is NULL
+*          - 3 pHandle is not initialized
+*          - 4 invalid address
+*          - 5 journal not started
+* @note none
+*/
+uint8_t mcp794xx_basic_journal_read(uint8_t u8Addr, uint8_t *pValue);
+
+/**
+* @brief This function is a basic implementation to mount the eeprom key-value store
+* @return status code
+*          - 0 success
+*          - 1 failed to read
+*          - 2 pHandle is NULL
+*          - 3 pHandle is not initialized
+*          - 4 invalid device variant
+*          - 6 the unprotected eeprom holds MCP794XX_KV_MAX_KEYS pages or less
+* @note none
+*/
+uint8_t mcp794xx_basic_kv_start(void);
+
+/**
+* @brief This function is a basic implementation to store a value in the eeprom key-value store
+* @param[in] u8Key is the key (0 - MCP794XX_KV_MAX_KEYS-1)
+* @param[in] u16Value is the value
+* @return status code
+*          - 0 success
+*          - 1 failed to write
+*          - 2 pHandle is NULL
+*          - 3 pHandle is not initialized
+*          - 4 invalid key
+*          - 5 store not started
+*          - 6 no free page
+* @note none
+*/
+uint8_t mcp794xx_basic_kv_put(uint8_t u8Key, uint16_t u16Value);
+
+/**
+* @brief This function is a basic implementation to read a value from the eeprom key-value store
+* @param[in] u8Key is the key (0 - MCP794XX_KV_MAX_KEYS-1)
+* @param[out] *pValue points to the value read
+* @return status code
+*          - 0 success
+*          - 2 pHandle is NULL
+*          - 3 pHandle is not initialized
+*          - 4 invalid key
+*          - 5 store not started
+*          - 6 key not found
+* @note none
+*/
+uint8_t mcp794xx_basic_kv_get(uint8_t u8Key, uint16_t *pValue);
+
+/**
+* @brief This function is a basic implementation to compact the eeprom key-value store
+* @return status code
+*          - 0 success
+*          - 1 failed to write
+*          - 2 pHandle is NULL
+*          - 3 pHandle is not initialized
+*          - 5 store not started
+* @note none
+*/
+uint8_t mcp794xx_basic_kv_compact(void);
+
 /**
  * @brief     This function is a basic implementation to read the device unique identifier
  * @param[out] pUID point to the device Unique ID
@@ -564,6 +1056,37 @@ uint8_t mcp794xx_basic_eeprom_set_bp_status(mcp794xx_eeprom_block_protect_stat_t
  */
 uint8_t mcp794xx_basic_eeprom_get_bp_status(mcp794xx_eeprom_block_protect_stat_t *pStatus);
 
+/**
+ * @brief     This function is a basic implementation to set the eeprom write cycle timeout
+ * @param[in] u16Timeout_ms is the longest time to poll for the end of a write cycle (ms)
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 timeout is 0
+ * @note      none
+ */
+uint8_t mcp794xx_basic_eeprom_set_write_timeout(uint16_t u16Timeout_ms);
+
+/**
+ * @brief This function is a basic implementation to enable the eeprom RAM mirror
+ * @return status code
+ *          - 0 success
+ *          - 2 handle null
+ *          - 3 handle is not initialized
+ * @note eeprom reads are served from RAM once each page was read
+ */
+uint8_t mcp794xx_basic_eeprom_enable_mirror(void);
+
+/**
+ * @brief This function is a basic implementation to disable the eeprom RAM mirror
+ * @return status code
+ *          - 0 success
+ *          - 2 handle null
+ *          - 3 handle is not initialized
+ */
+uint8_t mcp794xx_basic_eeprom_disable_mirror(void);
+
 /**
  * @brief     This function is a basic implementation to write n number bytes to eeprom
  * @param[in] addr is the eeprom address to write to
@@ -577,10 +1100,29 @@ uint8_t mcp794xx_basic_eeprom_get_bp_status(mcp794xx_eeprom_block_protect_stat_t
  *            - 4 invalid address
  *            - 5 attempt to write a protected block array
  *            - 6 data length is larger than page size
- * @note      the eeprom has a 5ms write cycle time.
+ *            - 7 write cycle did not complete within the timeout
+ * @note      the eeprom has a 5ms write cycle time, the function returns once it completed.
  */
 uint8_t mcp794xx_basic_eeprom_write_byte(uint8_t u8Addr, uint8_t *pBuf, size_t length);
 
+/**
+ * @brief     This function is a basic implementation to write a buffer of any length to eeprom
+ * @param[in] u8Addr is the eeprom address to start writing
+ * @param[in] *pBuf points to data buffer to be written
+ * @param[in] u16Length is the data buffer length
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 invalid address or length
+ *            - 5 attempt to write a protected block array
+ *            - 6 invalid device variant
+ *            - 7 write cycle did not complete within the timeout
+ * @note      page boundaries are handled by the driver
+ */
+uint8_t mcp794xx_basic_eeprom_write(uint8_t u8Addr, uint8_t *pBuf, uint16_t u16Length);
+
 /**
  * @brief     This function is a basic implementation to read n number of bytes to eeprom
  * @param[in] addr is the eeprom address to read
@@ -637,14 +1179,34 @@ uint8_t mcp794xx_basic_eeprom_get_byte(uint8_t u8Addr, uint32_t *pBuf, uint8_t u
  * @param[in] u8Length is the data size
  * @return status code
  *            - 0 success
- *            - 1 read failed
+ *            - 1 read or write failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
  *            - 4 invalid address (failed to validate address)
+ *            - 5 attempt to write a protected block array
+ *            - 7 write cycle did not complete within the timeout
  * @note    The value is written only if differs from the one already saved at the same address.
  */
 uint8_t mcp794xx_basic_eeprom_update(uint8_t u8Address, uint8_t *pBuffer, uint8_t u8Length);
 
+/**
+ * @brief This function is a basic implementation to update data in the EEPROM memory and report the saving
+ * @param[in] u8Address is the address to write
+ * @param[in] *pBuffer point to data write
+ * @param[in] u8Length is the data size
+ * @param[out] pCycles_saved point to the write cycles saved against one write per changed byte
+ * @return status code
+ *            - 0 success
+ *            - 1 read or write failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 invalid address (failed to validate address)
+ *            - 5 attempt to write a protected block array
+ *            - 7 write cycle did not complete within the timeout
+ * @note    one write cycle per touched page
+ */
+uint8_t mcp794xx_basic_eeprom_update_diff(uint8_t u8Address, uint8_t *pBuffer, uint8_t u8Length, uint8_t *pCycles_saved);
+
 /**
  * @brief basic example write register
  * @param[in] reg is the i2c register address
@@ -96,6 +96,35 @@ uint8_t mcp794xx_interface_i2c_write(uint8_t u8Addr, uint8_t *pBuf, uint8_t u8Le
     return 0; /**< success */
 }
 
+/**
+ * @brief      interface i2c bus write then read (repeated start)
+ * @param[in]  u8Addr is the i2c device address 7 bit
+ * @param[in]  *pWrite_buf points to the data to write (register address)
+ * @param[in]  u8Write_length is the length of the write buffer
+ * @param[out] *pRead_buf points to a data buffer
+ * @param[in]  u8Read_length is the length of the read buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       replace the body with a combined transfer (no stop between the write and the read)
+ *             when the i2c peripheral supports it
+ */
+uint8_t mcp794xx_interface_i2c_write_read(uint8_t u8Addr, uint8_t *pWrite_buf, uint8_t u8Write_length, uint8_t *pRead_buf, uint8_t u8Read_length)
+{
+    /*call your i2c write then read function here*/
+    /*user code begin */
+    if(mcp794xx_interface_i2c_write(u8Addr, pWrite_buf, u8Write_length) != 0)
+    {
+        return 1;
+    }
+    if(mcp794xx_interface_i2c_read(u8Addr, pRead_buf, u8Read_length) != 0)
+    {
+        return 1;
+    }
+    /*user code end*/
+    return 0; /**< success */
+}
+
 /**
  * @brief   interface gpio write
  * @param[in] u8State is the logic state level to be written
@@ -139,6 +168,35 @@ void mcp794xx_interface_delay_ms(uint32_t u32Ms)
     /*user code end*/
 }
 
+/**
+ * @brief  interface monotonic millisecond tick
+ * @return tick count in ms, free running and wrapping at 2^32
+ * @note   used by the host interpolated clock only, e.g. return the SysTick millisecond counter
+ */
+uint32_t mcp794xx_interface_get_tick_ms(void)
+{
+    /*call your tick function here*/
+    /*user code begin */
+
+    /*user code end*/
+    return 0;
+}
+
+/**
+ * @brief  interface MFP square wave edge counter
+ * @return number of MFP edges counted, free running and wrapping
+ * @note   used by the sub-second time stamps only, e.g. return a timer clocked by the MFP pin.
+ *         The counter must not wrap within one second; extend a 16-bit timer in software at 32.768 kHz.
+ */
+uint32_t mcp794xx_interface_get_edge_count(void)
+{
+    /*call your counter read function here*/
+    /*user code begin */
+
+    /*user code end*/
+    return 0;
+}
+
 /**
  * @brief     interface print format data
  * @param[in] fmt is the format data